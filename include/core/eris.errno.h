@@ -41,6 +41,7 @@ enum eris_errno_e {
 	EERIS_NOACCESS  = 10012,     /** No access perm    */
     EERIS_4XX       = 10013,     /** Http 4xx error    */
     EERIS_5XX       = 10014,     /** Internal error 5xx*/
+    EERIS_3XX       = 10015,     /** Http 3xx status   */
 };
 typedef enum eris_errno_e eris_errno_t;
 
@@ -264,6 +264,18 @@ struct eris_http_status_map_reason_s {
     eris_char_t        *reason_phrace;
 };
 
+/** Max of status code, and status table is indexed by it */
+#define ERIS_HTTP_STATUS_MAX     512
+
+/** Status table of preformatted status lines */
+typedef struct eris_http_status_table_s eris_http_status_table_t;
+struct eris_http_status_table_s {
+    const eris_char_t  *lines[3];    /** 1.0/1.1/0.9 line  */
+    eris_size_t         sizes[3];    /** Status line size  */
+    const eris_char_t  *status_s;    /** Status string     */
+    const eris_char_t  *reason_phrace;
+};
+
 /** Eris-http init attrs */
 typedef struct eris_http_attr_s eris_http_attr_t;
 struct eris_http_attr_s {
@@ -272,6 +284,14 @@ struct eris_http_attr_s {
     eris_size_t body_max_size;       /** Body max size     */
     eris_size_t header_cache_size;   /** Header cache size */
     eris_size_t body_cache_size;     /** Body cache size   */
+    eris_bool_t body_defer;          /** Defer body read   */
+    eris_size_t body_spool_size;     /** Spool over size   */
+    eris_string_t body_spool_path;   /** Spool temp path   */
+    const eris_char_t *server;       /** Server header     */
+    eris_bool_t gzip;                /** Gzip response     */
+    eris_int_t  gzip_level;          /** Deflate level 1-9 */
+    eris_size_t gzip_min_length;     /** Gzip min body size*/
+    eris_string_t gzip_types;        /** Gzip media types  */
 };
 
 /** Eris-http header node type */
@@ -306,6 +326,26 @@ struct eris_http_response_s {
     eris_buffer_t       body;        /** Response body data*/
 };
 
+/** Eris-http read callback type, return: ok is 0, other is EERIS_ERROR */
+typedef eris_int_t (*eris_http_cb_t)( eris_buffer_t *__buffer, eris_size_t __size, eris_arg_t __arg, eris_log_t *__log);
+
+/** Eris-http file output callback type, send file data zero-copy, return: ok is 0, other is EERIS_ERROR */
+typedef eris_int_t (*eris_http_file_cb_t)( eris_fd_t __fd, eris_off_t __offset, eris_size_t __size, eris_arg_t __arg, eris_log_t *__log);
+
+/** Max ranges of a request, more is served whole */
+#define ERIS_HTTP_RANGES_MAX   16
+
+/** Max range position before a digit is added, more is overflow */
+#define ERIS_HTTP_RANGE_POS_MAX ((((eris_size_t )-1) - 9) / 10)
+
+/** Eris-http response file range type */
+typedef struct eris_http_range_s eris_http_range_t;
+struct eris_http_range_s {
+    eris_off_t  offset;              /** First byte pos    */
+    eris_size_t size;                /** Range bytes size  */
+};
+
+
 /** Eris-http context type */
 //typedef struct eris_http_s eris_http_t;
 struct eris_http_s {
@@ -319,6 +359,35 @@ struct eris_http_s {
     eris_bool_t             chunked_end;    /** Parse ok and end */
     eris_size_t             chunk_size;     /** A chunk size     */
     eris_size_t             tmp_chunk_size; /** ................ */
+    eris_bool_t             body_pending;   /** Body is unread   */
+    eris_bool_t             body_window;    /** Window handed out*/
+    eris_size_t             body_remain;    /** Content unread   */
+    eris_size_t             body_total;     /** Body read total  */
+    eris_http_cb_t          body_incb;      /** Body input cb    */
+    eris_arg_t              body_arg;       /** Body input arg   */
+    eris_fd_t               body_fd;        /** Spool body file  */
+    eris_size_t             body_fd_size;   /** Spool body size  */
+    eris_void_t            *body_map;       /** Spool body mmap  */
+    eris_http_cb_t          resp_outcb;     /** Stream output cb */
+    eris_arg_t              resp_arg;       /** Stream output arg*/
+    eris_bool_t             resp_stream;    /** Head is sent     */
+    eris_bool_t             resp_chunked;   /** Stream is chunked*/
+    eris_bool_t             resp_finished;  /** Stream is ended  */
+    eris_size_t             resp_total;     /** Stream/file size */
+    eris_bool_t             resp_base;      /** Base headers out */
+    eris_bool_t             resp_keepalive; /** Connection state */
+    eris_string_t           resp_server;    /** Server line      */
+    eris_fd_t               resp_fd;        /** File body        */
+    eris_size_t             resp_fd_size;   /** File size        */
+    eris_bool_t             resp_meta;      /** File size only   */
+    eris_http_file_cb_t     resp_filecb;    /** File output cb   */
+    eris_int_t              resp_ranges_n;  /** 0 is whole file  */
+    eris_http_range_t       resp_ranges[ ERIS_HTTP_RANGES_MAX];
+    eris_string_t           resp_part_type; /** Parts type       */
+    eris_char_t             resp_boundary[ 24];
+    eris_bool_t             resp_gzip;      /** Body is gzipped  */
+    eris_void_t            *resp_zstream;   /** Reused deflate   */
+    eris_buffer_t           resp_zbuffer;   /** Deflate output   */
     eris_log_t             *log;            /** Log context      */
 };
 
@@ -334,10 +403,6 @@ extern const eris_http_status_map_reason_t eris_http_status_map_reason[];
 #define eris_http_status_map_reason_size (sizeof(eris_http_status_map_reason) / sizeof(eris_http_status_map_reason_t))
 
 
-/** Eris-http read callback type, return: ok is 0, other is EERIS_ERROR */
-typedef eris_int_t (*eris_http_cb_t)( eris_buffer_t *__buffer, eris_size_t __size, eris_arg_t __arg, eris_log_t *__log);
-
-
 /**
  * @Brief: Eris-http init.
  *
@@ -362,6 +427,48 @@ extern eris_int_t eris_http_init( eris_http_t *__http, eris_http_attr_t *__attrs
 extern eris_int_t eris_http_request_parse( eris_http_t *__http, eris_http_cb_t __incb, eris_arg_t __arg);
 
 
+/**
+ * @Brief: Check request body is deferred and not read over yet.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: yes is true, other is false.
+ **/
+extern eris_bool_t eris_http_request_body_pending( const eris_http_t *__http);
+
+
+/**
+ * @Brief: Read next window of deferred request body, the data is valid until next call.
+ *
+ * @Param: __http, Eris http context.
+ * @Param: __data, Output window data pointer.
+ * @Param: __size, Output window data size, end of body is 0.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR or EERIS_4XX.
+ **/
+extern eris_int_t eris_http_request_body_read( eris_http_t *__http, const eris_void_t **__data, eris_size_t *__size);
+
+
+/**
+ * @Brief: Read all rest of deferred request body into request body buffer.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR or EERIS_4XX.
+ **/
+extern eris_int_t eris_http_request_body_load( eris_http_t *__http);
+
+
+/**
+ * @Brief: Read and drop all rest of deferred request body.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR or EERIS_4XX.
+ **/
+extern eris_int_t eris_http_request_body_discard( eris_http_t *__http);
+
+
 /**
  * @Brief: The client request want to shake hands.
  *
@@ -408,6 +515,99 @@ extern eris_int_t eris_http_response_parse( eris_http_t *__http, eris_http_cb_t
 extern eris_int_t eris_http_response_pack( eris_http_t *__http, eris_http_cb_t __outcb, eris_arg_t __arg);
 
 
+/**
+ * @Brief: Set output callback of streaming response, if user is server.
+ *
+ * @Param: __http, Eris http context.
+ * @Param: __outcb,Write http-response data to output callback.
+ * @Param: __arg,  Call callback and input argument.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_http_response_set_outcb( eris_http_t *__http, eris_http_cb_t __outcb, eris_arg_t __arg);
+
+
+/**
+ * @Brief: Set output callback of file body, it is called with the argument of pack,
+ *       : and file data is read and sent by output callback if it is unset.
+ *
+ * @Param: __http,   Eris http context.
+ * @Param: __filecb, Send file data to output callback.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_http_response_set_filecb( eris_http_t *__http, eris_http_file_cb_t __filecb);
+
+
+/**
+ * @Brief: Set response body is file, the fd is owned and closed by http context.
+ *
+ * @Param: __http, Eris http context.
+ * @Param: __fd,   Opened file.
+ * @Param: __size, File size.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_http_response_set_file( eris_http_t *__http, eris_fd_t __fd, eris_size_t __size);
+
+
+/**
+ * @Brief: Set response body is metadata of file only, eg: HEAD. Content-Length
+ *       : and ranges are made of size, and nothing of body is sent.
+ *
+ * @Param: __http, Eris http context.
+ * @Param: __size, File size.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_http_response_set_file_meta( eris_http_t *__http, eris_size_t __size);
+
+
+/**
+ * @Brief: Apply request Range and If-Range to file body, the validators (ETag 
+ *       : or Last-Modified) and Content-Type of response must be set before.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Ranges applied is 0, Serve whole file is EERIS_NOTFOUND,
+ *        : Unsatisfiable is EERIS_INVALID, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_http_response_set_ranges( eris_http_t *__http);
+
+
+/**
+ * @Brief: Write response body data to client at once, the head is sent at first call,
+ *       : and body is chunked of HTTP/1.1, the headers and status can't be changed after.
+ *
+ * @Param: __http, Eris http context.
+ * @Param: __data, Body data.
+ * @Param: __size, Body data size.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_http_response_write( eris_http_t *__http, const eris_void_t *__data, eris_size_t __size);
+
+
+/**
+ * @Brief: Finish streaming response and send the last chunk.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_http_response_finish( eris_http_t *__http);
+
+
+/**
+ * @Brief: Check response is streaming and head is sent.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: yes is true, other is false.
+ **/
+extern eris_bool_t eris_http_response_streaming( const eris_http_t *__http);
+
+
 /**
  * @Brief: The client request connection is keep alive.
  *
@@ -418,6 +618,16 @@ extern eris_int_t eris_http_response_pack( eris_http_t *__http, eris_http_cb_t _
 extern eris_bool_t eris_http_request_keep_alive( eris_http_t *__http);
 
 
+/**
+ * @Brief: The client request accepts gzip content-coding.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Accept is true, other is false.
+ **/
+extern eris_bool_t eris_http_request_accept_gzip( const eris_http_t *__http);
+
+
 /**
  * @Brief: The response connection is keep alive.
  *
@@ -703,6 +913,39 @@ extern const eris_void_t *eris_http_request_get_body_data( const eris_http_t *__
 extern eris_size_t eris_http_request_get_body_size( const eris_http_t *__http);
 
 
+/**
+ * @Brief: Check http request body is spooled to temp file, if user is server.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: yes is true, other is false.
+ **/
+extern eris_bool_t eris_http_request_body_spooled( const eris_http_t *__http);
+
+
+/**
+ * @Brief: Get spooled request body file descriptor, if user is server.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Spooled is fd, Other is -1.
+ **/
+extern eris_fd_t eris_http_request_get_body_fd( const eris_http_t *__http);
+
+
+/**
+ * @Brief: Read request body data at offset, spooled or in memory, if user is server.
+ *
+ * @Param: __http,   Eris http context.
+ * @Param: __buf,    Output data buffer.
+ * @Param: __size,   Output buffer size.
+ * @Param: __offset, Offset of body.
+ *
+ * @Return: Read size, end is 0, Other is -1.
+ **/
+extern eris_ssize_t eris_http_request_body_pread( const eris_http_t *__http, eris_void_t *__buf, eris_size_t __size, eris_off_t __offset);
+
+
 /**
  * @Brief: Set response version, if user is server.
  *
@@ -714,6 +957,18 @@ extern eris_size_t eris_http_request_get_body_size( const eris_http_t *__http);
 extern eris_int_t eris_http_response_set_version( eris_http_t *__http, eris_http_version_t __version);
 
 
+/**
+ * @Brief: Set Server, Date and Connection headers, if user is server,
+ *       : they are preformatted and packed without header nodes.
+ *
+ * @Param: __http,       Eris http context.
+ * @Param: __keep_alive, Connection is keep-alive or close.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_http_response_set_base_headers( eris_http_t *__http, eris_bool_t __keep_alive);
+
+
 /**
  * @Brief: Set response status, if user is server.
  *
@@ -748,6 +1003,17 @@ extern eris_int_t eris_http_response_set_reason( eris_http_t *__http, const eris
 extern eris_int_t eris_http_response_set_header( eris_http_t *__http, const eris_char_t *__name, const eris_char_t *__value);
 
 
+/**
+ * @Brief: Delete http header of name, if user is server.
+ *
+ * @Param: __http,  Eris http context.
+ * @Param: __name,  HTTP protocol header name.
+ * 
+ * @Return: Nothing.
+ **/
+extern eris_none_t eris_http_response_del_header( eris_http_t *__http, const eris_char_t *__name);
+
+
 /**
  * @Brief: Set http response body, if user is server.
  *
@@ -835,6 +1101,7 @@ extern const eris_void_t *eris_http_response_get_body_data( const eris_http_t *_
 
 /**
  * @Brief: Get http response body size, if user is client
+ *       : or streamed body size.
  *
  * @Param: __http, Eris http context.
  * 
@@ -59,6 +59,12 @@ struct eris_log_s
 
     /** Dump into this file */
     eris_string_t    log_file;
+
+    /** Kept open of made records, it is O_APPEND */
+    eris_fd_t        fd;
+
+    /** Second of last check of file size and rename */
+    volatile eris_time_t check_sec;
 };
 
 
@@ -94,6 +100,19 @@ extern eris_int_t eris_log_init( eris_log_t *__log, const eris_char_t *__log_fil
 extern eris_void_t eris_log_exec( eris_log_t *__log, eris_log_level_t __level, const eris_char_t *__file, const eris_char_t *__func, eris_int_t __line,  const eris_char_t *__fmt, ...);
 
 
+/**
+ * @brief: Dump out a made log message, it is not formatted again, and it is
+ *       : one write to the kept open log file.
+ *
+ * @param: __log,    Log context...
+ * @Param: __level,  Dump out level log message.
+ * @Param: __record, Log message string.
+ *
+ * @return: Nothing
+ **/
+extern eris_void_t eris_log_write( eris_log_t *__log, eris_log_level_t __level, const eris_char_t *__record);
+
+
 /**
  * @Brief: Clean up log context - release object.
  *
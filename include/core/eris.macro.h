@@ -32,6 +32,10 @@ extern "C" {
                              (('a' <= (c)) && ('f' >= (c))) || \
                              (('A' <= (c)) && ('F' >= (c))) )
 
+/** Value of hex char */
+#define ERIS_CHAR_HEX_V(c)  ((('0' <= (c)) && ('9' >= (c))) ? ((c) - '0') : \
+                             (('a' <= (c)) && ('f' >= (c))) ? ((c) - 'a' + 10) : ((c) - 'A' + 10))
+
 
 
 /** End */
@@ -37,6 +37,9 @@ struct eris_module_info_s {
     eris_string_t     language;  /** Module language   */
     eris_string_t     pattern;   /** Pattern string    */
     eris_string_t     libfile;   /** Module libfile    */
+    eris_int_t        max_concurrency; /** Services running, 0 is off */
+    eris_int_t        queue_length;    /** Waiters over max_concurrency */
+    eris_int_t        queue_timeout;   /** Wait of ms, 0 is rejected */
 };
 
 #define eris_module_info_init(mfo) \
@@ -45,6 +48,9 @@ struct eris_module_info_s {
         eris_string_init( mfo.language); \
         eris_string_init( mfo.pattern);  \
         eris_string_init( mfo.libfile);  \
+        mfo.max_concurrency = 0;         \
+        mfo.queue_length    = 0;         \
+        mfo.queue_timeout   = 0;         \
     } while (0) \
 
 #define eris_module_info_cleanup(mfo) \
@@ -53,6 +59,9 @@ struct eris_module_info_s {
         eris_string_cleanup( mfo.language); \
         eris_string_cleanup( mfo.pattern);  \
         eris_string_cleanup( mfo.libfile);  \
+        mfo.max_concurrency = 0;            \
+        mfo.queue_length    = 0;            \
+        mfo.queue_timeout   = 0;            \
     } while (0) \
 
 #define eris_module_info_destroy(mfo) \
@@ -65,6 +74,9 @@ struct eris_module_info_s {
         eris_string_init( mfo.language); \
         eris_string_init( mfo.pattern);  \
         eris_string_init( mfo.libfile);  \
+        mfo.max_concurrency = 0;         \
+        mfo.queue_length    = 0;         \
+        mfo.queue_timeout   = 0;         \
     } while (0) \
 
 
@@ -76,6 +88,16 @@ struct eris_module_elem_s {
     eris_string_t     name;      /** Module name       */
     eris_string_t     pattern;   /** Pattern string    */
     eris_string_t     libfile;   /** Module libfile    */
+    eris_void_t      *resident;  /** Kept libfile      */
+    eris_atomic_int_t resident_gen; /** Kept generation */
+    eris_int_t        inflight;  /** Services running  */
+    eris_int_t        max_concurrency; /** Services limit, 0 is off */
+    eris_int_t        queue_length;    /** Waiters limit   */
+    eris_int_t        queue_timeout;   /** Wait of ms      */
+    eris_atomic_t     running;   /** Services of limit */
+    eris_atomic_t     waiting;   /** Waiters of limit  */
+    eris_mutex_t      wait_mutex;/** Waiters sleep     */
+    eris_cond_t       wait_cond; /** Leave wakes one   */
 };
 
 
@@ -87,12 +109,16 @@ struct eris_module_s {
     eris_uint32_t     used:31;   /** Update flag       */
     eris_cftree_t    *cftree;    /** Config info - get */
     eris_log_t       *log;       /** Dump log context  */
+    const eris_atomic_t *generation; /** Libfile changed, 0 or NULL is not kept */
 };
 
 
-/** Eris module service function type */
+/** Eris module service function type, the response may be streamed by eris_http_response_write/finish */
 typedef eris_int_t ( *eris_module_service_t)( const eris_module_t *__mcontext, eris_http_t *__http, eris_log_t *__log);
 
+/** Eris module body stream function type, export "<service>_body" and get request body windows before service, end is 0 size */
+typedef eris_int_t ( *eris_module_body_t)( const eris_module_t *__mcontext, eris_http_t *__http, const eris_void_t *__data, eris_size_t __size, eris_log_t *__log);
+
 
 
 /**
@@ -136,7 +162,7 @@ extern eris_int_t eris_module_update( eris_module_t *__module, const eris_module
  * @Param: __service_path_s, Execute service path string, eg: /xxx/yyy/zzz/hello_service.
  * @Param: __http,   Eris http context, it is request input and output response.
  *
- * @Return: Ok is EERIS_OK,
+ * @Return: Ok is EERIS_OK, Read request body failed is EERIS_4XX, Over max_concurrency is EERIS_FULL,
  *        : Other codes (EERIS_INVALID, EERIS_ALLOC, EERIS_NOTFOUND, EERIS_SERVICE, EERIS_UNSUPPORT).
  **/
 extern eris_int_t eris_module_exec( eris_module_t *__module, const eris_char_t *__service_path_s, eris_http_t *__http);
@@ -149,7 +175,7 @@ extern eris_int_t eris_module_exec( eris_module_t *__module, const eris_char_t *
  * @Param: __service_path_es, Execute eris service path string, eg: /xxx/yyy/zzz/hello_service.
  * @Param: __http,   Eris http context, it is request input and output response.
  *
- * @Return: Ok is EERIS_OK,
+ * @Return: Ok is EERIS_OK, Read request body failed is EERIS_4XX, Over max_concurrency is EERIS_FULL,
  *        : Other codes (EERIS_INVALID, EERIS_ALLOC, EERIS_NOTFOUND, EERIS_SERVICE, EERIS_UNSUPPORT).
  **/
 extern eris_int_t eris_module_exec_eris( eris_module_t *__module, const eris_string_t __service_path_es, eris_http_t *__http);
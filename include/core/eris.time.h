@@ -24,6 +24,12 @@ extern "C" {
 /** Get time value */
 #define eris_time_get(t) time(&(t))
 
+/** Gmt time format string size, as "Sun, 06 Nov 1994 08:49:37 GMT" */
+#define ERIS_TIME_GMT_SIZE 29
+
+/** Log time format string size, as "1994-11-06 08:49:37" */
+#define ERIS_TIME_LOG_SIZE 19
+
 
 /**
  * @Brief: Get now time to gmt format string.
@@ -46,6 +52,47 @@ extern eris_string_t eris_time_gmt( eris_string_t *__out_gmt);
 extern eris_int_t eris_time_gmt2tm( eris_tm_t *__out_tm, const eris_string_t __in_gmt);
 
 
+/**
+ * @Brief: Format specify time to gmt format string.
+ *
+ * @Param: __out_gmt, Output buffer, size must be more than ERIS_TIME_GMT_SIZE.
+ * @Param: __time,    Specify time.
+ *
+ * @Return: Ok is 0, Other is EERIS_INVALID.
+ **/
+extern eris_int_t eris_time_gmt_format( eris_char_t *__out_gmt, eris_time_t __time);
+
+
+/**
+ * @Brief: Get now time to gmt format string of cached, it is updated once per second.
+ *
+ * @Param: None.
+ *
+ * @Return: Gmt time format string, and size is ERIS_TIME_GMT_SIZE.
+ **/
+extern const eris_char_t *eris_time_gmt_cached( eris_none_t);
+
+
+/**
+ * @Brief: Get now time to log format string of cached, it is updated with gmt cached.
+ *
+ * @Param: None.
+ *
+ * @Return: Log time format string, and size is ERIS_TIME_LOG_SIZE.
+ **/
+extern const eris_char_t *eris_time_log_cached( eris_none_t);
+
+
+/**
+ * @Brief: Get monotonic time of microseconds, it is for measuring durations.
+ *
+ * @Param: None.
+ *
+ * @Return: Microseconds since an unspecified start.
+ **/
+extern eris_uint64_t eris_time_mono_us( eris_none_t);
+
+
 
 #ifdef __cplusplus
 }
@@ -65,6 +65,9 @@ extern "C" {
 /** Check sys/fileio.h */
 /* #undef ERIS_HAVE_SYS_FILEIO_H */
 
+/** Check sys/sendfile.h */
+#define ERIS_HAVE_SYS_SENDFILE_H 1
+
 /** Check poll.h */
 #define ERIS_HAVE_POLL_H        1
 
@@ -83,6 +86,15 @@ extern "C" {
 /** Check pcre.h */
 #define ERIS_HAVE_PCRE_H        1
 
+/** Check zlib.h */
+#define ERIS_HAVE_ZLIB_H        1
+
+/** Check sys/inotify.h */
+#define ERIS_HAVE_SYS_INOTIFY_H 1
+
+/** Check linux/openat2.h */
+#define ERIS_HAVE_LINUX_OPENAT2_H 1
+
 
 
 #ifdef __cplusplus 
@@ -0,0 +1,148 @@
+#ifndef __ERIS_FLIGHT_H__
+#define __ERIS_FLIGHT_H__
+
+/****************************************************************************//*
+ ** @CopyRight (C) 石正贤(Shizhengxian)
+ **
+ ** @Brief :
+ **        : Flight recorder of slave, every task thread has a circular ring of
+ **        : compact binary records in a mapped file, written with plain stores.
+ **        : The file is kept after slave crashed, and erishttpd-flight decodes it.
+ **
+ ******************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "eris.config.h"
+
+#include "os/unix/eris.unix.h"
+
+#include "core/eris.types.h"
+
+
+/** File magic and version */
+#define ERIS_FLIGHT_MAGIC        "ERISFLT1"
+#define ERIS_FLIGHT_MAGIC_SIZE   (8)
+#define ERIS_FLIGHT_VERSION      (1)
+
+/** Records of a thread ring, power of 2 */
+#define ERIS_FLIGHT_RECORDS      (256)
+
+/** Data of record, it is head of request url */
+#define ERIS_FLIGHT_DATA_SIZE    (44)
+
+
+/** Record codes */
+typedef enum {
+    ERIS_FLIGHT_START   = 0,           /** Thread ring bound     */
+    ERIS_FLIGHT_GET     ,              /** Got socket from queue */
+    ERIS_FLIGHT_PARSE   ,              /** Request parsed, rc    */
+    ERIS_FLIGHT_SERVICE ,              /** Module service begin  */
+    ERIS_FLIGHT_SERVICE_END,           /** Module service end, rc*/
+    ERIS_FLIGHT_FILE    ,              /** Static file, rc       */
+    ERIS_FLIGHT_PACK    ,              /** Response pack, status */
+    ERIS_FLIGHT_CLOSE   ,              /** Socket closed         */
+    ERIS_FLIGHT_SIGNAL  ,              /** Signal, signo         */
+    ERIS_FLIGHT_CODE_N  ,
+} eris_flight_code_t;
+
+/** Record, it is 64 bytes */
+typedef struct eris_flight_record_s eris_flight_record_t;
+struct eris_flight_record_s {
+    eris_uint64_t    stamp;            /** Realtime of usec      */
+    eris_int32_t     fd;               /** Client socket         */
+    eris_uint16_t    code;             /** Record code           */
+    eris_uint16_t    size;             /** Data size             */
+    eris_int32_t     arg;              /** rc, status or signo   */
+    eris_char_t      data[ ERIS_FLIGHT_DATA_SIZE];
+};
+
+/** Ring of a task thread, records are followed */
+typedef struct eris_flight_ring_s eris_flight_ring_t;
+struct eris_flight_ring_s {
+    eris_uint64_t    seq;              /** Records written       */
+    eris_char_t      pad[ 56];
+};
+
+/** File head, rings are followed */
+typedef struct eris_flight_head_s eris_flight_head_t;
+struct eris_flight_head_s {
+    eris_char_t      magic[ ERIS_FLIGHT_MAGIC_SIZE];
+    eris_uint32_t    version;
+    eris_uint32_t    record_size;
+    eris_uint32_t    records;          /** Records of a ring     */
+    eris_uint32_t    task_n;           /** Rings, last is main   */
+    eris_int32_t     pid;              /** Slave pid             */
+    eris_int32_t     slave;            /** Slave index           */
+    eris_uint64_t    start;            /** Realtime of usec      */
+    eris_char_t      pad[ 24];
+};
+
+/** Size of a ring with its records */
+#define ERIS_FLIGHT_RING_SIZE    (sizeof( eris_flight_ring_t) + (ERIS_FLIGHT_RECORDS * sizeof( eris_flight_record_t)))
+
+/** Ring of task in mapped file */
+#define eris_flight_ring_at(head, task) \
+    ((eris_flight_ring_t *)((eris_char_t *)(head) + sizeof( eris_flight_head_t) + (ERIS_FLIGHT_RING_SIZE * (task))))
+
+/** Records of ring */
+#define eris_flight_ring_records(ring) ((eris_flight_record_t *)((ring) + 1))
+
+
+/**
+ * @Brief: Open flight recorder file of slave, old file is renamed to ".prev".
+ *         The last ring is of slave main thread, it is bound to the caller.
+ *
+ * @Param: __path,   Flight recorder file path.
+ * @Param: __slave,  Slave index.
+ * @Param: __task_n, Task threads number.
+ * @Param: __log,    Dump log message context.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_flight_open( const eris_char_t *__path, eris_int_t __slave, eris_int_t __task_n, eris_log_t *__log);
+
+
+/**
+ * @Brief: Bind ring of task to current thread.
+ *
+ * @Param: __task, Task thread index.
+ *
+ * @Return: Nothing.
+ **/
+extern eris_none_t eris_flight_thread( eris_int_t __task);
+
+
+/**
+ * @Brief: Write a record into ring of current thread, nothing is done without ring.
+ *
+ * @Param: __code, Record code.
+ * @Param: __fd,   Client socket.
+ * @Param: __arg,  rc, status or signo.
+ * @Param: __data, Data string, NULL is none.
+ *
+ * @Return: Nothing.
+ **/
+extern eris_none_t eris_flight_record( eris_flight_code_t __code, eris_int32_t __fd, eris_int32_t __arg, const eris_char_t *__data);
+
+
+/**
+ * @Brief: Sync flight recorder file, mapping is released at exit because task threads
+ *         maybe write it yet.
+ *
+ * @Param: None.
+ *
+ * @Return: Nothing.
+ **/
+extern eris_none_t eris_flight_close( eris_none_t);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /** __ERIS_FLIGHT_H__ */
+
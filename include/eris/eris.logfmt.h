@@ -0,0 +1,135 @@
+#ifndef __ERIS_LOGFMT_H__
+#define __ERIS_LOGFMT_H__
+
+/****************************************************************************//*
+ ** @CopyRight (C) 石正贤(Shizhengxian)
+ **
+ ** @Brief :
+ **        : Access log format, it is compiled at startup into append
+ **        : operations of literals and variables, such as:
+ **        :    $remote_addr, $request, $status, $request_time, $http_<name>
+ **        : and a log record is made without printf format parsing.
+ **
+ ******************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "eris.config.h"
+
+#include "os/unix/eris.unix.h"
+
+#include "core/eris.types.h"
+#include "core/eris.http.h"
+
+
+/** Log record buffer size, longer record is truncated */
+#define ERIS_LOGFMT_RECORD_SIZE (4096)
+
+
+/** Append operations */
+typedef enum {
+    ERIS_LOGFMT_LITERAL = 0,           /** Literal string        */
+    ERIS_LOGFMT_REMOTE_ADDR   ,        /** Client ip             */
+    ERIS_LOGFMT_REMOTE_PORT   ,        /** Client port           */
+    ERIS_LOGFMT_CONNECTION    ,        /** Client socket         */
+    ERIS_LOGFMT_REQUEST       ,        /** Method, uri, protocol */
+    ERIS_LOGFMT_REQUEST_METHOD,        /** Request method        */
+    ERIS_LOGFMT_REQUEST_URI   ,        /** Request uri           */
+    ERIS_LOGFMT_PROTOCOL      ,        /** Response protocol     */
+    ERIS_LOGFMT_STATUS        ,        /** Response status       */
+    ERIS_LOGFMT_BODY_BYTES    ,        /** Response body size    */
+    ERIS_LOGFMT_RESULT        ,        /** "ok" or "failed"      */
+    ERIS_LOGFMT_REQUEST_TIME  ,        /** Stage timings         */
+    ERIS_LOGFMT_QUEUE_TIME    ,
+    ERIS_LOGFMT_PARSE_TIME    ,
+    ERIS_LOGFMT_SERVICE_TIME  ,
+    ERIS_LOGFMT_SEND_TIME     ,
+    ERIS_LOGFMT_HTTP          ,        /** Request header        */
+} eris_logfmt_code_t;
+
+/** Append operation, string is literal or header name */
+typedef struct eris_logfmt_op_s eris_logfmt_op_t;
+struct eris_logfmt_op_s {
+    eris_logfmt_code_t code;
+    eris_size_t        size;
+    eris_char_t       *str;
+};
+
+/** Compiled log format */
+typedef struct eris_logfmt_s eris_logfmt_t;
+struct eris_logfmt_s {
+    eris_int_t         ops_n;
+    eris_logfmt_op_t  *ops;
+};
+
+/** Values of a log record */
+typedef struct eris_logfmt_values_s eris_logfmt_values_t;
+struct eris_logfmt_values_s {
+    const eris_char_t *remote_addr;
+    eris_int_t         remote_port;
+    eris_sock_t        connection;
+    const eris_char_t *method;
+    const eris_char_t *uri;
+    const eris_char_t *protocol;
+    eris_int_t         status;
+    eris_size_t        body_bytes;
+    const eris_char_t *result;
+    eris_uint64_t      request_us;     /** Timings of usec       */
+    eris_uint64_t      queue_us;
+    eris_uint64_t      parse_us;
+    eris_uint64_t      service_us;
+    eris_uint64_t      send_us;
+    const eris_http_t *http;           /** Request headers       */
+};
+
+
+/** Default format, it is the access log line before log_format */
+#define ERIS_LOGFMT_DEFAULT \
+    "($remote_addr:$remote_port-$connection) - \"$request\" - \"$status $body_bytes_sent\" \"$http_user_agent\" - $result" \
+    " request_time=$request_time queue_time=$queue_time parse_time=$parse_time service_time=$service_time send_time=$send_time"
+
+
+/**
+ * @Brief: Compile log format string into append operations.
+ *
+ * @Param: __logfmt, Output compiled log format.
+ * @Param: __format, Log format string, NULL is default format.
+ * @Param: __log,    Dump log message context.
+ *
+ * @Return: Ok is 0, Unknown variable is EERIS_INVALID, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_logfmt_compile( eris_logfmt_t *__logfmt, const eris_char_t *__format, eris_log_t *__log);
+
+
+/**
+ * @Brief: Make a log record of values, it is truncated to buffer size.
+ *
+ * @Param: __logfmt, Compiled log format.
+ * @Param: __values, Values of log record.
+ * @Param: __buf,    Output record buffer, it is ended with '\0'.
+ * @Param: __size,   Output record buffer size.
+ *
+ * @Return: Record size.
+ **/
+extern eris_size_t eris_logfmt_make( const eris_logfmt_t *__logfmt, const eris_logfmt_values_t *__values, eris_char_t *__buf, eris_size_t __size);
+
+
+/**
+ * @Brief: Destroy compiled log format.
+ *
+ * @Param: __logfmt, Compiled log format.
+ *
+ * @Return: Nothing.
+ **/
+extern eris_none_t eris_logfmt_destroy( eris_logfmt_t *__logfmt);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /** __ERIS_LOGFMT_H__ */
+
@@ -0,0 +1,158 @@
+#ifndef __ERIS_RATELIMIT_H__
+#define __ERIS_RATELIMIT_H__
+
+/****************************************************************************//*
+ ** @CopyRight (C) 石正贤(Shizhengxian)
+ **
+ ** @Brief :
+ **        : Rate limit of client addresses, a fixed-size hash table of token
+ **        : buckets in shared memory, mapped by master before fork and taken
+ **        : by event threads of all slaves without locks.
+ **
+ ******************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "eris.config.h"
+
+#include "os/unix/eris.unix.h"
+#include "os/unix/eris.atomic.h"
+
+#include "core/eris.types.h"
+
+#include "eris/eris.stats.h"
+
+
+/** Slots of hash table, power of 2 */
+#define ERIS_RATELIMIT_SLOTS   (16384)
+
+/** Probes of a client address, it is admitted without free slot */
+#define ERIS_RATELIMIT_PROBES  (16)
+
+/** Idle ms of a slot without connections, it is taken by other address */
+#define ERIS_RATELIMIT_IDLE    (60000)
+
+/** Max burst of bucket, tokens are kept in thousandths of 32 bits */
+#define ERIS_RATELIMIT_BURST_MAX (1000000)
+
+
+/** Token bucket of a client address */
+typedef struct eris_ratelimit_slot_s eris_ratelimit_slot_t;
+struct eris_ratelimit_slot_s {
+    volatile eris_uint32_t addr;       /** IPv4, 0 is free       */
+    eris_atomic_t    conns;            /** Requests in handling  */
+    volatile eris_uint64_t bucket;     /** Tokens << 32 | stamp of ms, 0 is full */
+};
+
+/** Connections held by a slave of slots, master gives back them of dead slave */
+typedef struct eris_ratelimit_ledger_s eris_ratelimit_ledger_t;
+struct eris_ratelimit_ledger_s {
+    volatile eris_pid_t pid;           /** Slave pid, 0 is free  */
+    eris_atomic_t    held[ ERIS_RATELIMIT_SLOTS]; /** Conns of slots */
+};
+
+/** Shared rate limit type, ledgers are mapped after it */
+typedef struct eris_ratelimit_s eris_ratelimit_t;
+struct eris_ratelimit_s {
+    eris_uint32_t    rate;             /** Requests of second, 0 is off */
+    eris_uint32_t    burst;            /** Bucket size           */
+    eris_uint32_t    conns;            /** Requests of address, 0 is off */
+    eris_int_t       ledger_n;         /** Ledgers of slaves     */
+    eris_size_t      size;             /** Mapped size           */
+    eris_ratelimit_slot_t slots[ ERIS_RATELIMIT_SLOTS];
+};
+
+/** Ledger of index */
+#define eris_ratelimit_ledger(r, i) ((eris_ratelimit_ledger_t *)((r) + 1) + (i))
+
+
+/**
+ * @Brief: Create shared rate limit, it is done in master before slaves spawned.
+ *
+ * @Param: __rate,    Requests of second of an address, 0 is off.
+ * @Param: __burst,   Bucket size, 0 is same as rate.
+ * @Param: __conns,   Requests in handling of an address, 0 is off.
+ * @Param: __slave_n, Slaves, a running and a draining slave of each have ledgers.
+ * @Param: __log,     Dump log message context.
+ *
+ * @Return: Ok is shared rate limit, Other is NULL.
+ **/
+extern eris_ratelimit_t *eris_ratelimit_create( eris_uint32_t __rate, eris_uint32_t __burst, eris_uint32_t __conns, eris_int_t __slave_n, eris_log_t *__log);
+
+
+/**
+ * @Brief: Take a free ledger of this slave, connections of addresses held by it are
+ *         given back by master of its exit. It is done in slave after fork.
+ *
+ * @Param: __ratelimit, Shared rate limit.
+ * @Param: __pid,       Pid of this slave.
+ *
+ * @Return: Ok is 0, No free ledger is EERIS_ERROR, held connections are not tracked.
+ **/
+extern eris_int_t eris_ratelimit_ledger_take( eris_ratelimit_t *__ratelimit, eris_pid_t __pid);
+
+
+/**
+ * @Brief: Give back connections of addresses held by a dead slave, its ledger is free.
+ *         It is done in master after the slave is reaped.
+ *
+ * @Param: __ratelimit, Shared rate limit.
+ * @Param: __pid,       Pid of reaped slave.
+ *
+ * @Return: Connections given back.
+ **/
+extern eris_uint_t eris_ratelimit_reclaim( eris_ratelimit_t *__ratelimit, eris_pid_t __pid);
+
+
+/**
+ * @Brief: Get IPv4 address of client socket.
+ *
+ * @Param: __sock, Client socket.
+ *
+ * @Return: Ok is address of network order, Other is 0.
+ **/
+extern eris_uint32_t eris_ratelimit_addr( eris_sock_t __sock);
+
+
+/**
+ * @Brief: Take a token and a connection of client address, a connection is released
+ *         by eris_ratelimit_release after request.
+ *
+ * @Param: __ratelimit, Shared rate limit.
+ * @Param: __addr,      Client address.
+ *
+ * @Return: Admitted is -1, Other is limit reason of ERIS_STATS_LIMIT_*.
+ **/
+extern eris_int_t eris_ratelimit_acquire( eris_ratelimit_t *__ratelimit, eris_uint32_t __addr);
+
+
+/**
+ * @Brief: Release a connection of client address.
+ *
+ * @Param: __ratelimit, Shared rate limit.
+ * @Param: __addr,      Client address.
+ *
+ * @Return: Nothing.
+ **/
+extern eris_none_t eris_ratelimit_release( eris_ratelimit_t *__ratelimit, eris_uint32_t __addr);
+
+
+/**
+ * @Brief: Destroy shared rate limit.
+ *
+ * @Param: __ratelimit, Shared rate limit.
+ *
+ * @Return: Nothing.
+ **/
+extern eris_none_t eris_ratelimit_destroy( eris_ratelimit_t *__ratelimit);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /** __ERIS_RATELIMIT_H__ */
+
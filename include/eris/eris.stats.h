@@ -0,0 +1,198 @@
+#ifndef __ERIS_STATS_H__
+#define __ERIS_STATS_H__
+
+/****************************************************************************//*
+ ** @CopyRight (C) 石正贤(Shizhengxian)
+ **
+ ** @Brief :
+ **        : Live counters of slaves and their task threads in shared memory,
+ **        : mapped by master before fork, written by slaves without locks
+ **        : and read by the admin listener of master.
+ **
+ ******************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "eris.config.h"
+
+#include "os/unix/eris.unix.h"
+#include "os/unix/eris.atomic.h"
+
+#include "core/eris.types.h"
+
+
+/** Status classes: 1xx, 2xx, 3xx, 4xx, 5xx and others */
+#define ERIS_STATS_STATUS_N (6)
+
+/** Shed reasons of overload, new requests are answered 503 */
+typedef enum {
+    ERIS_STATS_SHED_DEPTH   = 0,       /** Queue depth threshold */
+    ERIS_STATS_SHED_LATENCY ,          /** Queue wait threshold  */
+    ERIS_STATS_SHED_FULL    ,          /** Queue is full         */
+    ERIS_STATS_SHED_N       ,
+} eris_stats_shed_id_t;
+
+/** Limit reasons of client address, requests are answered 429 */
+typedef enum {
+    ERIS_STATS_LIMIT_RATE   = 0,       /** Token bucket is empty */
+    ERIS_STATS_LIMIT_CONNS  ,          /** Connections of address*/
+    ERIS_STATS_LIMIT_N      ,
+} eris_stats_limit_id_t;
+
+/** Log-linear histogram of microseconds, 4 linear buckets of each power of 2
+ ** up to 2^26us (about 67s), and the last bucket is overflow. */
+#define ERIS_STATS_HIST_SUB_BITS  (2)
+#define ERIS_STATS_HIST_MAX_BITS  (26)
+#define ERIS_STATS_HIST_BUCKETS   (((ERIS_STATS_HIST_MAX_BITS - ERIS_STATS_HIST_SUB_BITS + 1) << ERIS_STATS_HIST_SUB_BITS) + 1)
+
+
+/** Histograms of request stages */
+typedef enum {
+    ERIS_STATS_HIST_REQUEST = 0,       /** Queued to response    */
+    ERIS_STATS_HIST_QUEUE   ,          /** Wait in event queue   */
+    ERIS_STATS_HIST_PARSE   ,          /** Request parse         */
+    ERIS_STATS_HIST_MODULE  ,          /** Module service        */
+    ERIS_STATS_HIST_SEND    ,          /** Response pack         */
+    ERIS_STATS_HIST_N       ,
+} eris_stats_hist_id_t;
+
+/** Histogram of a stage */
+typedef struct eris_stats_hist_s eris_stats_hist_t;
+struct eris_stats_hist_s {
+    eris_uint64_t    sum;              /** Sum of usec           */
+    eris_uint64_t    buckets[ ERIS_STATS_HIST_BUCKETS];
+};
+
+
+/** Counters of a task thread, written by its thread and of atomic adds,
+ ** the draining slave of reload writes the same slot with the new slave. */
+typedef struct eris_stats_thread_s eris_stats_thread_t;
+struct eris_stats_thread_s {
+    eris_uint64_t    requests;         /** Responses sent        */
+    eris_uint64_t    bytes_in;         /** Received bytes        */
+    eris_uint64_t    bytes_out;        /** Sent bytes            */
+    eris_uint64_t    module_calls;     /** Module services       */
+    eris_uint64_t    module_errors;    /** Failed services       */
+    eris_uint64_t    status[ ERIS_STATS_STATUS_N];
+    eris_stats_hist_t hists[ ERIS_STATS_HIST_N];
+    eris_atomic_t    active;           /** Connection handled    */
+};
+
+/** Counters of a slave, only written by its event thread, respawn
+ ** counters are written by supervisor thread of master. */
+typedef struct eris_stats_slave_s eris_stats_slave_t;
+struct eris_stats_slave_s {
+    eris_pid_t       pid;              /** Slave pid             */
+    eris_pid_t       ready;            /** Pid of accepting slave*/
+    eris_atomic_t    idle;             /** Connections waited    */
+    eris_atomic_t    queue_depth;      /** Event queue count     */
+    eris_atomic_t    queue_high;       /** High-water of queue   */
+    eris_atomic_t    respawns;         /** Respawned by master   */
+    eris_atomic_t    crashes;          /** Signaled or exit != 0 */
+    eris_atomic_t    backoff;          /** Respawn delay of ms   */
+    eris_int_t       last_exit;        /** Exit code, -1 is none */
+    eris_int_t       last_signal;      /** Signo, 0 is none      */
+    eris_atomic_t    shed[ ERIS_STATS_SHED_N]; /** 503 of overload */
+    eris_atomic_t    accept_pauses;    /** Listener paused       */
+    eris_atomic_t    accept_paused;    /** Paused now, 1/0       */
+    eris_atomic_t    limited[ ERIS_STATS_LIMIT_N]; /** 429 of address */
+};
+
+/** Shared stats segment type */
+typedef struct eris_stats_s eris_stats_t;
+struct eris_stats_s {
+    eris_time_t      start;            /** Master start time     */
+    eris_int_t       slave_n;          /** Slave processors      */
+    eris_int_t       task_n;           /** Threads of a slave    */
+    eris_size_t      size;             /** Mapped size           */
+};
+
+
+/**
+ * @Brief: Create shared stats segment, it is done in master before slaves spawned.
+ *
+ * @Param: __slave_n, Slave processors number.
+ * @Param: __task_n,  Task threads number of a slave.
+ * @Param: __log,     Dump log message context.
+ *
+ * @Return: Ok is shared stats, Other is NULL.
+ **/
+extern eris_stats_t *eris_stats_create( eris_int_t __slave_n, eris_int_t __task_n, eris_log_t *__log);
+
+
+/**
+ * @Brief: Get counters of a slave.
+ *
+ * @Param: __stats, Shared stats.
+ * @Param: __slave, Slave index.
+ *
+ * @Return: Ok is slave counters, Other is NULL.
+ **/
+extern eris_stats_slave_t *eris_stats_slave( eris_stats_t *__stats, eris_int_t __slave);
+
+
+/**
+ * @Brief: Get counters of a task thread of slave.
+ *
+ * @Param: __stats, Shared stats.
+ * @Param: __slave, Slave index.
+ * @Param: __task,  Task thread index.
+ *
+ * @Return: Ok is thread counters, Other is NULL.
+ **/
+extern eris_stats_thread_t *eris_stats_thread( eris_stats_t *__stats, eris_int_t __slave, eris_int_t __task);
+
+
+/**
+ * @Brief: Dump stats document of json.
+ *
+ * @Param: __stats, Shared stats.
+ * @Param: __out,   Output json document.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_stats_dump_json( eris_stats_t *__stats, eris_string_t *__out);
+
+
+/**
+ * @Brief: Record a duration into histogram of thread counters.
+ *
+ * @Param: __counters, Thread counters, NULL is ignored.
+ * @Param: __hist,     Histogram id.
+ * @Param: __usec,     Duration of microseconds.
+ *
+ * @Return: Nothing.
+ **/
+extern eris_none_t eris_stats_hist_record( eris_stats_thread_t *__counters, eris_stats_hist_id_t __hist, eris_uint64_t __usec);
+
+
+/**
+ * @Brief: Dump stats of Prometheus text format, slaves are merged.
+ *
+ * @Param: __stats, Shared stats.
+ * @Param: __out,   Output text document.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_stats_dump_prometheus( eris_stats_t *__stats, eris_string_t *__out);
+
+
+/**
+ * @Brief: Destroy shared stats segment.
+ *
+ * @Param: __stats, Shared stats.
+ *
+ * @Return: Nothing.
+ **/
+extern eris_none_t eris_stats_destroy( eris_stats_t *__stats);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /** __ERIS_STATS_H__ */
+
@@ -0,0 +1,102 @@
+#ifndef __ERIS_WATCH_H__
+#define __ERIS_WATCH_H__
+
+/****************************************************************************//*
+ ** @CopyRight (C) 石正贤(Shizhengxian)
+ **
+ ** @Brief :
+ **        : Watch files of doc_root and module libfiles in master, and
+ **        : publish change generations to slaves by shared memory.
+ **
+ ******************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "eris.config.h"
+
+#include "os/unix/eris.unix.h"
+#include "os/unix/eris.atomic.h"
+
+#include "core/eris.types.h"
+
+
+/** Path buckets of generations, power of 2 */
+#define ERIS_WATCH_BUCKETS (1024)
+
+
+/** eris watch shared generations type */
+typedef struct eris_watch_s eris_watch_t;
+struct eris_watch_s {
+    eris_atomic_t    active;           /** doc_root is watched   */
+    eris_atomic_t    all;              /** any path maybe changed*/
+    eris_atomic_t    module;           /** libfile changed, 0 is not watched */
+    eris_atomic_t    buckets[ ERIS_WATCH_BUCKETS]; /** path changed */
+};
+
+/** Generation of path bucket with path hash */
+#define eris_watch_bucket(w, h) ((w)->buckets[ (h) & (ERIS_WATCH_BUCKETS - 1)])
+
+
+/**
+ * @Brief: Create shared generations, it is done in master before slaves spawned.
+ *
+ * @Param: __log, Dump log message context.
+ *
+ * @Return: Ok is shared generations, Other is NULL.
+ **/
+extern eris_watch_t *eris_watch_create( eris_log_t *__log);
+
+
+/**
+ * @Brief: Start watcher thread of doc_root directories and module libfiles.
+ *
+ * @Param: __watch,    Shared generations.
+ * @Param: __doc_root, Static file document root path.
+ * @Param: __module,   Eris module context, libfiles are watched.
+ * @Param: __lock,     Held of executing events, NULL is none.
+ * @Param: __log,      Dump log message context.
+ *
+ * @Return: Ok is 0, Unsupported is EERIS_UNSUPPORT, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_watch_start( eris_watch_t *__watch, const eris_char_t *__doc_root, eris_module_t *__module, pthread_mutex_t *__lock, eris_log_t *__log);
+
+
+/**
+ * @Brief: Stop watcher thread.
+ *
+ * @Param: None.
+ *
+ * @Return: Nothing.
+ **/
+extern eris_none_t eris_watch_stop( eris_none_t);
+
+
+/**
+ * @Brief: Destroy shared generations.
+ *
+ * @Param: __watch, Shared generations.
+ *
+ * @Return: Nothing.
+ **/
+extern eris_none_t eris_watch_destroy( eris_watch_t *__watch);
+
+
+/**
+ * @Brief: Hash of path relative to doc_root, it is FNV-1a.
+ *
+ * @Param: __path, Path relative to doc_root.
+ *
+ * @Return: Hash value.
+ **/
+extern eris_uint32_t eris_watch_hash( const eris_char_t *__path);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /** __ERIS_WATCH_H__ */
+
@@ -29,8 +29,39 @@ extern "C" {
 #include "eris/eris.util.h"
 #include "eris/eris.signal.h"
 #include "eris/eris.slave.h"
+#include "eris/eris.watch.h"
+#include "eris/eris.stats.h"
+#include "eris/eris.logfmt.h"
+#include "eris/eris.flight.h"
+#include "eris/eris.ratelimit.h"
 
 
+/** Respawn backoff of slave crash-loop, a slave exited before stable
+ ** uptime doubles the backoff, a stable slave is respawned at once. */
+#define ERISHTTP_RESPAWN_BACKOFF_MIN   (100)        /** ms   */
+#define ERISHTTP_RESPAWN_BACKOFF_MAX   (30000)      /** ms   */
+#define ERISHTTP_RESPAWN_STABLE        (10000)      /** ms   */
+
+/** New slave of reload is ready in it, or reload is aborted */
+#define ERISHTTP_RELOAD_READY_TIMEOUT  (10000)      /** ms   */
+
+/** Listen sockets of binary upgrade, "svc_sock,admin_sock" */
+#define ERISHTTP_LISTEN_FDS_ENV        "ERISHTTP_LISTEN_FDS"
+
+/** Pidfile suffix of old master after binary upgrade */
+#define ERISHTTP_OLDBIN_SUFFIX         ".oldbin"
+
+
+/** Respawn state of a slave index, kept by supervisor thread of master */
+typedef struct erishttp_respawn_s erishttp_respawn_t;
+struct erishttp_respawn_s {
+    eris_uint64_t    start;                /** Spawned, mono usec*/
+    eris_uint64_t    due;                  /** Respawn, mono usec*/
+    eris_int_t       backoff;              /** Backoff of ms     */
+    eris_pid_t       retire;               /** Draining old slave*/
+    eris_uint64_t    retire_due;           /** Killed, mono usec */
+};
+
 /** Mime-type structure */
 typedef struct erishttp_mime_type_s erishttp_mime_type_t;
 struct erishttp_mime_type_s {
@@ -38,6 +69,14 @@ struct erishttp_mime_type_s {
 	eris_string_t types;
 };
 
+/** Mime-type hash slot, extension -> mime */
+typedef struct erishttp_mime_slot_s erishttp_mime_slot_t;
+struct erishttp_mime_slot_s {
+    const eris_char_t *ext;                /** lowercase, in types */
+    eris_size_t        ext_len;            /** extension length  */
+    const eris_char_t *mime;               /** interned mime     */
+};
+
 
 /** Erishttp attribute type */
 typedef struct erishttp_attrs_s erishttp_attrs_t;
@@ -50,8 +89,10 @@ struct erishttp_attrs_s {
     eris_uint32_t    tcp_nodelay:1;        /** default: 0        */
     eris_uint32_t    tcp_nopush:1;         /** default: 0        */
     eris_uint32_t    log_level:8;          /** default: 2        */
+    eris_uint32_t    gzip:1;               /** default: 0        */
+    eris_uint32_t    gzip_static:1;        /** default: 0        */
     eris_uint32_t    cpuset_enable;        /** 1/0 enable/disable*/
-    eris_uint32_t    zero:20;              /** zero nothing      */
+    eris_uint32_t    zero:18;              /** zero nothing      */
 
     eris_int_t       worker_n;             /** default: 1        */
     eris_int_t       worker_task_n;        /** default: 8        */
@@ -76,10 +117,28 @@ struct erishttp_attrs_s {
     eris_size_t      url_max_size;         /** default: 1k       */
     eris_size_t      header_max_size;      /** default: 4k       */
     eris_size_t      body_max_size;        /** default: 10m      */
+    eris_size_t      body_spool_size;      /** default: 1m       */
+    eris_string_t    body_spool_path;      /** $prefix/var/tmp   */
 
     eris_size_t      log_max_size;         /** default: 64m      */
     eris_string_t    log_path;             /** $prefix/var/log   */
     eris_string_t    doc_root;             /** $prefix/var/www/htdoc */
+
+    eris_int_t       gzip_level;           /** default: 1        */
+    eris_size_t      gzip_min_length;      /** default: 1k       */
+    eris_string_t    gzip_types;           /** default: text/html*/
+
+    eris_int_t       static_miss_ttl;      /** default: 2s       */
+    eris_int_t       slow_request_time;    /** default: 1000ms   */
+    eris_string_t    log_format;           /** access log format */
+    eris_int_t       flight_recorder;      /** default: on       */
+    eris_int_t       drain_timeout;        /** default: 30s      */
+    eris_int_t       shed_queue_depth;     /** default: 0, off   */
+    eris_int_t       shed_queue_time;      /** default: 0ms, off */
+    eris_int_t       shed_retry_after;     /** default: 1s       */
+    eris_int_t       rate_limit;           /** default: 0/s, off */
+    eris_int_t       rate_limit_burst;     /** default: rate_limit */
+    eris_int_t       rate_limit_conns;     /** default: 0, off   */
 };
 
 
@@ -95,20 +154,44 @@ struct erishttp_s {
 
     eris_sock_t         svc_sock;          /** server socket     */
     eris_sock_t         admin_sock;        /** admin socket      */
+    eris_fd_t           doc_root_fd;       /** doc_root directory*/
+    eris_watch_t       *watch;             /** Shared generations*/
+    eris_stats_t       *stats;             /** Shared counters   */
+    eris_ratelimit_t   *ratelimit;         /** Shared rate limit */
+    eris_int_t          slave_index;       /** Slave index, -1 is master */
 
     eris_pid_t         *slave_pids;        /** workers pids      */
+    erishttp_respawn_t *respawns;          /** Respawn of slaves */
+    pthread_t           supervise_tid;     /** Supervisor thread */
+    volatile eris_int_t supervise_stop;    /** Stop supervisor   */
+    eris_bool_t         supervising;       /** Supervisor running*/
+    pthread_mutex_t     fork_lock;         /** Master threads of fork */
+    volatile eris_int_t reload;            /** SIGHUP of master  */
+    volatile eris_int_t upgrade;           /** SIGUSR2 of master */
+    volatile eris_int_t quit;              /** Slave draining    */
+    eris_bool_t         draining;          /** Accepts stopped   */
+    eris_int_t          generation;        /** Config reloaded   */
+    eris_pid_t          upgrade_pid;       /** New binary master */
+    eris_atomic_t       busy;              /** Sockets of tasks  */
+    eris_string_t       exe;               /** Binary pathname   */
     eris_http_t        *tasks_http;        /** Tasks http context*/
     eris_task_t         tasks;             /** worker tasks      */
     eris_event_t        svc_event;         /** server event      */
     eris_event_t        admin_event;       /** server event      */
     eris_event_queue_t  svc_event_queue;   /** event queue       */
+    eris_string_t       shed_response;     /** Preformatted 503  */
+    eris_string_t       limit_response;    /** Preformatted 429  */
 
     eris_log_t          access_log;        /** access log ctx    */
     eris_log_t          errors_log;        /** errors log ctx    */
     eris_log_t          module_log;        /** mudule log ctx    */
+    eris_log_t          slow_log;          /** slow request log  */
+    eris_logfmt_t       access_logfmt;     /** access log format */
 
     erishttp_attrs_t    attrs;             /** erishttp info     */
 	eris_list_t         mime_types;        /** mime-types list   */
+    erishttp_mime_slot_t *mime_slots;      /** mime hash table   */
+    eris_size_t         mime_slots_size;   /** power of 2        */
 };
 
 
@@ -118,6 +201,9 @@ extern erishttp_t *const p_erishttp_context;
 /** Destroy by master init objects. */
 extern eris_none_t erishttp_destroy( eris_bool_t __slave);
 
+/** Find Content-Type of file extension, not found is NULL. */
+extern const eris_char_t *erishttp_mime_type_find( const eris_char_t *__ext, eris_size_t __ext_len);
+
 
 
 #ifdef __cplusplus
@@ -86,6 +86,31 @@ extern eris_int_t eris_event_modify( eris_event_t *__event, eris_event_elem_t *_
 extern eris_int_t eris_event_delete( eris_event_t *__event, eris_event_elem_t *__elem);
 
 
+/**
+ * @Brief: Delete listen socket from accept nodes of event context monitor,
+ *         it is not closed and can be added again of ERIS_EVENT_ACCEPT.
+ *
+ * @Param: __event, Event context.
+ * @Param: __sock,  Listen socket.
+ *
+ * @Return: Os is 0, Not found is EERIS_NOTFOUND, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_event_accept_delete( eris_event_t *__event, eris_sock_t __sock);
+
+
+/**
+ * @Brief: Pause or resume accepts of a reason, listen sockets are out of I/O monitor
+ *         while any reason is paused, and they are kept in accept nodes.
+ *
+ * @Param: __event,  Event context.
+ * @Param: __reason, ERIS_EVENT_PAUSE_NODES or ERIS_EVENT_PAUSE_USER.
+ * @Param: __pause,  Pause is true, resume is false.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+extern eris_int_t eris_event_accept_pause( eris_event_t *__event, eris_int_t __reason, eris_bool_t __pause);
+
+
 /**
  * @Brief: Monitor all sockets and dispatch.
  *
@@ -92,6 +92,9 @@ struct eris_poll_s {
     eris_int32_t   size;           /** fds pool size */
     eris_int32_t   current;        /** current fds   */
     eris_pollfd_t *fds;            /** Pointer fds   */
+    eris_bool_t   *accepts;        /** fds[i] is accept socket */
+    eris_int32_t   index_size;     /** index table size */
+    eris_int32_t  *index;          /** sock -> fds position, -1 is none */
 #endif
 };
 
@@ -121,6 +124,20 @@ enum {
 };
 
 
+/** Accept paused reasons, listen sockets are out of monitor of any reason */
+enum {
+    ERIS_EVENT_PAUSE_NONE  = 0x0,       /** Accepting   */
+    ERIS_EVENT_PAUSE_NODES = 0x1 <<  0, /** Max events  */
+    ERIS_EVENT_PAUSE_USER  = 0x1 <<  1, /** By caller   */
+};
+
+/** Paused of max events is resumed below it, hysteresis of 3/4 */
+#define eris_event_resume_nodes(event) (((event)->max_events / 4) * 3)
+
+/** Wait seconds of monitor, paused accepts are checked every second */
+#define eris_event_wait_timeout(event) ((event)->accept_paused ? 1 : (event)->timeout)
+
+
 /** Event init-attrs */
 struct eris_event_attr_s {
     eris_event_iot_t iot;          /** I/O type     */
@@ -138,8 +155,10 @@ struct eris_event_attr_s {
 
 /** Event element */
 struct eris_event_elem_s {
-    eris_sock_t  sock;           /** Socket fd      */
-    eris_int32_t events;         /** Speicfy events */
+    eris_sock_t   sock;          /** Socket fd      */
+    eris_int32_t  events;        /** Speicfy events */
+    eris_uint32_t addr;          /** Client IPv4 of rate limit, 0 is none */
+    eris_uint64_t stamp;         /** Queued, usec   */
 };
 
 
@@ -208,6 +227,8 @@ struct eris_event_s {
     eris_event_destroy_t  destroy_handler;    /** destroy  */
 
     eris_event_node_t    *accept_nodes;   /** accept event */
+    eris_int_t            accept_paused;  /** Paused reasons */
+    eris_atomic_t         accept_pauses;  /** Paused count */
 
     /** Element table */
     eris_int_t            nodes_size;     /** Table size   */
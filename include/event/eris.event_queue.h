@@ -71,6 +71,16 @@ extern eris_bool_t eris_event_queue_isfull( eris_event_queue_t *__event_queue);
 extern eris_bool_t eris_event_queue_isempty( eris_event_queue_t *__event_queue);
 
 
+/**
+ * @Brief: Get wait time of front element, it is the latency of queue.
+ *
+ * @Param: __event_queue, Eris event queue context.
+ *
+ * @Return: Wait usec of front element, empty is 0.
+ **/
+extern eris_uint64_t eris_event_queue_wait( eris_event_queue_t *__event_queue);
+
+
 /**
  * @Brief: Put event element into queue.
  *
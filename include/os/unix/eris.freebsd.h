@@ -60,6 +60,7 @@ extern "C" {
 #include <sys/uio.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
+#include <sys/wait.h>           /** waitpid */
 #include <sys/ioctl.h>          /** FIONBIO */
 #include <sys/resource.h>
 #include <sys/mount.h>          /** statfs  */
@@ -83,6 +84,10 @@ typedef struct aiocb  eris_aiocb_t;
 #include <pcre.h>
 #endif
 
+#if (ERIS_HAVE_ZLIB_H)
+#include <zlib.h>             /** deflate */
+#endif
+
 /** socket */
 #include <sys/socket.h>         /** socket      */
 #include <netinet/in.h>         /** sockaddr_in, htons */
@@ -61,6 +61,7 @@ extern "C" {
 #include <sys/uio.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
+#include <sys/wait.h>           /** waitpid */
 #include <sys/ioctl.h>          /** FIONBIO */
 #include <sys/resource.h>
 #include <sys/select.h>         /** select  */
@@ -76,6 +77,10 @@ extern "C" {
 #include <sys/fileio.h>
 #endif
 
+#if (ERIS_HAVE_SYS_SENDFILE_H)  /** sendfile */
+#include <sys/sendfile.h>
+#endif
+
 #if (ERIS_HAVE_POLL_H)
 #include <poll.h>               /** poll */
 #endif
@@ -94,6 +99,10 @@ typedef struct aiocb  eris_aiocb_t;
 #include <pcre.h>
 #endif
 
+#if (ERIS_HAVE_ZLIB_H)
+#include <zlib.h>             /** deflate */
+#endif
+
 /** socket */
 #include <sys/socket.h>         /** socket      */
 #include <netinet/in.h>         /** sockaddr_in, htons */
@@ -189,6 +189,19 @@ extern eris_int_t eris_socket_ready_r( eris_sock_t __sock, eris_int_t __timeout)
 extern eris_int_t eris_socket_ready_w( eris_sock_t __sock, eris_int_t __timeout);
 
 
+/**
+ * @Brief: Send file data to socket, zero-copy if system has sendfile.
+ *
+ * @Param: __sock,   Socket context.
+ * @Param: __fd,     File descriptor.
+ * @Param: __offset, File offset, it is moved forward of sent size.
+ * @Param: __size,   Max size of sending.
+ *
+ * @Return: Sent size, other is -1 and errno is set.
+ **/
+extern eris_ssize_t eris_socket_sendfile( eris_sock_t __sock, eris_fd_t __fd, eris_off_t *__offset, eris_size_t __size);
+
+
 /**
  * @Brief: Close socket context.
  *
@@ -94,6 +94,10 @@ eris_string_t eris_errno_string( eris_string_t *__content, eris_errno_t __errno)
                 {
                     rc = eris_string_set( __content, "Server internal error 5xx");
                 }
+            case EERIS_3XX:
+                {
+                    rc = eris_string_set( __content, "Http response 3xx status");
+                }
             default : 
                 {
                     const eris_char_t *p = strerror( __errno);
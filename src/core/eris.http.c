@@ -15,6 +15,8 @@
 
 #include "core/eris.core.h"
 
+#include "os/unix/eris.files.h"
+
 
 /** Command map to string */
 const eris_char_t *eris_http_command_arrs[] = {
@@ -31,6 +33,78 @@ const eris_http_status_map_reason_t eris_http_status_map_reason[] = {
 #undef SX
 };
 
+/** Status line as "HTTP/1.1 200 Ok\r\n", and table is indexed of status code */
+#define ERIS_HTTP_STATUS_LINE(v, name, s) v " " #name " " #s ERIS_HTTP_CRLF
+
+static const eris_http_status_table_t eris_http_status_table[ ERIS_HTTP_STATUS_MAX] = {
+#define SX(n, name, s) [n] = {                                           \
+        { ERIS_HTTP_STATUS_LINE( ERIS_HTTP_V10_S, name, s),              \
+          ERIS_HTTP_STATUS_LINE( ERIS_HTTP_V11_S, name, s),              \
+          ERIS_HTTP_STATUS_LINE( ERIS_HTTP_V09_S, name, s) },            \
+        { sizeof( ERIS_HTTP_STATUS_LINE( ERIS_HTTP_V10_S, name, s)) - 1, \
+          sizeof( ERIS_HTTP_STATUS_LINE( ERIS_HTTP_V11_S, name, s)) - 1, \
+          sizeof( ERIS_HTTP_STATUS_LINE( ERIS_HTTP_V09_S, name, s)) - 1 },\
+        #name,                                                           \
+        #s },
+    ERIS_HTTP_STATUS(SX)
+#undef SX
+};
+
+/** Status table is valid of status code */
+#define eris_http_status_in_table(s) ((0 <= (s)) && ((s) < ERIS_HTTP_STATUS_MAX) && eris_http_status_table[ (s)].status_s)
+
+
+/** Preformatted base headers */
+#define ERIS_HTTP_DATE_S            "Date: "
+#define ERIS_HTTP_DATE_SIZE         (sizeof( ERIS_HTTP_DATE_S) - 1)
+#define ERIS_HTTP_CONN_CLOSE_S      "Connection: close"ERIS_HTTP_CRLF
+#define ERIS_HTTP_CONN_CLOSE_SIZE   (sizeof( ERIS_HTTP_CONN_CLOSE_S) - 1)
+#define ERIS_HTTP_CONN_KEEPALIVE_S  "Connection: keep-alive"ERIS_HTTP_CRLF
+#define ERIS_HTTP_CONN_KEEPALIVE_SIZE (sizeof( ERIS_HTTP_CONN_KEEPALIVE_S) - 1)
+
+
+/** Write request body data to spool temp file, create it at first. */
+static eris_int_t eris_http_body_spool( eris_http_t *__http, const eris_void_t *__data, eris_size_t __size);
+
+/** Release spool temp file and mapping of request body. */
+static eris_none_t eris_http_body_unspool( eris_http_t *__http);
+
+/** Make http-response status line and headers into header buffer. */
+static eris_int_t eris_http_response_pack_head( eris_http_t *__http);
+
+/** Send head of streaming response, and body set before is the first data. */
+static eris_int_t eris_http_response_stream_begin( eris_http_t *__http);
+
+/** Send a data of streaming response, it is gzipped when response is. */
+static eris_int_t eris_http_response_stream_out( eris_http_t *__http, const eris_void_t *__data, eris_size_t __size);
+
+/** Send a raw data of streaming response, it is a chunk of HTTP/1.1. */
+static eris_int_t eris_http_response_stream_send( eris_http_t *__http, const eris_void_t *__data, eris_size_t __size);
+
+/** Close file body and forget ranges. */
+static eris_none_t eris_http_response_file_close( eris_http_t *__http);
+
+/** Make head of a part in multipart/byteranges. */
+static eris_int_t eris_http_response_part_head( const eris_http_t *__http, eris_int_t __i, eris_char_t *__buf, eris_size_t __size);
+
+/** Send file data of range by file callback, or read and output it. */
+static eris_int_t eris_http_response_file_send( eris_http_t *__http, eris_http_cb_t __outcb, eris_arg_t __arg, eris_off_t __offset, eris_size_t __size);
+
+/** Send file body, whole or all ranges. */
+static eris_int_t eris_http_response_file_out( eris_http_t *__http, eris_http_cb_t __outcb, eris_arg_t __arg);
+
+/** Client accepts gzip content-coding in Accept-Encoding value. */
+static eris_bool_t eris_http_accept_gzip( const eris_char_t *__accept);
+
+/** Check response can be gzipped for client, mark Vary and reset deflate stream. */
+static eris_bool_t eris_http_response_gzip_begin( eris_http_t *__http);
+
+/** Deflate data into gzip output buffer, sync flush or finish. */
+static eris_int_t eris_http_response_gzip_deflate( eris_http_t *__http, const eris_void_t *__data, eris_size_t __size, eris_bool_t __finish);
+
+/** Add a hex char of chunk size, overflow or too large request body is EERIS_DATA. */
+static eris_int_t eris_http_chunk_size_add( eris_http_t *__http, eris_http_type_t __type, eris_char_t __c);
+
 
 /*
  * @Brief: Eris-http init.
@@ -50,6 +124,36 @@ eris_int_t eris_http_init( eris_http_t *__http, eris_http_attr_t *__attrs, eris_
         __http->chunked_end    = false;
         __http->chunk_size     = 0;
         __http->tmp_chunk_size = 0;
+        __http->body_pending   = false;
+        __http->body_window    = false;
+        __http->body_remain    = 0;
+        __http->body_total     = 0;
+        __http->body_incb      = NULL;
+        __http->body_arg       = NULL;
+        __http->body_fd        = -1;
+        __http->body_fd_size   = 0;
+        __http->body_map       = NULL;
+        __http->resp_outcb     = NULL;
+        __http->resp_arg       = NULL;
+        __http->resp_stream    = false;
+        __http->resp_chunked   = false;
+        __http->resp_finished  = false;
+        __http->resp_total     = 0;
+        __http->resp_base      = false;
+        __http->resp_keepalive = false;
+        __http->resp_server    = NULL;
+        __http->resp_fd        = -1;
+        __http->resp_fd_size   = 0;
+        __http->resp_meta      = false;
+        __http->resp_filecb    = NULL;
+        __http->resp_ranges_n  = 0;
+        __http->resp_part_type = NULL;
+        __http->resp_boundary[ 0] = '\0';
+        __http->resp_gzip      = false;
+        __http->resp_zstream   = NULL;
+
+        /** Deflate output is alloced at the first gzip */
+        (eris_none_t )eris_buffer_init( &(__http->resp_zbuffer), 0, __log);
 
         /** Init all attrs */
         if ( __attrs) {
@@ -58,6 +162,14 @@ eris_int_t eris_http_init( eris_http_t *__http, eris_http_attr_t *__attrs, eris_
             __http->attrs.body_max_size     = __attrs->body_max_size     ? __attrs->body_max_size     : 10485760;
             __http->attrs.header_cache_size = __attrs->header_cache_size ? __attrs->header_cache_size : 4096;
             __http->attrs.body_cache_size   = __attrs->body_cache_size   ? __attrs->body_cache_size   : 16384;
+            __http->attrs.body_defer        = __attrs->body_defer;
+            __http->attrs.body_spool_size   = __attrs->body_spool_size;
+            __http->attrs.body_spool_path   = __attrs->body_spool_path;
+            __http->attrs.server            = __attrs->server;
+            __http->attrs.gzip              = __attrs->gzip;
+            __http->attrs.gzip_level        = __attrs->gzip_level        ? __attrs->gzip_level        : 1;
+            __http->attrs.gzip_min_length   = __attrs->gzip_min_length;
+            __http->attrs.gzip_types        = __attrs->gzip_types;
         } else {
             /** Default */
             __http->attrs.url_max_size      = 1024;       /** 1KB  */
@@ -65,6 +177,14 @@ eris_int_t eris_http_init( eris_http_t *__http, eris_http_attr_t *__attrs, eris_
             __http->attrs.body_max_size     = 10485760;   /** 10MB */
             __http->attrs.header_cache_size = 4096;       /** 4KB  */
             __http->attrs.body_cache_size   = 16384;      /** 16KB */
+            __http->attrs.body_defer        = false;
+            __http->attrs.body_spool_size   = 0;          /** Off  */
+            __http->attrs.body_spool_path   = NULL;
+            __http->attrs.server            = NULL;
+            __http->attrs.gzip              = false;      /** Off  */
+            __http->attrs.gzip_level        = 1;
+            __http->attrs.gzip_min_length   = 0;
+            __http->attrs.gzip_types        = NULL;
         }
 
         /** Init request handler */
@@ -135,6 +255,18 @@ eris_int_t eris_http_init( eris_http_t *__http, eris_http_attr_t *__attrs, eris_
             }
         }
 
+        /** Server header line is made one time */
+        if ( (0 == rc) && __http->attrs.server) {
+            rc = eris_string_printf( &(__http->resp_server), "Server: %s"ERIS_HTTP_CRLF, __http->attrs.server);
+            if ( 0 != rc) {
+                rc = EERIS_ERROR;
+
+                if ( __log) {
+                    eris_log_dump( __log, ERIS_LOG_CORE, "Make server header failed, errno.<%d>", errno);
+                }
+            }
+        }
+
         /** Specify log context */
         __http->log = __log;
     } else { rc = EERIS_ERROR; }
@@ -168,6 +300,10 @@ eris_int_t eris_http_request_parse( eris_http_t *__http, eris_http_cb_t __incb,
         __http->chunked_end    = false;
         __http->chunk_size     = 0;
         __http->tmp_chunk_size = 0;
+        __http->body_pending   = false;
+        __http->body_window    = false;
+        __http->body_remain    = 0;
+        __http->body_total     = 0;
 
         if ( __incb) {
             eris_bool_t header_finish_flag = false;
@@ -1282,125 +1418,73 @@ eris_int_t eris_http_request_parse( eris_http_t *__http, eris_http_cb_t __incb,
                         }
                     } else {
                         if ( __http->chunked ) {
-                            do {
-                                if ( 0 == __http->bbuffer.size) {
-                                    eris_size_t get_data_size = __http->bbuffer.alloc;
-
-                                    /** Call back get chunked data */
-                                    rc = __incb( &(__http->bbuffer), get_data_size, __arg, __http->log);
-                                }
-
-                                rc = eris_http_chunk_parse( __http, ERIS_HTTP_REQUEST, &(__http->bbuffer));
-                                if ( __http->chunked_end) {
-
-                                    break;
-                                }
-
-                                if ( 0 != rc) { 
-                                    __http->response.status  = ERIS_HTTP_408;
-                                    __http->response.version = ERIS_HTTP_V10;
-                                    eris_string_set( &(__http->response.reason), eris_http_status_desc( 408));
-
-                                    break; 
-                                }
-
-                                /** Clean up body buffer */
-                                eris_buffer_cleanup( &(__http->bbuffer), NULL);
-
-                            } while ( 1);
+                            /** Body read with chunk decoder */
+                            __http->body_pending = true;
+                            __http->body_remain  = 0;
 
                         } else {
-                            /** Copy body content */
-                            rc = eris_buffer_copy( &(__http->request.body), &(__http->bbuffer), __http->log);
-                            if ( 0 == rc) {
-                                /** Get content-length */
-                                const eris_string_t content_length_s = eris_http_request_get_header( __http, "Content-Length");
-                                if ( content_length_s) {
-                                    eris_int64_t content_length_v = (eris_size_t )eris_string_atol( content_length_s);
-                                    if ( content_length_v <= __http->attrs.body_max_size) {
-                                        if ( 0 <= content_length_v) {
-                                            /** Body buffer size is not equal Content-Length */
-                                            while ( __http->request.body.size < (eris_size_t ) content_length_v) {
-                                                eris_buffer_cleanup( &(__http->bbuffer), __http->log);
-
-                                                eris_size_t get_data_size = ((eris_size_t )content_length_v - __http->request.body.size);
-                                                if ( get_data_size > __http->bbuffer.alloc ) {
-                                                    get_data_size = __http->bbuffer.alloc;
-                                                }
-
-                                                /** Get body content data */
-                                                rc = __incb( &(__http->bbuffer), get_data_size, __arg, __http->log);
-                                                if ( 0 == rc) {
-                                                    /** Append request body data */
-                                                    rc = eris_buffer_append_es( &(__http->request.body), &(__http->bbuffer), __http->log);
-                                                    if ( 0 != rc) {
-                                                        rc = EERIS_ERROR;
-
-                                                        __http->response.status  = ERIS_HTTP_500;
-                                                        __http->response.version = ERIS_HTTP_V10;
-                                                        eris_string_set( &(__http->response.reason), eris_http_status_desc( 500));
-
-                                                        break;
-                                                    }
-                                                } else {
-                                                    rc = EERIS_4XX;
-
-                                                    /** Heppen error */
-                                                    __http->response.status  = ERIS_HTTP_408;
-                                                    __http->response.version = ERIS_HTTP_V10;
-                                                    eris_string_set( &(__http->response.reason), eris_http_status_desc( 408));
-
-                                                    break;
-                                                }/// else callback error.
-                                            }/// while ( __http->request.body.size < content_length_v)
-                                        } else {
-                                            /** Bad content_length */
-                                            rc = EERIS_4XX;
-
-                                            __http->response.status  = ERIS_HTTP_400;
-                                            __http->response.version = ERIS_HTTP_V10;
-                                            eris_string_set( &(__http->response.reason), eris_http_status_desc( 400));
+                            /** Get content-length */
+                            const eris_string_t content_length_s = eris_http_request_get_header( __http, "Content-Length");
+                            if ( content_length_s) {
+                                eris_int64_t content_length_v = (eris_size_t )eris_string_atol( content_length_s);
+                                if ( content_length_v <= __http->attrs.body_max_size) {
+                                    if ( 0 <= content_length_v) {
+                                        /** Drop pipeline data of next request */
+                                        if ( __http->bbuffer.size > (eris_size_t )content_length_v) {
+                                            __http->bbuffer.size = (eris_size_t )content_length_v;
+                                        }
 
-                                            if ( __http->log) {
-                                                eris_log_dump( __http->log, ERIS_LOG_CORE, "Bad request Content-Length");
-                                            }
+                                        if ( 0 < content_length_v) {
+                                            __http->body_pending = true;
+                                            __http->body_remain  = (eris_size_t )content_length_v - __http->bbuffer.size;
                                         }
                                     } else {
-                                        /** Request entity too large */
+                                        /** Bad content_length */
                                         rc = EERIS_4XX;
 
-                                        __http->response.status  = ERIS_HTTP_413;
+                                        __http->response.status  = ERIS_HTTP_400;
                                         __http->response.version = ERIS_HTTP_V10;
-                                        eris_string_set( &(__http->response.reason), eris_http_status_desc( 413));
+                                        eris_string_set( &(__http->response.reason), eris_http_status_desc( 400));
 
                                         if ( __http->log) {
-                                            eris_log_dump( __http->log, ERIS_LOG_CORE, "Request content data too large");
+                                            eris_log_dump( __http->log, ERIS_LOG_CORE, "Bad request Content-Length");
                                         }
                                     }
                                 } else {
-                                    /** Not found Content-Length */
+                                    /** Request entity too large */
                                     rc = EERIS_4XX;
 
-                                    __http->response.status  = ERIS_HTTP_411;
+                                    __http->response.status  = ERIS_HTTP_413;
                                     __http->response.version = ERIS_HTTP_V10;
-                                    eris_string_set( &(__http->response.reason), eris_http_status_desc( 411));
+                                    eris_string_set( &(__http->response.reason), eris_http_status_desc( 413));
 
                                     if ( __http->log) {
-                                        eris_log_dump( __http->log, ERIS_LOG_CORE, "Unspecify Content-Length header");
+                                        eris_log_dump( __http->log, ERIS_LOG_CORE, "Request content data too large");
                                     }
                                 }
                             } else {
-                                rc = EERIS_ERROR;
+                                /** Not found Content-Length */
+                                rc = EERIS_4XX;
 
-                                __http->response.status  = ERIS_HTTP_500;
+                                __http->response.status  = ERIS_HTTP_411;
                                 __http->response.version = ERIS_HTTP_V10;
-                                eris_string_set( &(__http->response.reason), eris_http_status_desc( 500));
+                                eris_string_set( &(__http->response.reason), eris_http_status_desc( 411));
 
                                 if ( __http->log) {
-                                    eris_log_dump( __http->log, ERIS_LOG_CORE, "Copy buffer failed, errno.<%d>", errno);
+                                    eris_log_dump( __http->log, ERIS_LOG_CORE, "Unspecify Content-Length header");
                                 }
                             }
                         }/// else is not chunked data
+
+                        if ( __http->body_pending) {
+                            __http->body_incb = __incb;
+                            __http->body_arg  = __arg;
+
+                            /** Not defer and read all body content now */
+                            if ( (0 == rc) && !__http->attrs.body_defer) {
+                                rc = eris_http_request_body_load( __http);
+                            }
+                        }
                     }/// else not 100-continue
                 }/// fi command is PUT or POST or PATCH
             }/// fi ( (0 == rc) && header_finish_flag )
@@ -1418,7 +1502,11 @@ eris_int_t eris_http_request_parse( eris_http_t *__http, eris_http_cb_t __incb,
         }
 
         eris_buffer_cleanup( &(__http->hbuffer), NULL);
-        eris_buffer_cleanup( &(__http->bbuffer), NULL);
+
+        /** Deferred body keep first window in body buffer */
+        if ( !__http->body_pending) {
+            eris_buffer_cleanup( &(__http->bbuffer), NULL);
+        }
     } else { rc = EERIS_ERROR; }
 
     errno = tmp_errno;
@@ -1427,6 +1515,294 @@ eris_int_t eris_http_request_parse( eris_http_t *__http, eris_http_cb_t __incb,
 }/// eris_http_request_parse
 
 
+/**
+ * @Brief: Check request body is deferred and not read over yet.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: yes is true, other is false.
+ **/
+eris_bool_t eris_http_request_body_pending( const eris_http_t *__http)
+{
+    if ( __http) {
+        return __http->body_pending;
+    }
+
+    return false;
+}/// eris_http_request_body_pending
+
+
+/**
+ * @Brief: Read next window of deferred request body, the data is valid until next call.
+ *
+ * @Param: __http, Eris http context.
+ * @Param: __data, Output window data pointer.
+ * @Param: __size, Output window data size, end of body is 0.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR or EERIS_4XX.
+ **/
+eris_int_t eris_http_request_body_read( eris_http_t *__http, const eris_void_t **__data, eris_size_t *__size)
+{
+    eris_int_t tmp_errno = errno;
+    eris_int_t rc = 0;
+
+    if ( __http && __data && __size) {
+        *__data = NULL;
+        *__size = 0;
+
+        /** Release window of last read */
+        if ( __http->body_window) {
+            __http->body_window = false;
+
+            if ( __http->chunked) {
+                eris_buffer_cleanup( &(__http->request.body), NULL);
+
+            } else { eris_buffer_cleanup( &(__http->bbuffer), NULL); }
+        }
+
+        if ( __http->body_pending) {
+            if ( __http->chunked) {
+                /** Decode chunks into request body, it is the window */
+                do {
+                    if ( 0 == __http->bbuffer.size) {
+                        rc = __http->body_incb( &(__http->bbuffer), __http->bbuffer.alloc, __http->body_arg, __http->log);
+                        if ( (0 != rc) || (0 == __http->bbuffer.size)) {
+                            rc = EERIS_4XX;
+
+                            __http->response.status  = ERIS_HTTP_408;
+                            __http->response.version = ERIS_HTTP_V10;
+                            eris_string_set( &(__http->response.reason), eris_http_status_desc( 408));
+
+                            break;
+                        }
+                    }
+
+                    rc = eris_http_chunk_parse( __http, ERIS_HTTP_REQUEST, &(__http->bbuffer));
+                    eris_buffer_cleanup( &(__http->bbuffer), NULL);
+                    if ( 0 != rc) {
+                        /** Status is set by chunk parser */
+                        rc = (EERIS_DATA == rc) ? EERIS_4XX : EERIS_ERROR;
+
+                        break;
+                    }
+
+                    __http->body_total += __http->request.body.size;
+                    if ( __http->body_total > __http->attrs.body_max_size) {
+                        /** Request entity too large */
+                        rc = EERIS_4XX;
+
+                        __http->response.status  = ERIS_HTTP_413;
+                        __http->response.version = ERIS_HTTP_V10;
+                        eris_string_set( &(__http->response.reason), eris_http_status_desc( 413));
+
+                        if ( __http->log) {
+                            eris_log_dump( __http->log, ERIS_LOG_CORE, "Request content data too large");
+                        }
+
+                        break;
+                    }
+
+                    if ( __http->chunked_end) {
+                        __http->body_pending = false;
+                    }
+                } while ( __http->body_pending && (0 == __http->request.body.size));
+
+                if ( (0 == rc) && (0 < __http->request.body.size)) {
+                    *__data = __http->request.body.data;
+                    *__size = __http->request.body.size;
+
+                    __http->body_window = true;
+                }
+            } else {
+                /** Content-Length body, body buffer is the window */
+                if ( (0 == __http->bbuffer.size) && (0 < __http->body_remain)) {
+                    eris_size_t get_data_size = __http->body_remain;
+                    if ( get_data_size > __http->bbuffer.alloc) {
+                        get_data_size = __http->bbuffer.alloc;
+                    }
+
+                    rc = __http->body_incb( &(__http->bbuffer), get_data_size, __http->body_arg, __http->log);
+                    if ( (0 != rc) || (0 == __http->bbuffer.size)) {
+                        rc = EERIS_4XX;
+
+                        __http->response.status  = ERIS_HTTP_408;
+                        __http->response.version = ERIS_HTTP_V10;
+                        eris_string_set( &(__http->response.reason), eris_http_status_desc( 408));
+
+                    } else {
+                        /** Drop pipeline data of next request */
+                        if ( __http->bbuffer.size > __http->body_remain) {
+                            __http->bbuffer.size = __http->body_remain;
+                        }
+
+                        __http->body_remain -= __http->bbuffer.size;
+                    }
+                }
+
+                if ( (0 == rc) && (0 < __http->bbuffer.size)) {
+                    *__data = __http->bbuffer.data;
+                    *__size = __http->bbuffer.size;
+
+                    __http->body_total += __http->bbuffer.size;
+                    __http->body_window = true;
+                }
+
+                if ( 0 == __http->body_remain) {
+                    __http->body_pending = false;
+                }
+            }
+
+            if ( 0 != rc) {
+                __http->body_pending = false;
+
+                if ( __http->log) {
+                    eris_log_dump( __http->log, ERIS_LOG_CORE, "Read request body window failed, total.<%lu>", __http->body_total);
+                }
+            }
+        }
+    } else { rc = EERIS_ERROR; }
+
+    errno = tmp_errno;
+
+    return rc;
+}/// eris_http_request_body_read
+
+
+/**
+ * @Brief: Read all rest of deferred request body into request body buffer.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR or EERIS_4XX.
+ **/
+eris_int_t eris_http_request_body_load( eris_http_t *__http)
+{
+    eris_int_t tmp_errno = errno;
+    eris_int_t rc = 0;
+
+    if ( __http) {
+        if ( __http->body_pending) {
+            /** Content-Length is known and alloc one time, large body is spooled */
+            eris_size_t cap_size = __http->bbuffer.alloc;
+            if ( !__http->chunked) {
+                cap_size = __http->bbuffer.size + __http->body_remain + 1;
+
+                if ( (0 < __http->attrs.body_spool_size) && (cap_size > __http->attrs.body_spool_size)) {
+                    cap_size = 0;
+                }
+            }
+
+            eris_buffer_t body_buffer;
+            rc = eris_buffer_init( &body_buffer, cap_size, __http->log);
+            if ( 0 == rc) {
+                const eris_void_t *window_data = NULL;
+                eris_size_t        window_size = 0;
+
+                do {
+                    rc = eris_http_request_body_read( __http, &window_data, &window_size);
+                    if ( (0 == rc) && (0 < window_size)) {
+                        if ( (0 > __http->body_fd) &&
+                             (0 < __http->attrs.body_spool_size) &&
+                             ((body_buffer.size + window_size) > __http->attrs.body_spool_size) ) {
+                            /** Over spool size and move memory data to temp file */
+                            rc = eris_http_body_spool( __http, body_buffer.data, body_buffer.size);
+
+                            eris_buffer_free( &body_buffer);
+                        }
+
+                        if ( 0 == rc) {
+                            if ( 0 <= __http->body_fd) {
+                                rc = eris_http_body_spool( __http, window_data, window_size);
+
+                            } else { rc = eris_buffer_append( &body_buffer, window_data, window_size, __http->log); }
+                        }
+
+                        if ( 0 != rc) {
+                            rc = EERIS_ERROR;
+
+                            __http->body_pending = false;
+                            __http->response.status  = ERIS_HTTP_500;
+                            __http->response.version = ERIS_HTTP_V10;
+                            eris_string_set( &(__http->response.reason), eris_http_status_desc( 500));
+                        }
+                    }
+                } while ( (0 == rc) && (0 < window_size));
+
+                /** Spooled body and map it */
+                if ( (0 == rc) && (0 <= __http->body_fd)) {
+                    __http->body_map = mmap( NULL, __http->body_fd_size, PROT_READ, MAP_SHARED, __http->body_fd, 0);
+                    if ( MAP_FAILED == __http->body_map) {
+                        __http->body_map = NULL;
+
+                        /** Body data is not got by service without map */
+                        rc = EERIS_ERROR;
+
+                        __http->response.status  = ERIS_HTTP_500;
+                        __http->response.version = ERIS_HTTP_V10;
+                        eris_string_set( &(__http->response.reason), eris_http_status_desc( 500));
+
+                        if ( __http->log) {
+                            eris_log_dump( __http->log, ERIS_LOG_CORE, "Mmap spool body file failed, errno.<%d>", errno);
+                        }
+                    }
+                }
+
+                if ( 0 == rc) {
+                    /** Body buffer is request body */
+                    eris_buffer_free( &(__http->request.body));
+
+                    __http->request.body = body_buffer;
+                } else {
+                    eris_buffer_destroy( &body_buffer);
+
+                    eris_http_body_unspool( __http);
+                }
+            } else {
+                rc = EERIS_ERROR;
+
+                __http->body_pending = false;
+                __http->response.status  = ERIS_HTTP_500;
+                __http->response.version = ERIS_HTTP_V10;
+                eris_string_set( &(__http->response.reason), eris_http_status_desc( 500));
+            }
+
+            eris_buffer_cleanup( &(__http->bbuffer), NULL);
+        }
+    } else { rc = EERIS_ERROR; }
+
+    errno = tmp_errno;
+
+    return rc;
+}/// eris_http_request_body_load
+
+
+/**
+ * @Brief: Read and drop all rest of deferred request body.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR or EERIS_4XX.
+ **/
+eris_int_t eris_http_request_body_discard( eris_http_t *__http)
+{
+    eris_int_t rc = 0;
+
+    if ( __http) {
+        const eris_void_t *window_data = NULL;
+        eris_size_t        window_size = 0;
+
+        do {
+            rc = eris_http_request_body_read( __http, &window_data, &window_size);
+
+        } while ( (0 == rc) && (0 < window_size));
+
+        eris_buffer_cleanup( &(__http->bbuffer), NULL);
+    } else { rc = EERIS_ERROR; }
+
+    return rc;
+}/// eris_http_request_body_discard
+
+
 /**
  * @Brief: The client request want to shake hands.
  *
@@ -2419,7 +2795,8 @@ eris_int_t eris_http_response_parse( eris_http_t *__http, eris_http_cb_t __incb,
 
 
 /**
- * @Brief: Write http-response data package to callback output.
+ * @Brief: Write http-response data package to callback output,
+ *       : and body is gzipped if client accepts it.
  *
  * @Param: __http, Eris http context.
  * @Param: __outcb,Write http-response data to output callback.
@@ -2434,130 +2811,47 @@ eris_int_t eris_http_response_pack( eris_http_t *__http, eris_http_cb_t __outcb,
 
     if ( __http) {
         if ( __outcb) {
-            /** Clean up header/body buffer */
-            eris_buffer_cleanup( &(__http->hbuffer), NULL);
-
-            /** Append request version */
-            switch ( __http->response.version) {
-                case ERIS_HTTP_V11 :
-                    {
-                        /** HTTP/1.1 */
-                        rc = eris_buffer_append( &(__http->hbuffer), eris_http_version_tos(11), ERIS_HTTP_VERSION_SIZE, __http->log);
-                    } break;
-                case ERIS_HTTP_V09 :
-                    {
-                        /** HTTP/0.9 */
-                        rc = eris_buffer_append( &(__http->hbuffer), eris_http_version_tos(09), ERIS_HTTP_VERSION_SIZE, __http->log);
-                    } break;
-                case ERIS_HTTP_V10 :
-                default :
-                    {
-                        /** Default HTTP/1.0 */
-                        __http->request.version = ERIS_HTTP_V10;
-
-                        rc = eris_buffer_append( &(__http->hbuffer), eris_http_version_tos(10), ERIS_HTTP_VERSION_SIZE, __http->log);
-                    } break;
-            }/// switch
+            /** Gzip body at one time, and it is sent if it is smaller, HEAD is deflated too and its headers are same as GET */
+            if ( (0 > __http->resp_fd) && 
+                 (0 < __http->response.body.size) && 
+                 (__http->attrs.gzip_min_length <= __http->response.body.size) && 
+                 eris_http_response_gzip_begin( __http)) {
+                eris_int_t zrc = eris_http_response_gzip_deflate( __http, __http->response.body.data, __http->response.body.size, true);
+                if ( (0 == zrc) && (__http->resp_zbuffer.size < __http->response.body.size)) {
+                    __http->resp_gzip = true;
+
+                    rc = eris_http_response_set_header( __http, "Content-Encoding", "gzip");
+                    if ( (0 == rc) && eris_http_response_get_header( __http, "Content-Length")) {
+                        eris_char_t zsize_s[ 32] = {0};
+
+                        (eris_none_t )snprintf( zsize_s, sizeof( zsize_s), "%lu", (unsigned long )__http->resp_zbuffer.size);
+
+                        rc = eris_http_response_set_header( __http, "Content-Length", zsize_s);
+                    }
+                }
+            }
 
+            /** Make status line and headers */
             if ( 0 == rc) {
-                /** Append a empty Separator */
-                rc = eris_buffer_append_c( &(__http->hbuffer), ' ', __http->log);
+                rc = eris_http_response_pack_head( __http);
             }
-            
-            /** Append status and reason phrace */
+
+            /** Call back output request content package */
             if ( 0 == rc) {
-                if ( 0 < eris_string_size( __http->response.reason)) {
-                    eris_string_t tmp_status_reason_es;
-                    eris_string_init( tmp_status_reason_es);
+                rc = __outcb( &(__http->hbuffer), __http->hbuffer.size, __arg, __http->log);
+                if ( 0 == rc) {
+                   if (ERIS_HTTP_HEAD != __http->request.command ) {
+                       if ( 0 <= __http->resp_fd) {
+                            rc = eris_http_response_file_out( __http, __outcb, __arg);
+                            if ( 0 != rc) {
+                                rc = EERIS_ERROR;
 
-                    rc = eris_string_printf( &tmp_status_reason_es, "%i %S", __http->response.status, __http->response.reason);
-                    if ( 0 == rc) {
-                        rc = eris_buffer_append( &(__http->hbuffer), tmp_status_reason_es, eris_string_size( tmp_status_reason_es), __http->log);
-                        
-                    } else {
-                        rc = EERIS_ERROR;
+                                eris_log_dump( __http->log, ERIS_LOG_CORE, "Do output file body failed, errno.<%d>", errno);
+                            }
+                       } else if ( 0 < __http->response.body.size) {
+                            eris_buffer_t *p_body = __http->resp_gzip ? &(__http->resp_zbuffer) : &(__http->response.body);
 
-                        if ( __http->log) {
-                               eris_log_dump( __http->log, ERIS_LOG_CORE, "Make status and reason phrace failed, errno.<%d>", errno);
-                        }
-                    }
-
-                    eris_string_free( tmp_status_reason_es);
-                    eris_string_init( tmp_status_reason_es);
-                } else {
-                    eris_int_t i = 0;
-
-                    for ( i = 1; i < eris_http_status_map_reason_size; i++) {
-                        if ( eris_http_status_map_reason[i].status == __http->response.status) {
-                            break;
-                        }
-                    }
-
-                    if ( i < eris_http_status_map_reason_size) {
-                        rc = eris_buffer_append( &(__http->hbuffer), eris_http_status_map_reason[i].status_s, 3, __http->log);
-                        if ( 0 == rc) {
-                            /** Append a empty Separator */
-                            rc = eris_buffer_append_c( &(__http->hbuffer), ' ', __http->log);
-                        }
-
-                        if ( 0 == rc) {
-                            rc = eris_buffer_append( &(__http->hbuffer), 
-                                                     eris_http_status_map_reason[i].reason_phrace, 
-                                                     strlen( eris_http_status_map_reason[i].reason_phrace),
-                                                     __http->log);
-                        }
-                    } else {
-                        rc = EERIS_ERROR;
-
-                        if ( __http->log) {
-                               eris_log_dump( __http->log, ERIS_LOG_CORE, "Status value is invalid.");
-                        }
-                    }
-                }
-            }
-
-            /** Append CRLF end */
-            if ( 0 == rc) {
-                rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_CRLF, ERIS_HTTP_CRLF_SIZE, __http->log);
-            }
-
-            /** Append all headers */
-            if ( 0 == rc) {
-                eris_http_hnode_t *cur_hnode = __http->response.headers;
-
-                for ( ;cur_hnode; cur_hnode = cur_hnode->next) {
-                    /** Append name */
-                    rc = eris_buffer_append( &(__http->hbuffer), cur_hnode->name, eris_string_size( cur_hnode->name), __http->log);
-                    if ( 0 == rc) {
-                        rc = eris_buffer_append( &(__http->hbuffer), ": ", 2, __http->log);
-                        if ( 0 == rc) {
-                            /** Append value */
-                            rc = eris_buffer_append( &(__http->hbuffer), cur_hnode->value, eris_string_size( cur_hnode->value), __http->log);
-                            if ( 0 == rc) {
-                                rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_CRLF, ERIS_HTTP_CRLF_SIZE, __http->log);
-                            }
-                        }
-                    }
-
-                    /** Heppen error */
-                    if ( 0 != rc) { break; }
-                }
-
-                cur_hnode = NULL;
-            }
-
-            /** Append CRLF_CRLF header end */
-            if ( 0 == rc) {
-                rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_CRLF, ERIS_HTTP_CRLF_SIZE, __http->log);
-            }
-
-            /** Call back output request content package */
-            if ( 0 == rc) {
-                rc = __outcb( &(__http->hbuffer), __http->hbuffer.size, __arg, __http->log);
-                if ( 0 == rc) {
-                   if (ERIS_HTTP_HEAD != __http->request.command ) {
-                       if ( 0 < __http->response.body.size) {
-                            rc = __outcb( &(__http->response.body), __http->response.body.size, __arg, __http->log);
+                            rc = __outcb( p_body, p_body->size, __arg, __http->log);
                             if ( 0 != rc) {
                                 rc = EERIS_ERROR;
 
@@ -2587,202 +2881,595 @@ eris_int_t eris_http_response_pack( eris_http_t *__http, eris_http_cb_t __outcb,
 
 
 /**
- * @Brief: The client request connection is keep alive.
+ * @Brief: Set output callback of streaming response, if user is server.
  *
  * @Param: __http, Eris http context.
+ * @Param: __outcb,Write http-response data to output callback.
+ * @Param: __arg,  Call callback and input argument.
  *
- * @Return: Keep-alive is true, other is false.
+ * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-eris_bool_t eris_http_request_keep_alive( eris_http_t *__http)
+eris_int_t eris_http_response_set_outcb( eris_http_t *__http, eris_http_cb_t __outcb, eris_arg_t __arg)
 {
-    eris_bool_t rc = false;
+    eris_int_t rc = 0;
 
     if ( __http) {
-        const eris_string_t proxy_connection_es = eris_http_request_get_header( __http, "Proxy-Connection");
-        if ( proxy_connection_es) {
-            /** Proxy-Connecton is keep-alive */
-            if ( eris_string_isequal( proxy_connection_es, "keep-alive", true)) {
-
-                rc = true;
-            }
-        } else {
-            const eris_string_t connection_es = eris_http_request_get_header( __http, "Connection");
-            if ( connection_es) {
-                /** Connection: keep-alive */
-                if ( eris_string_isequal( connection_es, "keep-alive", true)) {
+        __http->resp_outcb = __outcb;
+        __http->resp_arg   = __arg;
 
-                    rc = true;
-                }
-            }
-        }
-    }
+    } else { rc = EERIS_ERROR; }
 
     return rc;
-}/// eris_http_request_keep_alive
+}/// eris_http_response_set_outcb
 
 
 /**
- * @Brief: The response connection is keep alive.
+ * @Brief: Set output callback of file body, it is called with the argument of pack,
+ *       : and file data is read and sent by output callback if it is unset.
  *
- * @Param: __http, Eris http context.
+ * @Param: __http,   Eris http context.
+ * @Param: __filecb, Send file data to output callback.
  *
- * @Return: Keep-alive is true, other is false.
+ * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-eris_bool_t eris_http_response_keep_alive( eris_http_t *__http)
+eris_int_t eris_http_response_set_filecb( eris_http_t *__http, eris_http_file_cb_t __filecb)
 {
-    eris_bool_t rc = false;
+    eris_int_t rc = 0;
 
     if ( __http) {
-        const eris_string_t proxy_connection_es = eris_http_response_get_header( __http, "Proxy-Connection");
-        if ( proxy_connection_es) {
-            /** Proxy-Connecton is keep-alive */
-            if ( eris_string_isequal( proxy_connection_es, "keep-alive", true)) {
-
-                rc = true;
-            }
-        } else {
-            const eris_string_t connection_es = eris_http_response_get_header( __http, "Connection");
-            if ( connection_es) {
-                /** Connection: keep-alive */
-                if ( eris_string_isequal( connection_es, "keep-alive", true)) {
+        __http->resp_filecb = __filecb;
 
-                    rc = true;
-                }
-            }
-        }
-    }
+    } else { rc = EERIS_ERROR; }
 
     return rc;
-}/// eris_http_response_keep_alive
+}/// eris_http_response_set_filecb
 
 
 /**
- * @Brief: Check request entity content is x-www-form-urlencoded format.
+ * @Brief: Set response body is file, the fd is owned and closed by http context.
  *
  * @Param: __http, Eris http context.
+ * @Param: __fd,   Opened file.
+ * @Param: __size, File size.
  *
- * @Return: Yes is true, other is false.
+ * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-eris_bool_t eris_http_request_is_x_www_form_urlencoded( eris_http_t *__http)
+eris_int_t eris_http_response_set_file( eris_http_t *__http, eris_fd_t __fd, eris_size_t __size)
 {
-    eris_bool_t rc = false;
+    eris_int_t rc = 0;
 
-    if ( __http) {
-        const eris_string_t content_type_vs = eris_http_request_get_header( __http, "Content-Type");
-        if ( content_type_vs) {
-            /** Content-Type: application/x-www-form-urlencoded */
-            if ( ERIS_STRING_NPOS != eris_string_find( content_type_vs, "application/x-www-form-urlencoded")) {
+    if ( __http && (0 <= __fd) && !(__http->resp_stream)) {
+        eris_http_response_file_close( __http);
 
-                rc = true;
-            }
-        }
-    }
+        /** Body set before is replaced */
+        eris_buffer_cleanup( &(__http->response.body), __http->log);
+
+        __http->resp_fd       = __fd;
+        __http->resp_fd_size  = __size;
+        __http->resp_total    = __size;
+        __http->resp_ranges_n = 0;
+
+    } else { rc = EERIS_ERROR; }
 
     return rc;
-}/// eris_http_request_is_x_www_form_urlencoded
+}/// eris_http_response_set_file
 
 
 /**
- * @Brief: Check response entity content is x-www-form-urlencoded format.
+ * @Brief: Set response body is metadata of file only, eg: HEAD. Content-Length
+ *       : and ranges are made of size, and nothing of body is sent.
  *
  * @Param: __http, Eris http context.
+ * @Param: __size, File size.
  *
- * @Return: Yes is true, other is false.
+ * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-eris_bool_t eris_http_response_is_x_www_form_urlencoded( eris_http_t *__http)
+eris_int_t eris_http_response_set_file_meta( eris_http_t *__http, eris_size_t __size)
 {
-    eris_bool_t rc = false;
+    eris_int_t rc = 0;
 
-    if ( __http) {
-        const eris_string_t content_type_vs = eris_http_response_get_header( __http, "Content-Type");
-        if ( content_type_vs) {
-            /** Content-Type: application/x-www-form-urlencoded */
-            if ( ERIS_STRING_NPOS != eris_string_find( content_type_vs, "application/x-www-form-urlencoded")) {
+    if ( __http && !(__http->resp_stream)) {
+        eris_http_response_file_close( __http);
 
-                rc = true;
-            }
-        }
-    }
+        /** Body set before is replaced */
+        eris_buffer_cleanup( &(__http->response.body), __http->log);
+
+        __http->resp_meta     = true;
+        __http->resp_fd_size  = __size;
+        __http->resp_total    = __size;
+        __http->resp_ranges_n = 0;
+
+    } else { rc = EERIS_ERROR; }
 
     return rc;
-}/// eris_http_response_is_x_www_form_urlencoded
+}/// eris_http_response_set_file_meta
 
 
 /**
- * @Brief: Check request entity content is json format.
+ * @Brief: Apply request Range and If-Range to file body, the validators (ETag 
+ *       : or Last-Modified) and Content-Type of response must be set before.
  *
  * @Param: __http, Eris http context.
  *
- * @Return: Yes is true, other is false.
+ * @Return: Ranges applied is 0, Serve whole file is EERIS_NOTFOUND,
+ *        : Unsatisfiable is EERIS_INVALID, Other is EERIS_ERROR.
  **/
-eris_bool_t eris_http_request_is_json( eris_http_t *__http)
+eris_int_t eris_http_response_set_ranges( eris_http_t *__http)
 {
-    eris_bool_t rc = false;
+    eris_int_t rc = EERIS_NOTFOUND;
 
-    if ( __http) {
-        const eris_string_t content_type_vs = eris_http_request_get_header( __http, "Content-Type");
-        if ( content_type_vs) {
-            /** Content-Type: application/json */
-            if ( ERIS_STRING_NPOS != eris_string_find( content_type_vs, "application/json")) {
+    if ( !__http || ((0 > __http->resp_fd) && !__http->resp_meta)) { return EERIS_ERROR; }
 
-                rc = true;
-            }
+    const eris_char_t *p_range = eris_http_request_get_header( __http, "Range");
+    if ( !p_range || (0 != strncasecmp( p_range, "bytes=", 6))) { return EERIS_NOTFOUND; }
+
+    /** If-Range is an entity-tag or a date, else whole file */
+    const eris_char_t *p_if_range = eris_http_request_get_header( __http, "If-Range");
+    if ( p_if_range) {
+        const eris_char_t *p_validator = ('"' == *p_if_range) ? 
+                                         eris_http_response_get_header( __http, "ETag") :
+                                         eris_http_response_get_header( __http, "Last-Modified");
+
+        if ( !p_validator || (0 != strcmp( p_if_range, p_validator))) { return EERIS_NOTFOUND; }
+    }
+
+    eris_size_t file_size = __http->resp_fd_size;
+    eris_int_t  ranges_n  = 0;
+    eris_int_t  specs_n   = 0;
+
+    const eris_char_t *p = p_range + 6;
+    while ( *p) {
+        while ( (' ' == *p) || ('\t' == *p)) { p++; }
+
+        eris_bool_t has_first = false;
+        eris_bool_t has_last  = false;
+        eris_size_t first     = 0;
+        eris_size_t last      = 0;
+
+        /** Overflow of positions, the Range is ignored */
+        while ( ('0' <= *p) && ('9' >= *p)) {
+            if ( first > ERIS_HTTP_RANGE_POS_MAX) { return EERIS_NOTFOUND; }
+
+            first = first * 10 + (*p++ - '0'); has_first = true; 
+        }
+        while ( (' ' == *p) || ('\t' == *p)) { p++; }
+
+        if ( '-' != *p) { return EERIS_NOTFOUND; }
+        p++;
+
+        while ( (' ' == *p) || ('\t' == *p)) { p++; }
+        while ( ('0' <= *p) && ('9' >= *p)) {
+            if ( last > ERIS_HTTP_RANGE_POS_MAX) { return EERIS_NOTFOUND; }
+
+            last = last * 10 + (*p++ - '0'); has_last = true; 
+        }
+        while ( (' ' == *p) || ('\t' == *p)) { p++; }
+
+        if ( *p && (',' != *p)) { return EERIS_NOTFOUND; }
+        if ( ',' == *p) { p++; }
+
+        /** Bad spec and too many specs, the Range is ignored */
+        if ( (!has_first && !has_last) || (has_first && has_last && (last < first))) { return EERIS_NOTFOUND; }
+        if ( ERIS_HTTP_RANGES_MAX < ++specs_n) { return EERIS_NOTFOUND; }
+
+        if ( !has_first) {
+            /** Suffix range, last n bytes */
+            if ( (0 == last) || (0 == file_size)) { continue; }
+            if ( last > file_size) { last = file_size; }
+
+            first = file_size - last;
+            last  = file_size - 1;
+
+        } else {
+            /** Unsatisfiable spec is skipped */
+            if ( first >= file_size) { continue; }
+            if ( !has_last || (last >= file_size)) { last = file_size - 1; }
+        }
+
+        __http->resp_ranges[ ranges_n].offset = (eris_off_t )first;
+        __http->resp_ranges[ ranges_n].size   = last - first + 1;
+        ranges_n++;
+    }
+
+    if ( 0 == specs_n) { return EERIS_NOTFOUND; }
+
+    eris_char_t content_range[ 96] = {0};
+    if ( 0 == ranges_n) {
+        /** None satisfiable, and file is not sent */
+        rc = EERIS_INVALID;
+
+        eris_http_response_file_close( __http);
+
+        (eris_none_t )snprintf( content_range, sizeof( content_range), "bytes */%lu", (eris_ulong_t )file_size);
+        if ( 0 != eris_http_response_set_header( __http, "Content-Range", content_range)) {
+            rc = EERIS_ERROR;
+        }
+    } else if ( 1 == ranges_n) {
+        rc = 0;
+
+        (eris_none_t )snprintf( content_range, sizeof( content_range), "bytes %lu-%lu/%lu", 
+                                (eris_ulong_t )__http->resp_ranges[ 0].offset,
+                                (eris_ulong_t )(__http->resp_ranges[ 0].offset + __http->resp_ranges[ 0].size - 1),
+                                (eris_ulong_t )file_size);
+
+        if ( 0 == eris_http_response_set_header( __http, "Content-Range", content_range)) {
+            __http->resp_ranges_n = 1;
+            __http->resp_total    = __http->resp_ranges[ 0].size;
+
+        } else { rc = EERIS_ERROR; }
+    } else {
+        rc = 0;
+
+        /** Each part has its Content-Type */
+        const eris_char_t *p_type = eris_http_response_get_header( __http, "Content-Type");
+        if ( 0 != eris_string_set( &(__http->resp_part_type), p_type ? p_type : "application/octet-stream")) {
+            rc = EERIS_ERROR;
+        }
+
+        if ( 0 == rc) {
+            eris_time_t now = 0;
+            eris_time_get( now);
+
+            (eris_none_t )snprintf( __http->resp_boundary, sizeof( __http->resp_boundary), "%08lx%08lx",
+                                    (eris_ulong_t )now & 0xfffffffful,
+                                    ((eris_ulong_t )__http >> 4) & 0xfffffffful);
+
+            eris_char_t content_type[ 64] = {0};
+            (eris_none_t )snprintf( content_type, sizeof( content_type), "multipart/byteranges; boundary=%s", __http->resp_boundary);
+
+            rc = eris_http_response_set_header( __http, "Content-Type", content_type);
         }
+
+        if ( 0 == rc) {
+            __http->resp_ranges_n = ranges_n;
+
+            /** Parts head and data, and tail line */
+            eris_int_t  i     = 0;
+            eris_size_t total = 0;
+            eris_char_t part_head[ 256];
+
+            for ( i = 0; i < ranges_n; i++) {
+                total += eris_http_response_part_head( __http, i, part_head, sizeof( part_head));
+                total += __http->resp_ranges[ i].size;
+            }
+
+            total += ERIS_HTTP_CRLF_SIZE + 2 + strlen( __http->resp_boundary) + 2 + ERIS_HTTP_CRLF_SIZE;
+
+            __http->resp_total = total;
+        } else { rc = EERIS_ERROR; }
     }
 
     return rc;
-}/// eris_http_request_is_json
+}/// eris_http_response_set_ranges
 
 
 /**
- * @Brief: Check response entity content is json format.
+ * @Brief: Write response body data to client at once, the head is sent at first call,
+ *       : and body is chunked of HTTP/1.1, the headers and status can't be changed after.
  *
  * @Param: __http, Eris http context.
+ * @Param: __data, Body data.
+ * @Param: __size, Body data size.
  *
- * @Return: Yes is true, other is false.
+ * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-eris_bool_t eris_http_response_is_json( eris_http_t *__http)
+eris_int_t eris_http_response_write( eris_http_t *__http, const eris_void_t *__data, eris_size_t __size)
 {
-    eris_bool_t rc = false;
+    eris_int_t tmp_errno = errno;
+    eris_int_t rc = 0;
 
     if ( __http) {
-        const eris_string_t content_type_vs = eris_http_response_get_header( __http, "Content-Type");
-        if ( content_type_vs) {
-            /** Content-Type: application/json */
-            if ( ERIS_STRING_NPOS != eris_string_find( content_type_vs, "application/json")) {
+        if ( !__http->resp_finished) {
+            if ( !__http->resp_stream) {
+                rc = eris_http_response_stream_begin( __http);
+            }
 
-                rc = true;
+            /** Zero size chunk is the last, so skip it */
+            if ( (0 == rc) && __data && (0 < __size)) {
+                if ( ERIS_HTTP_HEAD != __http->request.command) {
+                    rc = eris_http_response_stream_out( __http, __data, __size);
+                }
+            }
+        } else {
+            rc = EERIS_ERROR;
+
+            if ( __http->log) {
+                eris_log_dump( __http->log, ERIS_LOG_CORE, "Write response body after finished.");
             }
         }
-    }
+    } else { rc = EERIS_ERROR; }
+
+    errno = tmp_errno;
 
     return rc;
-}/// eris_http_response_is_json
+}/// eris_http_response_write
 
 
 /**
- * @Brief: Check http context is chunked.
+ * @Brief: Finish streaming response and send the last chunk.
  *
  * @Param: __http, Eris http context.
  *
- * @Return: It is has chunked data is true, Other is false.
+ * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-eris_bool_t eris_http_is_chunked( eris_http_t *__http)
+eris_int_t eris_http_response_finish( eris_http_t *__http)
 {
+    eris_int_t tmp_errno = errno;
+    eris_int_t rc = 0;
+
     if ( __http) {
-        return __http->chunked;
-    }
+        if ( !__http->resp_finished) {
+            if ( !__http->resp_stream) {
+                rc = eris_http_response_stream_begin( __http);
+            }
 
-    return false;
-}/// eris_http_is_chunked
+            /** Flush the rest and trailer of gzip */
+            if ( (0 == rc) && __http->resp_gzip && (ERIS_HTTP_HEAD != __http->request.command)) {
+                rc = eris_http_response_gzip_deflate( __http, NULL, 0, true);
+                if ( (0 == rc) && (0 < __http->resp_zbuffer.size)) {
+                    rc = eris_http_response_stream_send( __http, __http->resp_zbuffer.data, __http->resp_zbuffer.size);
+                }
+            }
 
+            if ( (0 == rc) && __http->resp_chunked && (ERIS_HTTP_HEAD != __http->request.command)) {
+                eris_buffer_cleanup( &(__http->hbuffer), NULL);
 
-/**
- * @Brief: Check http context parse is chunked ok.
- *
- * @Param: __http, Eris http context.
- *
- * @Return: It is parse chunked data end is true, Other is false.
+                /** Last chunk and empty trailer */
+                rc = eris_buffer_append( &(__http->hbuffer), "0"ERIS_HTTP_CRLF""ERIS_HTTP_CRLF, 1 + (2 * ERIS_HTTP_CRLF_SIZE), __http->log);
+                if ( 0 == rc) {
+                    rc = __http->resp_outcb( &(__http->hbuffer), __http->hbuffer.size, __http->resp_arg, __http->log);
+                }
+
+                if ( 0 != rc) {
+                    rc = EERIS_ERROR;
+
+                    if ( __http->log) {
+                        eris_log_dump( __http->log, ERIS_LOG_CORE, "Do output last chunk failed, errno.<%d>", errno);
+                    }
+                }
+            }
+
+            __http->resp_finished = true;
+        }
+    } else { rc = EERIS_ERROR; }
+
+    errno = tmp_errno;
+
+    return rc;
+}/// eris_http_response_finish
+
+
+/**
+ * @Brief: Check response is streaming and head is sent.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: yes is true, other is false.
+ **/
+eris_bool_t eris_http_response_streaming( const eris_http_t *__http)
+{
+    if ( __http) {
+        return __http->resp_stream;
+    }
+
+    return false;
+}/// eris_http_response_streaming
+
+
+/**
+ * @Brief: The client request accepts gzip content-coding.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Accept is true, other is false.
+ **/
+eris_bool_t eris_http_request_accept_gzip( const eris_http_t *__http)
+{
+    if ( __http) {
+        return eris_http_accept_gzip( eris_http_request_get_header( __http, "Accept-Encoding"));
+    }
+
+    return false;
+}/// eris_http_request_accept_gzip
+
+
+/**
+ * @Brief: The client request connection is keep alive.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Keep-alive is true, other is false.
+ **/
+eris_bool_t eris_http_request_keep_alive( eris_http_t *__http)
+{
+    eris_bool_t rc = false;
+
+    if ( __http) {
+        const eris_string_t proxy_connection_es = eris_http_request_get_header( __http, "Proxy-Connection");
+        if ( proxy_connection_es) {
+            /** Proxy-Connecton is keep-alive */
+            if ( eris_string_isequal( proxy_connection_es, "keep-alive", true)) {
+
+                rc = true;
+            }
+        } else {
+            const eris_string_t connection_es = eris_http_request_get_header( __http, "Connection");
+            if ( connection_es) {
+                /** Connection: keep-alive */
+                if ( eris_string_isequal( connection_es, "keep-alive", true)) {
+
+                    rc = true;
+                }
+            }
+        }
+    }
+
+    return rc;
+}/// eris_http_request_keep_alive
+
+
+/**
+ * @Brief: The response connection is keep alive.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Keep-alive is true, other is false.
+ **/
+eris_bool_t eris_http_response_keep_alive( eris_http_t *__http)
+{
+    eris_bool_t rc = false;
+
+    if ( __http) {
+        const eris_string_t proxy_connection_es = eris_http_response_get_header( __http, "Proxy-Connection");
+        if ( proxy_connection_es) {
+            /** Proxy-Connecton is keep-alive */
+            if ( eris_string_isequal( proxy_connection_es, "keep-alive", true)) {
+
+                rc = true;
+            }
+        } else {
+            const eris_string_t connection_es = eris_http_response_get_header( __http, "Connection");
+            if ( connection_es) {
+                /** Connection: keep-alive */
+                if ( eris_string_isequal( connection_es, "keep-alive", true)) {
+
+                    rc = true;
+                }
+            }
+        }
+    }
+
+    return rc;
+}/// eris_http_response_keep_alive
+
+
+/**
+ * @Brief: Check request entity content is x-www-form-urlencoded format.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Yes is true, other is false.
+ **/
+eris_bool_t eris_http_request_is_x_www_form_urlencoded( eris_http_t *__http)
+{
+    eris_bool_t rc = false;
+
+    if ( __http) {
+        const eris_string_t content_type_vs = eris_http_request_get_header( __http, "Content-Type");
+        if ( content_type_vs) {
+            /** Content-Type: application/x-www-form-urlencoded */
+            if ( ERIS_STRING_NPOS != eris_string_find( content_type_vs, "application/x-www-form-urlencoded")) {
+
+                rc = true;
+            }
+        }
+    }
+
+    return rc;
+}/// eris_http_request_is_x_www_form_urlencoded
+
+
+/**
+ * @Brief: Check response entity content is x-www-form-urlencoded format.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Yes is true, other is false.
+ **/
+eris_bool_t eris_http_response_is_x_www_form_urlencoded( eris_http_t *__http)
+{
+    eris_bool_t rc = false;
+
+    if ( __http) {
+        const eris_string_t content_type_vs = eris_http_response_get_header( __http, "Content-Type");
+        if ( content_type_vs) {
+            /** Content-Type: application/x-www-form-urlencoded */
+            if ( ERIS_STRING_NPOS != eris_string_find( content_type_vs, "application/x-www-form-urlencoded")) {
+
+                rc = true;
+            }
+        }
+    }
+
+    return rc;
+}/// eris_http_response_is_x_www_form_urlencoded
+
+
+/**
+ * @Brief: Check request entity content is json format.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Yes is true, other is false.
+ **/
+eris_bool_t eris_http_request_is_json( eris_http_t *__http)
+{
+    eris_bool_t rc = false;
+
+    if ( __http) {
+        const eris_string_t content_type_vs = eris_http_request_get_header( __http, "Content-Type");
+        if ( content_type_vs) {
+            /** Content-Type: application/json */
+            if ( ERIS_STRING_NPOS != eris_string_find( content_type_vs, "application/json")) {
+
+                rc = true;
+            }
+        }
+    }
+
+    return rc;
+}/// eris_http_request_is_json
+
+
+/**
+ * @Brief: Check response entity content is json format.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Yes is true, other is false.
+ **/
+eris_bool_t eris_http_response_is_json( eris_http_t *__http)
+{
+    eris_bool_t rc = false;
+
+    if ( __http) {
+        const eris_string_t content_type_vs = eris_http_response_get_header( __http, "Content-Type");
+        if ( content_type_vs) {
+            /** Content-Type: application/json */
+            if ( ERIS_STRING_NPOS != eris_string_find( content_type_vs, "application/json")) {
+
+                rc = true;
+            }
+        }
+    }
+
+    return rc;
+}/// eris_http_response_is_json
+
+
+/**
+ * @Brief: Check http context is chunked.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: It is has chunked data is true, Other is false.
+ **/
+eris_bool_t eris_http_is_chunked( eris_http_t *__http)
+{
+    if ( __http) {
+        return __http->chunked;
+    }
+
+    return false;
+}/// eris_http_is_chunked
+
+
+/**
+ * @Brief: Check http context parse is chunked ok.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: It is parse chunked data end is true, Other is false.
  **/
 eris_bool_t eris_http_is_chunked_end( eris_http_t *__http)
 {
@@ -2809,7 +3496,6 @@ eris_int_t eris_http_chunk_parse( eris_http_t *__http, eris_http_type_t __type,
 
     if ( __http && __inbuffer) {
         if ( 0 < __inbuffer->size) {
-            eris_string_t chunk_size_s = NULL;
             const eris_char_t *pb = (const eris_char_t *)(__inbuffer->data);
 
             eris_size_t i = 0;
@@ -2840,16 +3526,7 @@ eris_int_t eris_http_chunk_parse( eris_http_t *__http, eris_http_type_t __type,
                             if ( ERIS_CHAR_IS_HEX( pb[ i])) {
                                 __http->chunk_state = ERIS_HTTP_CHUNK_SIZE;
 
-                                rc = eris_string_append_c( &chunk_size_s, (eris_char_t )pb[ i]);
-                                if ( 0 != rc) {
-                                    rc = EERIS_ERROR;
-
-                                    if ( ERIS_HTTP_REQUEST == __type) {
-                                        __http->response.status  = ERIS_HTTP_500;
-                                        __http->response.version = ERIS_HTTP_V10;
-                                        eris_string_set( &(__http->response.reason), eris_http_status_desc( 500));
-                                    }
-                                }
+                                rc = eris_http_chunk_size_add( __http, __type, pb[ i]);
                             } else {
                                 rc = EERIS_DATA;
 
@@ -2870,18 +3547,9 @@ eris_int_t eris_http_chunk_parse( eris_http_t *__http, eris_http_type_t __type,
                             if ( ERIS_CHAR_IS_HEX( pb[ i])) {
                                 __http->chunk_state = ERIS_HTTP_CHUNK_SIZE;
 
-                                rc = eris_string_append_c( &chunk_size_s, (eris_char_t )pb[i] );
-                                if ( 0 != rc) {
-                                    rc = EERIS_ERROR;
-
-                                    if ( ERIS_HTTP_REQUEST == __type) {
-                                        __http->response.status  = ERIS_HTTP_500;
-                                        __http->response.version = ERIS_HTTP_V10;
-                                        eris_string_set( &(__http->response.reason), eris_http_status_desc( 500));
-                                    }
-                                }
-                            } else if ( ';'  == pb[ i]) {
-                                __http->chunk_state = ERIS_HTTP_CHUNK_EXT_NAME;
+                                rc = eris_http_chunk_size_add( __http, __type, pb[ i]);
+                            } else if ( ';'  == pb[ i]) {
+                                __http->chunk_state = ERIS_HTTP_CHUNK_EXT_NAME;
 
                             } else if ( '\r' == pb[ i]) {
                                 __http->chunk_state = ERIS_HTTP_CHUNK_CR1;
@@ -2956,10 +3624,6 @@ eris_int_t eris_http_chunk_parse( eris_http_t *__http, eris_http_type_t __type,
                     case ERIS_HTTP_CHUNK_CR1 :
                         {
                             if ( '\n' == pb[ i]) {
-                                __http->chunk_size = eris_string_hextov( chunk_size_s );
-
-                                eris_string_cleanup( chunk_size_s);
-
                                 __http->chunk_state = ERIS_HTTP_CHUNK_LF1;
                             } else {
                                 rc = EERIS_DATA;
@@ -2977,36 +3641,66 @@ eris_int_t eris_http_chunk_parse( eris_http_t *__http, eris_http_type_t __type,
                         } break;
                     case ERIS_HTTP_CHUNK_LF1 :
                         {
-                            if ( '\r' == pb[ i]) {
-                                __http->chunk_state = ERIS_HTTP_CHUNK_CR2;
+                            if ( 0 == __http->chunk_size) {
+                                if ( '\r' == pb[ i]) {
+                                    __http->chunk_state = ERIS_HTTP_CHUNK_CR2;
 
-                            } else {
-                                if ( 0 == __http->chunk_size) {
-                                    __http->chunk_state = ERIS_HTTP_CHUNK_TRAILER_NAME;
+                                } else { __http->chunk_state = ERIS_HTTP_CHUNK_TRAILER_NAME; }
+
+                                break;
+                            }
+
+                            /** First byte of chunk data, go on data */
+                            __http->chunk_state = ERIS_HTTP_CHUNK_DATA;
+                        }
+                    case ERIS_HTTP_CHUNK_DATA :
+                        {
+                            if ( __http->tmp_chunk_size < __http->chunk_size) {
+                                /** Append run of chunk data, it is binary */
+                                eris_size_t data_size = __http->chunk_size - __http->tmp_chunk_size;
+                                if ( data_size > (__inbuffer->size - i)) {
+                                    data_size = __inbuffer->size - i;
+                                }
+
+                                if ( ERIS_HTTP_REQUEST == __type) {
+                                    /** Request chunked */
+                                    rc = eris_buffer_append( &(__http->request.body), pb + i, data_size, __http->log);
 
                                 } else {
-                                    if ( ERIS_HTTP_REQUEST == __type) {
-                                        /** Request chunked */
-                                        rc = eris_buffer_append_c( &(__http->request.body), pb[ i], __http->log);
+                                    /** Response chunked */
+                                    rc = eris_buffer_append( &(__http->response.body), pb + i, data_size, __http->log);
+                                }
 
-                                    } else {
-                                        /** Response chunked */
-                                        rc = eris_buffer_append_c( &(__http->response.body), pb[ i], __http->log);
+                                if ( 0 != rc) {
+                                    /** Append error */
+                                    rc = EERIS_ERROR;
+
+                                    if ( ERIS_HTTP_REQUEST == __type) {
+                                        __http->response.status  = ERIS_HTTP_500;
+                                        __http->response.version = ERIS_HTTP_V10;
+                                        eris_string_set( &(__http->response.reason), eris_http_status_desc( 500));
                                     }
+                                }
 
-                                    if ( 0 != rc) {
-                                        /** Append error */
-                                        rc = EERIS_ERROR;
+                                __http->tmp_chunk_size += data_size;
+                                i += data_size - 1;
 
-                                        if ( ERIS_HTTP_REQUEST == __type) {
-                                            __http->response.status  = ERIS_HTTP_500;
-                                            __http->response.version = ERIS_HTTP_V10;
-                                            eris_string_set( &(__http->response.reason), eris_http_status_desc( 500));
-                                        }
-                                    }
+                            } else if ( '\r' == pb[ i]) {
+                                __http->chunk_state = ERIS_HTTP_CHUNK_DATA_CR;
+
+                                __http->chunk_size     = 0;
+                                __http->tmp_chunk_size = 0;
+                            } else {
+                                rc = EERIS_DATA;
+
+                                if ( ERIS_HTTP_REQUEST == __type) {
+                                    __http->response.status  = ERIS_HTTP_400;
+                                    __http->response.version = ERIS_HTTP_V10;
+                                    eris_string_set( &(__http->response.reason), eris_http_status_desc( 400));
+                                }
 
-                                    __http->tmp_chunk_size++;
-                                    __http->chunk_state = ERIS_HTTP_CHUNK_DATA;
+                                if ( __http->log) {
+                                    eris_log_dump( __http->log, ERIS_LOG_CORE, "Chunk data is unequal chunk size");
                                 }
                             }
                         } break;
@@ -3085,65 +3779,6 @@ eris_int_t eris_http_chunk_parse( eris_http_t *__http, eris_http_type_t __type,
                                 }
                             }
                         } break;
-                    case ERIS_HTTP_CHUNK_DATA :
-                        {
-                            if ( '\r' == pb[ i]) {
-                                __http->chunk_state = ERIS_HTTP_CHUNK_DATA_CR;
-
-                                if ( __http->tmp_chunk_size != __http->chunk_size ) {
-                                    rc = EERIS_DATA;
-
-                                    if ( ERIS_HTTP_REQUEST == __type) {
-                                        __http->response.status  = ERIS_HTTP_400;
-                                        __http->response.version = ERIS_HTTP_V10;
-                                        eris_string_set( &(__http->response.reason), eris_http_status_desc( 400));
-                                    }
-
-                                    if ( __http->log) {
-                                        eris_log_dump( __http->log, ERIS_LOG_CORE, "Chunk data is unequal chunk size");
-                                    }
-                                }
-
-                                __http->chunk_size     = 0;
-                                __http->tmp_chunk_size = 0;
-                            } else {
-                                if ( __http->tmp_chunk_size < __http->chunk_size) {
-                                    if ( ERIS_HTTP_REQUEST == __type) {
-                                        /** Request chunked */
-                                        rc = eris_buffer_append_c( &(__http->request.body), pb[ i], __http->log);
-
-                                    } else {
-                                        /** Response chunked */
-                                        rc = eris_buffer_append_c( &(__http->response.body), pb[ i], __http->log);
-                                    }
-
-                                    if ( 0 != rc) {
-                                        /** Append error */
-                                        rc = EERIS_ERROR;
-
-                                        if ( ERIS_HTTP_REQUEST == __type) {
-                                            __http->response.status  = ERIS_HTTP_500;
-                                            __http->response.version = ERIS_HTTP_V10;
-                                            eris_string_set( &(__http->response.reason), eris_http_status_desc( 500));
-                                        }
-                                    }
-
-                                    __http->tmp_chunk_size++;
-                                } else {
-                                    rc = EERIS_DATA;
-
-                                    if ( ERIS_HTTP_REQUEST == __type) {
-                                        __http->response.status  = ERIS_HTTP_400;
-                                        __http->response.version = ERIS_HTTP_V10;
-                                        eris_string_set( &(__http->response.reason), eris_http_status_desc( 400));
-                                    }
-
-                                    if ( __http->log) {
-                                        eris_log_dump( __http->log, ERIS_LOG_CORE, "Chunk data is unequal chunk size");
-                                    }
-                                }
-                            }
-                        } break;
                     case ERIS_HTTP_CHUNK_DATA_CR :
                         {
                             if ( '\n' == pb[ i]) {
@@ -3173,16 +3808,7 @@ eris_int_t eris_http_chunk_parse( eris_http_t *__http, eris_http_type_t __type,
                                 if ( ERIS_CHAR_IS_HEX( pb[ i])) {
                                     __http->chunk_state = ERIS_HTTP_CHUNK_SIZE;
 
-                                    rc = eris_string_append_c( &chunk_size_s, (eris_char_t )pb[ i]);
-                                    if ( 0 != rc) {
-                                        rc = EERIS_ERROR;
-
-                                        if ( ERIS_HTTP_REQUEST == __type) {
-                                            __http->response.status  = ERIS_HTTP_500;
-                                            __http->response.version = ERIS_HTTP_V10;
-                                            eris_string_set( &(__http->response.reason), eris_http_status_desc( 500));
-                                        }
-                                    }
+                                    rc = eris_http_chunk_size_add( __http, __type, pb[ i]);
                                 } else {
                                     rc = EERIS_DATA;
 
@@ -3209,11 +3835,6 @@ eris_int_t eris_http_chunk_parse( eris_http_t *__http, eris_http_type_t __type,
                     break;
                 }
             }/// for ( i = 0; i < __inbuffer.size; i++)
-
-            if ( chunk_size_s ) {
-                eris_string_free( chunk_size_s);
-                chunk_size_s = NULL;
-            }
         } 
 
         if ( (0 != rc) || ( __http->chunked_end)) {
@@ -3775,6 +4396,11 @@ const eris_buffer_t *eris_http_request_get_body( const eris_http_t *__http)
 const eris_void_t *eris_http_request_get_body_data( const eris_http_t *__http)
 {
     if ( __http) {
+        /** Spooled body is file mapping */
+        if ( 0 <= __http->body_fd) {
+            return __http->body_map;
+        }
+
         /** Request body buffer data */
         return eris_buffer_data( &(__http->request.body), __http->log);
     }
@@ -3793,6 +4419,11 @@ const eris_void_t *eris_http_request_get_body_data( const eris_http_t *__http)
 eris_size_t eris_http_request_get_body_size( const eris_http_t *__http)
 {
     if ( __http) {
+        /** Spooled body size */
+        if ( 0 <= __http->body_fd) {
+            return __http->body_fd_size;
+        }
+
         /** Response body buffer size */
         return eris_buffer_size( &(__http->request.body), __http->log);
     }
@@ -3801,6 +4432,82 @@ eris_size_t eris_http_request_get_body_size( const eris_http_t *__http)
 }/// eris_http_request_get_body_size
 
 
+/**
+ * @Brief: Check http request body is spooled to temp file, if user is server.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: yes is true, other is false.
+ **/
+eris_bool_t eris_http_request_body_spooled( const eris_http_t *__http)
+{
+    if ( __http) {
+        return (0 <= __http->body_fd);
+    }
+
+    return false;
+}/// eris_http_request_body_spooled
+
+
+/**
+ * @Brief: Get spooled request body file descriptor, if user is server.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Spooled is fd, Other is -1.
+ **/
+eris_fd_t eris_http_request_get_body_fd( const eris_http_t *__http)
+{
+    if ( __http) {
+        return __http->body_fd;
+    }
+
+    return -1;
+}/// eris_http_request_get_body_fd
+
+
+/**
+ * @Brief: Read request body data at offset, spooled or in memory, if user is server.
+ *
+ * @Param: __http,   Eris http context.
+ * @Param: __buf,    Output data buffer.
+ * @Param: __size,   Output buffer size.
+ * @Param: __offset, Offset of body.
+ *
+ * @Return: Read size, end is 0, Other is -1.
+ **/
+eris_ssize_t eris_http_request_body_pread( const eris_http_t *__http, eris_void_t *__buf, eris_size_t __size, eris_off_t __offset)
+{
+    eris_ssize_t r_size = -1;
+
+    if ( __http && __buf && (0 <= __offset)) {
+        if ( 0 <= __http->body_fd) {
+            eris_files_t body_file; {
+                body_file.name   = NULL;
+                body_file.fd     = __http->body_fd;
+                body_file.offset = __offset;
+                body_file.log    = __http->log;
+            }
+
+            r_size = eris_files_read( &body_file, (eris_uchar_t *)__buf, __size, __offset);
+        } else {
+            r_size = 0;
+
+            if ( (eris_size_t )__offset < __http->request.body.size) {
+                r_size = __http->request.body.size - (eris_size_t )__offset;
+                if ( (eris_size_t )r_size > __size) {
+                    r_size = __size;
+                }
+
+                eris_memory_copy( __buf, __http->request.body.data + __offset, r_size);
+            }
+        }
+    }
+
+    return r_size;
+}/// eris_http_request_body_pread
+
+
 /**
  * @Brief: Set response version, if user is server.
  *
@@ -3823,6 +4530,29 @@ eris_int_t eris_http_response_set_version( eris_http_t *__http, eris_http_versio
 }/// eris_http_response_set_version
 
 
+/**
+ * @Brief: Set Server, Date and Connection headers, if user is server,
+ *       : they are preformatted and packed without header nodes.
+ *
+ * @Param: __http,       Eris http context.
+ * @Param: __keep_alive, Connection is keep-alive or close.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+eris_int_t eris_http_response_set_base_headers( eris_http_t *__http, eris_bool_t __keep_alive)
+{
+    eris_int_t rc = 0;
+
+    if ( __http) {
+        __http->resp_base      = true;
+        __http->resp_keepalive = __keep_alive;
+
+    } else { rc = EERIS_ERROR; }
+
+    return rc;
+}/// eris_http_response_set_base_headers
+
+
 /**
  * @Brief: Set response status, if user is server.
  *
@@ -3904,7 +4634,6 @@ eris_int_t eris_http_response_set_header( eris_http_t *__http, const eris_char_t
 
             /** Is existed... */
             if ( cur_hnode) {
-                printf( "3----%s:%s\n", __name, __value);
                 /** Set new value */
                 rc = eris_string_set( &(cur_hnode->value), __value);
                 if ( 0 != rc) {
@@ -3961,520 +4690,1407 @@ eris_int_t eris_http_response_set_header( eris_http_t *__http, const eris_char_t
         } else {
             rc = EERIS_ERROR;
 
-            if ( __http->log) {
-                eris_log_dump( __http->log, ERIS_LOG_CORE, "Input header name-value is invalid.");
-            }
+            if ( __http->log) {
+                eris_log_dump( __http->log, ERIS_LOG_CORE, "Input header name-value is invalid.");
+            }
+        }
+    } else { rc = EERIS_ERROR; }
+
+    errno = tmp_errno;
+
+    return rc;
+}/// eris_http_response_set_header
+
+
+/**
+ * @Brief: Delete http header of name, if user is server.
+ *
+ * @Param: __http,  Eris http context.
+ * @Param: __name,  HTTP protocol header name.
+ * 
+ * @Return: Nothing.
+ **/
+eris_none_t eris_http_response_del_header( eris_http_t *__http, const eris_char_t *__name)
+{
+    if ( __http && __name) {
+        eris_http_hnode_t **cur_hnode = &(__http->response.headers);
+
+        while ( *cur_hnode) {
+            if ( eris_string_isequal( (*cur_hnode)->name, __name, true)) {
+                eris_http_hnode_t *del_hnode = *cur_hnode;
+
+                *cur_hnode = del_hnode->next;
+
+                eris_string_free( del_hnode->name);
+                eris_string_free( del_hnode->value);
+
+                eris_memory_free( del_hnode);
+
+                break;
+            }
+
+            cur_hnode = &((*cur_hnode)->next);
+        }
+    }
+}/// eris_http_response_del_header
+
+
+/**
+ * @Brief: Set http response body, if user is server.
+ *
+ * @Param: __http, Eris http context.
+ * @Param: __body, Body data.
+ * @Param: __size, Body data size.
+ * 
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+eris_int_t eris_http_response_set_body( eris_http_t *__http, const eris_void_t *__body, eris_size_t __size)
+{
+    eris_int_t tmp_errno = errno;
+    eris_int_t rc = 0;
+
+    if ( __http) {
+        if ( __body && (0 < __size)) {
+            eris_buffer_cleanup( &(__http->response.body), __http->log);
+
+            /** Set body data into buffer */
+            rc = eris_buffer_append( &(__http->response.body), __body, __size, __http->log);
+            if ( 0 != rc) {
+                if ( __http->log) {
+                    eris_log_dump( __http->log, ERIS_LOG_CORE, "Set body failed, errno.<%d>", errno);
+                }
+            }
+
+        } else {
+            rc = EERIS_ERROR;
+
+            if ( __http->log) {
+                eris_log_dump( __http->log, ERIS_LOG_CORE, "Input body content is invalid");
+            }
+        }
+    } else { rc = EERIS_ERROR; }
+
+    errno = tmp_errno;
+
+    return rc;
+}/// eris_http_response_set_body
+
+
+/**
+ * @Brief: Set http response body and append, if user is server.
+ *
+ * @Param: __http, Eris http context.
+ * @Param: __body, Body data.
+ * @Param: __size, Body data size.
+ * 
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+eris_int_t eris_http_response_set_body_append( eris_http_t *__http, const eris_void_t *__body, eris_size_t __size)
+{
+    eris_int_t tmp_errno = errno;
+    eris_int_t rc = 0;
+
+    if ( __http) {
+        if ( __body && (0 < __size)) {
+            /** Append body data */
+            rc = eris_buffer_append( &(__http->response.body), __body, __size, __http->log);
+            if ( 0 != rc) {
+                if ( __http->log) {
+                    eris_log_dump( __http->log, ERIS_LOG_CORE, "Set body failed, errno.<%d>", errno);
+                }
+            }
+
+        } else {
+            rc = EERIS_ERROR;
+
+            if ( __http->log) {
+                eris_log_dump( __http->log, ERIS_LOG_CORE, "Input body content is invalid");
+            }
+        }
+    } else { rc = EERIS_ERROR; }
+
+    errno = tmp_errno;
+
+    return rc;
+}/// eris_http_response_set_body_append
+
+
+/**
+ * @Brief: Get response version, if user is client.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Version value.
+ **/
+eris_http_version_t eris_http_response_get_version( const eris_http_t *__http)
+{
+    eris_http_version_t rc_version = ERIS_HTTP_V00;
+
+    if ( __http) {
+        rc_version = __http->response.version;
+    }
+
+    return rc_version;
+}/// eris_http_response_get_version
+
+
+/**
+ * @Brief: Get response status, if user is client.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: response status.
+ **/
+eris_http_status_t eris_http_response_get_status( const eris_http_t *__http)
+{
+    eris_http_status_t rc_status = ERIS_HTTP_000;
+
+    if ( __http) {
+        rc_status = __http->response.status;
+    }
+
+    return rc_status;
+}/// eris_http_response_get_status
+
+
+/**
+ * @Brief: Get response reason phrace, if user is client.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Reason phrace string.
+ **/
+const eris_string_t eris_http_response_get_reason( const eris_http_t *__http)
+{
+    if ( __http) {
+        /** Return response reason phrace */
+        return __http->response.reason;
+    }
+
+    return NULL;
+}/// eris_http_response_get_reason
+
+
+/**
+ * @Brief: Get http header name-value, if user is client.
+ *
+ * @Param: __http,  Eris http context.
+ * @Param: __name,  HTTP protocol header name.
+ * 
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+const eris_string_t eris_http_response_get_header( const eris_http_t *__http, const eris_char_t *__name)
+{
+    if ( __http && __name) {
+        eris_http_hnode_t *cur_hnode = __http->response.headers;
+
+        while ( cur_hnode) {
+            /** Found name? */
+            if ( eris_string_isequal( cur_hnode->name, __name, true)) {
+                /** Ok, Has found name-value and return */
+
+                return cur_hnode->value;
+            } else {
+                /** Goto next */
+                cur_hnode = cur_hnode->next;
+            }
+        }
+    }
+
+    return NULL;
+}/// eris_http_response_get_header
+
+
+/**
+ * @Brief: Get http response body object, if user is client
+ *
+ * @Param: __http, Eris http context.
+ * 
+ * @Return: Body buffer object.
+ **/
+const eris_buffer_t *eris_http_response_get_body( const eris_http_t *__http)
+{
+    if ( __http) {
+        /** Response body buffer */
+        return &(__http->response.body);
+    }
+
+    return NULL;
+}/// eris_http_response_get_body
+
+
+/**
+ * @Brief: Get http response body data, if user is client
+ *
+ * @Param: __http, Eris http context.
+ * 
+ * @Return: Body data.
+ **/
+const eris_void_t *eris_http_response_get_body_data( const eris_http_t *__http)
+{
+    if ( __http) {
+        /** Body buffer data */
+        return eris_buffer_data( &(__http->response.body), __http->log);
+    }
+
+    return NULL;
+}/// eris_http_response_get_body_data
+
+
+/**
+ * @Brief: Get http response body size, if user is client
+ *       : or streamed/gzipped body size.
+ *
+ * @Param: __http, Eris http context.
+ * 
+ * @Return: Body data size.
+ **/
+eris_size_t eris_http_response_get_body_size( const eris_http_t *__http)
+{
+    if ( __http) {
+        /** Streamed or file body size */
+        if ( __http->resp_stream || (0 <= __http->resp_fd) || __http->resp_meta) {
+            return __http->resp_total;
+        }
+
+        /** Gzipped body */
+        if ( __http->resp_gzip) {
+            return eris_buffer_size( &(__http->resp_zbuffer), __http->log);
+        }
+
+        /** Response body buffer */
+        return eris_buffer_size( &(__http->response.body), __http->log);
+    }
+
+    return 0;
+}/// eris_http_response_get_body_size
+
+
+/**
+ * @Brief: Clean up eris http context.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Nothing.
+ **/
+eris_void_t eris_http_cleanup( eris_http_t *__http)
+{
+    if ( __http) {
+        /** Clean up request */
+        {
+            __http->request.command = ERIS_HTTP_UNKNOW;
+
+            eris_string_free( __http->request.url);
+            __http->request.url = NULL;
+
+            __http->request.version = ERIS_HTTP_V00;
+
+            /** Release all headers nodes */
+            eris_http_hnode_t *del_hnode = __http->request.headers;
+            while ( del_hnode) {
+                __http->request.headers = __http->request.headers->next;
+
+                if ( del_hnode->name) {
+                    eris_string_free( del_hnode->name);
+                    del_hnode->name  = NULL;
+                }
+
+                if ( del_hnode->value) {
+                    eris_string_free( del_hnode->value);
+                    del_hnode->value = NULL;
+                }
+
+                del_hnode->next  = NULL;
+
+                eris_memory_free( del_hnode);
+
+                /** Goto next */
+                del_hnode = __http->request.headers;
+            }
+
+            eris_string_free( __http->request.query);
+            __http->request.query = NULL;
+
+            eris_buffer_free( &(__http->request.body));
+
+            eris_http_body_unspool( __http);
+        }/// End: clean up request
+
+        /** Clean up response */
+        {
+            __http->response.version = ERIS_HTTP_V00;
+            __http->response.status  = ERIS_HTTP_000;
+
+            eris_string_free( __http->response.reason);
+            __http->response.reason = NULL;
+
+            /** Release all headers nodes */
+            eris_http_hnode_t *del_hnode = __http->response.headers;
+            while ( del_hnode) {
+                __http->response.headers = __http->response.headers->next;
+
+                if ( del_hnode->name) {
+                    eris_string_free( del_hnode->name);
+                    del_hnode->name  = NULL;
+                }
+
+                if ( del_hnode->value) {
+                    eris_string_free( del_hnode->value);
+                    del_hnode->value = NULL;
+                }
+
+                del_hnode->next  = NULL;
+
+                eris_memory_free( del_hnode);
+
+                /** Goto next */
+                del_hnode = __http->response.headers;
+            }
+
+            eris_buffer_free( &(__http->response.body));
+        }/// End: clean up response
+
+        __http->resp_outcb    = NULL;
+        __http->resp_filecb   = NULL;
+        __http->resp_arg      = NULL;
+        __http->resp_stream   = false;
+        __http->resp_chunked  = false;
+        __http->resp_finished = false;
+        __http->resp_total    = 0;
+        __http->resp_base     = false;
+        __http->resp_keepalive= false;
+        __http->resp_gzip     = false;
+
+        /** Deflate output is kept to next, if it is not large */
+        if ( __http->attrs.body_cache_size < __http->resp_zbuffer.alloc) {
+            eris_buffer_free( &(__http->resp_zbuffer));
+        }
+
+        eris_http_response_file_close( __http);
+
+        /** Cleanup header/body buffer */
+        eris_buffer_cleanup( &(__http->hbuffer), NULL);
+        eris_buffer_cleanup( &(__http->bbuffer), NULL);
+
+        __http->chunk_state    = ERIS_HTTP_CHUNKED;
+        __http->chunked        = false;
+        __http->chunked_end    = false;
+        __http->chunk_size     = 0;
+        __http->tmp_chunk_size = 0;
+        __http->body_pending   = false;
+        __http->body_window    = false;
+        __http->body_remain    = 0;
+        __http->body_total     = 0;
+    }
+}/// eris_http_cleanup
+
+
+/**
+ * @Brief: Clean up eris http request handler.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Nothing.
+ **/
+eris_void_t eris_http_cleanup_request( eris_http_t *__http)
+{
+    if ( __http) {
+        __http->request.shake   = false;
+        __http->request.command = ERIS_HTTP_UNKNOW;
+
+        eris_string_free( __http->request.url);
+        __http->request.url = NULL;
+
+        __http->request.version = ERIS_HTTP_V00;
+
+        /** Release all headers nodes */
+        eris_http_hnode_t *del_hnode = __http->request.headers;
+        while ( del_hnode) {
+            del_hnode->next  = NULL;
+            __http->request.headers = __http->request.headers->next;
+
+            if ( del_hnode->name) {
+                eris_string_free( del_hnode->name);
+                del_hnode->name = NULL;
+            }
+
+            if ( del_hnode->value) {
+                eris_string_free( del_hnode->value);
+                del_hnode->value = NULL;
+            }
+
+            eris_memory_free( del_hnode);
+
+            /** Goto next */
+            del_hnode = __http->request.headers;
+        }
+
+        eris_string_free( __http->request.query);
+        __http->request.query = NULL;
+
+        eris_buffer_free( &(__http->request.body));
+
+        eris_http_body_unspool( __http);
+    }
+}/// eris_http_cleanup_request
+
+
+/**
+ * @Brief: Clean up eris http response handler.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Nothing.
+ **/
+eris_void_t eris_http_cleanup_response( eris_http_t *__http)
+{
+    if ( __http) {
+        /** Clean up response */
+        __http->response.version = ERIS_HTTP_V00;
+        __http->response.status  = ERIS_HTTP_000;
+
+        eris_string_free( __http->response.reason);
+        __http->response.reason = NULL;
+
+        /** Release all headers nodes */
+        eris_http_hnode_t *del_hnode = __http->response.headers;
+        while ( del_hnode) {
+            __http->response.headers = __http->response.headers->next;
+
+            if ( del_hnode->name) {
+                eris_string_free( del_hnode->name);
+                del_hnode->name  = NULL;
+            }
+
+            if ( del_hnode->value) {
+                eris_string_free( del_hnode->value);
+                del_hnode->value = NULL;
+            }
+
+            del_hnode->next  = NULL;
+
+            eris_memory_free( del_hnode);
+
+            /** Goto next */
+            del_hnode = __http->response.headers;
+        }
+
+        eris_buffer_free( &(__http->response.body));
+
+        __http->resp_outcb    = NULL;
+        __http->resp_filecb   = NULL;
+        __http->resp_arg      = NULL;
+        __http->resp_stream   = false;
+        __http->resp_chunked  = false;
+        __http->resp_finished = false;
+        __http->resp_total    = 0;
+        __http->resp_base     = false;
+        __http->resp_keepalive= false;
+        __http->resp_gzip     = false;
+
+        /** Deflate output is kept to next, if it is not large */
+        if ( __http->attrs.body_cache_size < __http->resp_zbuffer.alloc) {
+            eris_buffer_free( &(__http->resp_zbuffer));
+        }
+
+        eris_http_response_file_close( __http);
+    }
+}/// eris_http_cleanup_response
+
+
+/**
+ * @Brief: Check status is valid.
+ *
+ * @Parma: __status, Input status code.
+ *
+ * @Return: Is valid is true, Other is false.
+ **/
+eris_bool_t eris_http_status_valid( eris_int_t __status)
+{
+    return eris_http_status_in_table( __status) ? true : false;
+}/// eris_eris_http_status_valid
+
+
+/**
+ * @Brief: Get status string
+ *
+ * @Param: __status, Status code.
+ *
+ * @Return: status string.
+ **/
+const eris_char_t *eris_http_status_string( eris_int_t __status)
+{
+    if ( eris_http_status_in_table( __status)) {
+        return eris_http_status_table[ __status].status_s;
+    }
+
+    return NULL;
+}/// eris_http_status_reason_phrace
+
+
+/**
+ * @Brief: Get status reason phrace.
+ *
+ * @Param: __status, Status code.
+ *
+ * @Return: reason phrace string.
+ **/
+const eris_char_t *eris_http_status_reason_phrace( eris_int_t __status)
+{
+    if ( eris_http_status_in_table( __status)) {
+        return eris_http_status_table[ __status].reason_phrace;
+    }
+
+    return NULL;
+}/// eris_http_status_reason_phrace
+
+
+/**
+ * @Brief: Destroy eris http context.
+ *
+ * @Param: __http, Eris http context.
+ *
+ * @Return: Nothing.
+ **/
+eris_void_t eris_http_destroy( eris_http_t *__http)
+{
+    if ( __http) {
+        eris_http_cleanup( __http);
+
+        /** Destroy request/response buffer */
+        eris_buffer_destroy( &(__http->request.body));
+        eris_buffer_destroy( &(__http->response.body));
+
+        /** Destroy header/body buffer */
+        eris_buffer_destroy( &(__http->hbuffer));
+        eris_buffer_destroy( &(__http->bbuffer));
+
+        /** Destroy deflate stream and output */
+        eris_buffer_destroy( &(__http->resp_zbuffer));
+
+#if (ERIS_HAVE_ZLIB_H)
+        if ( __http->resp_zstream) {
+            (eris_none_t )deflateEnd( (z_stream *)__http->resp_zstream);
+
+            eris_memory_free( __http->resp_zstream);
+            __http->resp_zstream = NULL;
         }
-    } else { rc = EERIS_ERROR; }
+#endif
 
-    errno = tmp_errno;
+        eris_string_free( __http->resp_server);
+        __http->resp_server = NULL;
 
-    return rc;
-}/// eris_http_response_set_header
+        {
+            __http->log   = NULL;
+        }
+    }
+}/// eris_http_destroy
 
 
 /**
- * @Brief: Set http response body, if user is server.
+ * @Brief: Write request body data to spool temp file, create it at first.
  *
  * @Param: __http, Eris http context.
- * @Param: __body, Body data.
+ * @Param: __data, Body data.
  * @Param: __size, Body data size.
- * 
+ *
  * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-eris_int_t eris_http_response_set_body( eris_http_t *__http, const eris_void_t *__body, eris_size_t __size)
+static eris_int_t eris_http_body_spool( eris_http_t *__http, const eris_void_t *__data, eris_size_t __size)
 {
     eris_int_t tmp_errno = errno;
     eris_int_t rc = 0;
 
-    if ( __http) {
-        if ( __body && (0 < __size)) {
-            eris_buffer_cleanup( &(__http->response.body), __http->log);
+    eris_files_t body_file; {
+        body_file.name   = NULL;
+        body_file.fd     = __http->body_fd;
+        body_file.offset = __http->body_fd_size;
+        body_file.log    = __http->log;
+    }
 
-            /** Set body data into buffer */
-            rc = eris_buffer_append( &(__http->response.body), __body, __size, __http->log);
-            if ( 0 != rc) {
-                if ( __http->log) {
-                    eris_log_dump( __http->log, ERIS_LOG_CORE, "Set body failed, errno.<%d>", errno);
-                }
+    if ( 0 > __http->body_fd) {
+        /** Unique of process and http context, it is unlinked at once */
+        rc = eris_string_printf( &(body_file.name), "%s/.erishttp.body.%d.%p", 
+                                 (__http->attrs.body_spool_path ? __http->attrs.body_spool_path : "/tmp"),
+                                 eris_get_pid(),
+                                 __http);
+        if ( 0 == rc) {
+            rc = eris_files_create_tf( &body_file, false, S_IRUSR | S_IWUSR);
+            if ( 0 == rc) {
+                __http->body_fd      = body_file.fd;
+                __http->body_fd_size = 0;
             }
+        }
+
+        eris_string_free( body_file.name);
+        eris_string_init( body_file.name);
+    }
+
+    if ( (0 == rc) && (0 < __size)) {
+        eris_ssize_t w_size = eris_files_write( &body_file, (const eris_uchar_t *)__data, __size, (eris_off_t )__http->body_fd_size);
+        if ( (eris_ssize_t )__size == w_size) {
+            __http->body_fd_size += __size;
 
         } else {
             rc = EERIS_ERROR;
 
             if ( __http->log) {
-                eris_log_dump( __http->log, ERIS_LOG_CORE, "Input body content is invalid");
+                eris_log_dump( __http->log, ERIS_LOG_CORE, "Write spool body file failed, errno.<%d>", errno);
             }
         }
-    } else { rc = EERIS_ERROR; }
+    }
 
     errno = tmp_errno;
 
     return rc;
-}/// eris_http_response_set_body
+}/// eris_http_body_spool
 
 
 /**
- * @Brief: Set http response body and append, if user is server.
+ * @Brief: Release spool temp file and mapping of request body.
  *
  * @Param: __http, Eris http context.
- * @Param: __body, Body data.
- * @Param: __size, Body data size.
- * 
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t eris_http_body_unspool( eris_http_t *__http)
+{
+    if ( __http->body_map) {
+        munmap( __http->body_map, __http->body_fd_size);
+
+        __http->body_map = NULL;
+    }
+
+    if ( 0 <= __http->body_fd) {
+        close( __http->body_fd);
+
+        __http->body_fd = -1;
+    }
+
+    __http->body_fd_size = 0;
+}/// eris_http_body_unspool
+
+
+/**
+ * @Brief: Make http-response status line and headers into header buffer.
+ *
+ * @Param: __http, Eris http context.
+ *
  * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-eris_int_t eris_http_response_set_body_append( eris_http_t *__http, const eris_void_t *__body, eris_size_t __size)
+static eris_int_t eris_http_response_pack_head( eris_http_t *__http)
 {
-    eris_int_t tmp_errno = errno;
     eris_int_t rc = 0;
 
-    if ( __http) {
-        if ( __body && (0 < __size)) {
-            /** Append body data */
-            rc = eris_buffer_append( &(__http->response.body), __body, __size, __http->log);
-            if ( 0 != rc) {
-                if ( __http->log) {
-                    eris_log_dump( __http->log, ERIS_LOG_CORE, "Set body failed, errno.<%d>", errno);
+    /** Clean up header/body buffer */
+    eris_buffer_cleanup( &(__http->hbuffer), NULL);
+
+    /** Status line of table index, default HTTP/1.0 */
+    eris_int_t v_idx = 0;
+    switch ( __http->response.version) {
+        case ERIS_HTTP_V11 : { v_idx = 1; } break;
+        case ERIS_HTTP_V09 : { v_idx = 2; } break;
+        case ERIS_HTTP_V10 :
+        default :
+            {
+                v_idx = 0;
+
+                __http->request.version = ERIS_HTTP_V10;
+            } break;
+    }/// switch
+
+    if ( (ERIS_HTTP_000 != __http->response.status) && eris_http_status_in_table( __http->response.status)) {
+        const eris_http_status_table_t *status_elem = &(eris_http_status_table[ __http->response.status]);
+
+        eris_size_t reason_size = eris_string_size( __http->response.reason);
+        if ( (0 == reason_size) || 
+             ((reason_size == strlen( status_elem->reason_phrace)) && 
+              (0 == memcmp( __http->response.reason, status_elem->reason_phrace, reason_size))) ) {
+            /** Preformatted status line */
+            rc = eris_buffer_append( &(__http->hbuffer), status_elem->lines[ v_idx], status_elem->sizes[ v_idx], __http->log);
+
+        } else {
+            /** Version, status and specify reason phrace */
+            rc = eris_buffer_append( &(__http->hbuffer), status_elem->lines[ v_idx], ERIS_HTTP_VERSION_SIZE + 5, __http->log);
+            if ( 0 == rc) {
+                rc = eris_buffer_append( &(__http->hbuffer), __http->response.reason, reason_size, __http->log);
+                if ( 0 == rc) {
+                    rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_CRLF, ERIS_HTTP_CRLF_SIZE, __http->log);
                 }
             }
+        }
+    } else {
+        rc = EERIS_ERROR;
 
-        } else {
-            rc = EERIS_ERROR;
+        if ( __http->log) {
+               eris_log_dump( __http->log, ERIS_LOG_CORE, "Status value is invalid.");
+        }
+    }
 
-            if ( __http->log) {
-                eris_log_dump( __http->log, ERIS_LOG_CORE, "Input body content is invalid");
+    /** Base headers is replaced by same name headers */
+    eris_bool_t has_server = false;
+    eris_bool_t has_date   = false;
+    eris_bool_t has_conn   = false;
+
+    /** Append all headers */
+    if ( 0 == rc) {
+        eris_http_hnode_t *cur_hnode = __http->response.headers;
+
+        for ( ;cur_hnode; cur_hnode = cur_hnode->next) {
+            if ( __http->resp_base) {
+                if ( eris_string_isequal( cur_hnode->name, "Server", true)) {
+                    has_server = true;
+
+                } else if ( eris_string_isequal( cur_hnode->name, "Date", true)) {
+                    has_date = true;
+
+                } else if ( eris_string_isequal( cur_hnode->name, "Connection", true)) {
+                    has_conn = true;
+                }
+            }
+
+            /** Append name */
+            rc = eris_buffer_append( &(__http->hbuffer), cur_hnode->name, eris_string_size( cur_hnode->name), __http->log);
+            if ( 0 == rc) {
+                rc = eris_buffer_append( &(__http->hbuffer), ": ", 2, __http->log);
+                if ( 0 == rc) {
+                    /** Append value */
+                    rc = eris_buffer_append( &(__http->hbuffer), cur_hnode->value, eris_string_size( cur_hnode->value), __http->log);
+                    if ( 0 == rc) {
+                        rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_CRLF, ERIS_HTTP_CRLF_SIZE, __http->log);
+                    }
+                }
             }
+
+            /** Heppen error */
+            if ( 0 != rc) { break; }
         }
-    } else { rc = EERIS_ERROR; }
 
-    errno = tmp_errno;
+        cur_hnode = NULL;
+    }
 
-    return rc;
-}/// eris_http_response_set_body_append
+    /** Append preformatted base headers */
+    if ( (0 == rc) && __http->resp_base) {
+        if ( !has_server && __http->resp_server) {
+            rc = eris_buffer_append( &(__http->hbuffer), __http->resp_server, eris_string_size( __http->resp_server), __http->log);
+        }
 
+        if ( (0 == rc) && !has_date) {
+            rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_DATE_S, ERIS_HTTP_DATE_SIZE, __http->log);
+            if ( 0 == rc) {
+                rc = eris_buffer_append( &(__http->hbuffer), eris_time_gmt_cached(), ERIS_TIME_GMT_SIZE, __http->log);
+                if ( 0 == rc) {
+                    rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_CRLF, ERIS_HTTP_CRLF_SIZE, __http->log);
+                }
+            }
+        }
 
-/**
- * @Brief: Get response version, if user is client.
- *
- * @Param: __http, Eris http context.
- *
- * @Return: Version value.
- **/
-eris_http_version_t eris_http_response_get_version( const eris_http_t *__http)
-{
-    eris_http_version_t rc_version = ERIS_HTTP_V00;
+        if ( (0 == rc) && !has_conn) {
+            if ( __http->resp_keepalive) {
+                rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_CONN_KEEPALIVE_S, ERIS_HTTP_CONN_KEEPALIVE_SIZE, __http->log);
 
-    if ( __http) {
-        rc_version = __http->response.version;
+            } else {
+                rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_CONN_CLOSE_S, ERIS_HTTP_CONN_CLOSE_SIZE, __http->log);
+            }
+        }
     }
 
-    return rc_version;
-}/// eris_http_response_get_version
+    /** Append CRLF_CRLF header end */
+    if ( 0 == rc) {
+        rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_CRLF, ERIS_HTTP_CRLF_SIZE, __http->log);
+    }
+
+    return rc;
+}/// eris_http_response_pack_head
 
 
 /**
- * @Brief: Get response status, if user is client.
+ * @Brief: Send head of streaming response, and body set before is the first data.
  *
  * @Param: __http, Eris http context.
  *
- * @Return: response status.
+ * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-eris_http_status_t eris_http_response_get_status( const eris_http_t *__http)
+static eris_int_t eris_http_response_stream_begin( eris_http_t *__http)
 {
-    eris_http_status_t rc_status = ERIS_HTTP_000;
+    eris_int_t rc = 0;
 
-    if ( __http) {
-        rc_status = __http->response.status;
+    if ( __http->resp_outcb) {
+        if ( (ERIS_HTTP_000 == __http->response.status) || !eris_http_status_valid( __http->response.status)) {
+            __http->response.status = ERIS_HTTP_200;
+        }
+
+        /** Chunked is HTTP/1.1, and HTTP/1.0 body is end of connection close */
+        if ( ERIS_HTTP_V11 == __http->request.version) {
+            __http->response.version = ERIS_HTTP_V11;
+            __http->resp_chunked     = true;
+
+            rc = eris_http_response_set_header( __http, "Transfer-Encoding", "chunked");
+        } else {
+            __http->response.version = ERIS_HTTP_V10;
+            __http->resp_chunked     = false;
+        }
+
+        /** Connection is closed after streaming of any version, client does not reuse it */
+        __http->resp_keepalive = false;
+
+        if ( (0 == rc) && (!__http->resp_base || eris_http_response_get_header( __http, "Connection"))) {
+            rc = eris_http_response_set_header( __http, "Connection", "close");
+        }
+
+        /** Gzip is decided before head is sent */
+        if ( (0 == rc) && eris_http_response_gzip_begin( __http)) {
+            rc = eris_http_response_set_header( __http, "Content-Encoding", "gzip");
+            if ( 0 == rc) {
+                __http->resp_gzip = true;
+            }
+        }
+
+        /** Content-Length is unknown */
+        if ( 0 == rc) {
+            eris_http_response_del_header( __http, "Content-Length");
+
+            rc = eris_http_response_pack_head( __http);
+        }
+
+        if ( 0 == rc) {
+            rc = __http->resp_outcb( &(__http->hbuffer), __http->hbuffer.size, __http->resp_arg, __http->log);
+            if ( 0 == rc) {
+                __http->resp_stream = true;
+
+                if ( (0 < __http->response.body.size) && (ERIS_HTTP_HEAD != __http->request.command)) {
+                    rc = eris_http_response_stream_out( __http, __http->response.body.data, __http->response.body.size);
+                }
+
+                eris_buffer_cleanup( &(__http->response.body), NULL);
+            } else {
+                if ( __http->log) {
+                    eris_log_dump( __http->log, ERIS_LOG_CORE, "Do output header failed, errno.<%d>", errno);
+                }
+            }
+        }
+
+        if ( 0 != rc) {
+            rc = EERIS_ERROR;
+
+            __http->resp_finished = true;
+        }
+    } else {
+        rc = EERIS_ERROR;
+
+        if ( __http->log) {
+            eris_log_dump( __http->log, ERIS_LOG_CORE, "Unspecify callback, please set it.");
+        }
     }
 
-    return rc_status;
-}/// eris_http_response_get_status
+    return rc;
+}/// eris_http_response_stream_begin
 
 
 /**
- * @Brief: Get response reason phrace, if user is client.
+ * @Brief: Send a data of streaming response, it is gzipped when response is.
  *
  * @Param: __http, Eris http context.
+ * @Param: __data, Body data.
+ * @Param: __size, Body data size.
  *
- * @Return: Reason phrace string.
+ * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-const eris_string_t eris_http_response_get_reason( const eris_http_t *__http)
+static eris_int_t eris_http_response_stream_out( eris_http_t *__http, const eris_void_t *__data, eris_size_t __size)
 {
-    if ( __http) {
-        /** Return response reason phrace */
-        return __http->response.reason;
-    }
+    eris_int_t rc = 0;
 
-    return NULL;
-}/// eris_http_response_get_reason
+    if ( __http->resp_gzip) {
+        /** Sync flush, so client gets data of every write */
+        rc = eris_http_response_gzip_deflate( __http, __data, __size, false);
+        if ( 0 == rc) {
+            if ( 0 < __http->resp_zbuffer.size) {
+                rc = eris_http_response_stream_send( __http, __http->resp_zbuffer.data, __http->resp_zbuffer.size);
+            }
+        } else { __http->resp_finished = true; }
+
+    } else { rc = eris_http_response_stream_send( __http, __data, __size); }
+
+    return rc;
+}/// eris_http_response_stream_out
 
 
 /**
- * @Brief: Get http header name-value, if user is client.
+ * @Brief: Send a raw data of streaming response, it is a chunk of HTTP/1.1.
+ *
+ * @Param: __http, Eris http context.
+ * @Param: __data, Body data.
+ * @Param: __size, Body data size.
  *
- * @Param: __http,  Eris http context.
- * @Param: __name,  HTTP protocol header name.
- * 
  * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-const eris_string_t eris_http_response_get_header( const eris_http_t *__http, const eris_char_t *__name)
+static eris_int_t eris_http_response_stream_send( eris_http_t *__http, const eris_void_t *__data, eris_size_t __size)
 {
-    if ( __http && __name) {
-        eris_http_hnode_t *cur_hnode = __http->response.headers;
+    eris_int_t rc = 0;
 
-        while ( cur_hnode) {
-            /** Found name? */
-            if ( eris_string_isequal( cur_hnode->name, __name, true)) {
-                /** Ok, Has found name-value and return */
+    /** Wrap data, not copy it */
+    eris_buffer_t data_buffer; {
+        data_buffer.alloc = __size;
+        data_buffer.size  = __size;
+        data_buffer.data  = (eris_uchar_t *)__data;
+    }
 
-                return cur_hnode->value;
+    if ( __http->resp_chunked) {
+        eris_char_t chunk_size_s[ 32] = {0};
+        eris_int_t  chunk_size_n = snprintf( chunk_size_s, sizeof( chunk_size_s), "%lx"ERIS_HTTP_CRLF, (unsigned long )__size);
+
+        eris_buffer_cleanup( &(__http->hbuffer), NULL);
+
+        rc = eris_buffer_append( &(__http->hbuffer), chunk_size_s, chunk_size_n, __http->log);
+        if ( 0 == rc) {
+            if ( __size <= __http->attrs.body_cache_size) {
+                /** Small chunk is merged to one output */
+                rc = eris_buffer_append( &(__http->hbuffer), __data, __size, __http->log);
+                if ( 0 == rc) {
+                    rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_CRLF, ERIS_HTTP_CRLF_SIZE, __http->log);
+                    if ( 0 == rc) {
+                        rc = __http->resp_outcb( &(__http->hbuffer), __http->hbuffer.size, __http->resp_arg, __http->log);
+                    }
+                }
             } else {
-                /** Goto next */
-                cur_hnode = cur_hnode->next;
+                rc = __http->resp_outcb( &(__http->hbuffer), __http->hbuffer.size, __http->resp_arg, __http->log);
+                if ( 0 == rc) {
+                    rc = __http->resp_outcb( &data_buffer, __size, __http->resp_arg, __http->log);
+                    if ( 0 == rc) {
+                        eris_buffer_cleanup( &(__http->hbuffer), NULL);
+
+                        rc = eris_buffer_append( &(__http->hbuffer), ERIS_HTTP_CRLF, ERIS_HTTP_CRLF_SIZE, __http->log);
+                        if ( 0 == rc) {
+                            rc = __http->resp_outcb( &(__http->hbuffer), __http->hbuffer.size, __http->resp_arg, __http->log);
+                        }
+                    }
+                }
             }
         }
-    }
+    } else { rc = __http->resp_outcb( &data_buffer, __size, __http->resp_arg, __http->log); }
 
-    return NULL;
-}/// eris_http_response_get_header
+    if ( 0 == rc) {
+        __http->resp_total += __size;
 
+    } else {
+        rc = EERIS_ERROR;
 
-/**
- * @Brief: Get http response body object, if user is client
- *
- * @Param: __http, Eris http context.
- * 
- * @Return: Body buffer object.
- **/
-const eris_buffer_t *eris_http_response_get_body( const eris_http_t *__http)
-{
-    if ( __http) {
-        /** Response body buffer */
-        return &(__http->response.body);
+        /** Client is gone, so nothing is sent again */
+        __http->resp_finished = true;
+
+        if ( __http->log) {
+            eris_log_dump( __http->log, ERIS_LOG_CORE, "Do output body failed, errno.<%d>", errno);
+        }
     }
 
-    return NULL;
-}/// eris_http_response_get_body
+    return rc;
+}/// eris_http_response_stream_send
 
 
 /**
- * @Brief: Get http response body data, if user is client
+ * @Brief: Close file body and forget ranges.
  *
  * @Param: __http, Eris http context.
- * 
- * @Return: Body data.
- **/
-const eris_void_t *eris_http_response_get_body_data( const eris_http_t *__http)
-{
-    if ( __http) {
-        /** Body buffer data */
-        return eris_buffer_data( &(__http->response.body), __http->log);
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t eris_http_response_file_close( eris_http_t *__http)
+{
+    if ( 0 <= __http->resp_fd) {
+        close( __http->resp_fd);
+
+        __http->resp_fd = -1;
     }
 
-    return NULL;
-}/// eris_http_response_get_body_data
+    __http->resp_fd_size  = 0;
+    __http->resp_meta     = false;
+    __http->resp_ranges_n = 0;
+    __http->resp_boundary[ 0] = '\0';
+
+    eris_string_free( __http->resp_part_type);
+    __http->resp_part_type = NULL;
+}/// eris_http_response_file_close
 
 
 /**
- * @Brief: Get http response body size, if user is client
+ * @Brief: Make head of a part in multipart/byteranges.
  *
  * @Param: __http, Eris http context.
- * 
- * @Return: Body data size.
+ * @Param: __i,    Range index.
+ * @Param: __buf,  Output buffer.
+ * @Param: __size, Output buffer size.
+ *
+ * @Return: Part head size.
  **/
-eris_size_t eris_http_response_get_body_size( const eris_http_t *__http)
+static eris_int_t eris_http_response_part_head( const eris_http_t *__http, eris_int_t __i, eris_char_t *__buf, eris_size_t __size)
 {
-    if ( __http) {
-        /** Response body buffer */
-        return eris_buffer_size( &(__http->response.body), __http->log);
-    }
+    const eris_http_range_t *p_range = &(__http->resp_ranges[ __i]);
 
-    return 0;
-}/// eris_http_response_get_body_size
+    eris_int_t n = snprintf( __buf, __size, ERIS_HTTP_CRLF"--%s"ERIS_HTTP_CRLF
+                                            "Content-Type: %s"ERIS_HTTP_CRLF
+                                            "Content-Range: bytes %lu-%lu/%lu"ERIS_HTTP_CRLF ERIS_HTTP_CRLF,
+                                            __http->resp_boundary,
+                                            __http->resp_part_type,
+                                            (eris_ulong_t )p_range->offset,
+                                            (eris_ulong_t )(p_range->offset + p_range->size - 1),
+                                            (eris_ulong_t )__http->resp_fd_size);
+
+    return ((0 < n) && ((eris_size_t )n < __size)) ? n : 0;
+}/// eris_http_response_part_head
 
 
 /**
- * @Brief: Clean up eris http context.
+ * @Brief: Send file data of range by file callback, or read and output it.
  *
- * @Param: __http, Eris http context.
+ * @Param: __http,   Eris http context.
+ * @Param: __outcb,  Output callback.
+ * @Param: __arg,    Output callback argument.
+ * @Param: __offset, Range first byte.
+ * @Param: __size,   Range size.
  *
- * @Return: Nothing.
+ * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-eris_void_t eris_http_cleanup( eris_http_t *__http)
+static eris_int_t eris_http_response_file_send( eris_http_t *__http, eris_http_cb_t __outcb, eris_arg_t __arg, eris_off_t __offset, eris_size_t __size)
 {
-    if ( __http) {
-        /** Clean up request */
-        {
-            __http->request.command = ERIS_HTTP_UNKNOW;
+    eris_int_t rc = 0;
 
-            eris_string_free( __http->request.url);
-            __http->request.url = NULL;
+    if ( __http->resp_filecb) {
+        /** Zero-copy */
+        rc = __http->resp_filecb( __http->resp_fd, __offset, __size, __arg, __http->log);
 
-            __http->request.version = ERIS_HTTP_V00;
+    } else {
+        eris_uchar_t r_cache[ 8192];
 
-            /** Release all headers nodes */
-            eris_http_hnode_t *del_hnode = __http->request.headers;
-            while ( del_hnode) {
-                __http->request.headers = __http->request.headers->next;
+        while ( (0 == rc) && (0 < __size)) {
+            eris_ssize_t r_size = pread( __http->resp_fd, r_cache, (__size < sizeof( r_cache)) ? __size : sizeof( r_cache), __offset);
+            if ( 0 < r_size) {
+                eris_buffer_cleanup( &(__http->hbuffer), __http->log);
 
-                if ( del_hnode->name) {
-                    eris_string_free( del_hnode->name);
-                    del_hnode->name  = NULL;
+                rc = eris_buffer_append( &(__http->hbuffer), r_cache, r_size, __http->log);
+                if ( 0 == rc) {
+                    rc = __outcb( &(__http->hbuffer), r_size, __arg, __http->log);
                 }
 
-                if ( del_hnode->value) {
-                    eris_string_free( del_hnode->value);
-                    del_hnode->value = NULL;
-                }
+                __offset += r_size;
+                __size   -= r_size;
+            } else if ( (0 > r_size) && (EINTR == errno)) {
+                continue;
 
-                del_hnode->next  = NULL;
+            } else { rc = EERIS_ERROR; }
+        }
+    }
 
-                eris_memory_free( del_hnode);
+    return (0 == rc) ? 0 : EERIS_ERROR;
+}/// eris_http_response_file_send
 
-                /** Goto next */
-                del_hnode = __http->request.headers;
-            }
 
-            eris_string_free( __http->request.query);
-            __http->request.query = NULL;
+/**
+ * @Brief: Send file body, whole or all ranges.
+ *
+ * @Param: __http,  Eris http context.
+ * @Param: __outcb, Output callback.
+ * @Param: __arg,   Output callback argument.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+static eris_int_t eris_http_response_file_out( eris_http_t *__http, eris_http_cb_t __outcb, eris_arg_t __arg)
+{
+    eris_int_t rc = 0;
 
-            eris_buffer_free( &(__http->request.body));
-        }/// End: clean up request
+    if ( 0 == __http->resp_ranges_n) {
+        rc = eris_http_response_file_send( __http, __outcb, __arg, 0, __http->resp_fd_size);
 
-        /** Clean up response */
-        {
-            __http->response.version = ERIS_HTTP_V00;
-            __http->response.status  = ERIS_HTTP_000;
+    } else if ( 1 == __http->resp_ranges_n) {
+        rc = eris_http_response_file_send( __http, __outcb, __arg, __http->resp_ranges[ 0].offset, __http->resp_ranges[ 0].size);
 
-            eris_string_free( __http->response.reason);
-            __http->response.reason = NULL;
+    } else {
+        eris_int_t  i = 0;
+        eris_char_t part_head[ 256];
 
-            /** Release all headers nodes */
-            eris_http_hnode_t *del_hnode = __http->response.headers;
-            while ( del_hnode) {
-                __http->response.headers = __http->response.headers->next;
+        for ( i = 0; (0 == rc) && (i < __http->resp_ranges_n); i++) {
+            eris_int_t n = eris_http_response_part_head( __http, i, part_head, sizeof( part_head));
 
-                if ( del_hnode->name) {
-                    eris_string_free( del_hnode->name);
-                    del_hnode->name  = NULL;
-                }
+            eris_buffer_cleanup( &(__http->hbuffer), __http->log);
 
-                if ( del_hnode->value) {
-                    eris_string_free( del_hnode->value);
-                    del_hnode->value = NULL;
+            rc = eris_buffer_append( &(__http->hbuffer), part_head, n, __http->log);
+            if ( 0 == rc) {
+                rc = __outcb( &(__http->hbuffer), n, __arg, __http->log);
+                if ( 0 == rc) {
+                    rc = eris_http_response_file_send( __http, __outcb, __arg, __http->resp_ranges[ i].offset, __http->resp_ranges[ i].size);
                 }
-
-                del_hnode->next  = NULL;
-
-                eris_memory_free( del_hnode);
-
-                /** Goto next */
-                del_hnode = __http->response.headers;
             }
+        }
 
-            eris_buffer_free( &(__http->response.body));
-        }/// End: clean up response
+        if ( 0 == rc) {
+            eris_int_t n = snprintf( part_head, sizeof( part_head), ERIS_HTTP_CRLF"--%s--"ERIS_HTTP_CRLF, __http->resp_boundary);
 
-        /** Cleanup header/body buffer */
-        eris_buffer_cleanup( &(__http->hbuffer), NULL);
-        eris_buffer_cleanup( &(__http->bbuffer), NULL);
+            eris_buffer_cleanup( &(__http->hbuffer), __http->log);
 
-        __http->chunk_state    = ERIS_HTTP_CHUNKED;
-        __http->chunked        = false;
-        __http->chunked_end    = false;
-        __http->chunk_size     = 0;
-        __http->tmp_chunk_size = 0;
+            rc = eris_buffer_append( &(__http->hbuffer), part_head, n, __http->log);
+            if ( 0 == rc) {
+                rc = __outcb( &(__http->hbuffer), n, __arg, __http->log);
+            }
+        }
     }
-}/// eris_http_cleanup
+
+    return (0 == rc) ? 0 : EERIS_ERROR;
+}/// eris_http_response_file_out
 
 
 /**
- * @Brief: Clean up eris http request handler.
+ * @Brief: Client accepts gzip content-coding in Accept-Encoding value,
+ *       : gzip is first and "*" is next, q=0 is not acceptable.
  *
- * @Param: __http, Eris http context.
+ * @Param: __accept, Accept-Encoding header value.
  *
- * @Return: Nothing.
+ * @Return: Acceptable is true, Other is false.
  **/
-eris_void_t eris_http_cleanup_request( eris_http_t *__http)
+static eris_bool_t eris_http_accept_gzip( const eris_char_t *__accept)
 {
-    if ( __http) {
-        __http->request.shake   = false;
-        __http->request.command = ERIS_HTTP_UNKNOW;
+    eris_int_t gzip_q = -1;    /** -1 is unlisted */
+    eris_int_t any_q  = -1;
 
-        eris_string_free( __http->request.url);
-        __http->request.url = NULL;
+    const eris_char_t *p_accept = __accept;
+    while ( p_accept && *p_accept) {
+        /** Coding name */
+        p_accept += strspn( p_accept, " \t,");
 
-        __http->request.version = ERIS_HTTP_V00;
+        const eris_char_t *p_name = p_accept;
+        eris_size_t        name_n = strcspn( p_accept, " \t,;");
 
-        /** Release all headers nodes */
-        eris_http_hnode_t *del_hnode = __http->request.headers;
-        while ( del_hnode) {
-            del_hnode->next  = NULL;
-            __http->request.headers = __http->request.headers->next;
+        /** Parameters to end of coding */
+        const eris_char_t *p_end = p_accept + strcspn( p_accept, ",");
+        eris_int_t         q     = 1;
 
-            if ( del_hnode->name) {
-                eris_string_free( del_hnode->name);
-                del_hnode->name = NULL;
-            }
+        for ( p_accept += name_n; p_accept < p_end; p_accept++) {
+            if ( (('q' == *p_accept) || ('Q' == *p_accept)) && ('=' == p_accept[ 1])) {
+                const eris_char_t *p_qvalue = p_accept + 2;
 
-            if ( del_hnode->value) {
-                eris_string_free( del_hnode->value);
-                del_hnode->value = NULL;
+                /** All zero value, eg: 0, 0.0, 0.000 */
+                if ( strspn( p_qvalue, "0.") >= strcspn( p_qvalue, " \t;,")) { q = 0; }
             }
-
-            eris_memory_free( del_hnode);
-
-            /** Goto next */
-            del_hnode = __http->request.headers;
         }
 
-        eris_string_free( __http->request.query);
-        __http->request.query = NULL;
+        if ( ((4 == name_n) && (0 == strncasecmp( p_name, "gzip", 4))) ||
+             ((6 == name_n) && (0 == strncasecmp( p_name, "x-gzip", 6))) ) {
+            gzip_q = q;
 
-        eris_buffer_free( &(__http->request.body));
+        } else if ( (1 == name_n) && ('*' == *p_name)) {
+            any_q = q;
+        }
     }
-}/// eris_http_cleanup_request
+
+    return (0 <= gzip_q) ? (1 == gzip_q) : (1 == any_q);
+}/// eris_http_accept_gzip
 
 
 /**
- * @Brief: Clean up eris http response handler.
+ * @Brief: Check response can be gzipped for client, response of gzip types
+ *       : is marked Vary, and deflate stream is created or reset.
  *
  * @Param: __http, Eris http context.
  *
- * @Return: Nothing.
+ * @Return: Gzip it is true, Other is false.
  **/
-eris_void_t eris_http_cleanup_response( eris_http_t *__http)
+static eris_bool_t eris_http_response_gzip_begin( eris_http_t *__http)
 {
-    if ( __http) {
-        /** Clean up response */
-        __http->response.version = ERIS_HTTP_V00;
-        __http->response.status  = ERIS_HTTP_000;
+    eris_bool_t rc = false;
 
-        eris_string_free( __http->response.reason);
-        __http->response.reason = NULL;
+#if (ERIS_HAVE_ZLIB_H)
+    eris_http_status_t status = __http->response.status;
 
-        /** Release all headers nodes */
-        eris_http_hnode_t *del_hnode = __http->response.headers;
-        while ( del_hnode) {
-            __http->response.headers = __http->response.headers->next;
+    const eris_char_t *p_type = NULL;
+    if ( __http->attrs.gzip && __http->attrs.gzip_types && (0 > __http->resp_fd) && !__http->resp_meta &&
+         (ERIS_HTTP_200 <= status) && (ERIS_HTTP_300 > status) && 
+         (ERIS_HTTP_204 != status) && (ERIS_HTTP_206 != status) &&
+         !eris_http_response_get_header( __http, "Content-Encoding")) {
+        p_type = eris_http_response_get_header( __http, "Content-Type");
+    }
 
-            if ( del_hnode->name) {
-                eris_string_free( del_hnode->name);
-                del_hnode->name  = NULL;
-            }
+    if ( p_type) {
+        /** Media type without parameters */
+        p_type += strspn( p_type, " \t");
 
-            if ( del_hnode->value) {
-                eris_string_free( del_hnode->value);
-                del_hnode->value = NULL;
-            }
+        eris_size_t type_n = strcspn( p_type, ";");
+        while ( (0 < type_n) && ((' ' == p_type[ type_n - 1]) || ('\t' == p_type[ type_n - 1]))) { type_n--; }
 
-            del_hnode->next  = NULL;
+        /** Types list is lowercase and split by space */
+        eris_bool_t matched = false;
 
-            eris_memory_free( del_hnode);
+        const eris_char_t *p_types = __http->attrs.gzip_types;
+        while ( !matched && *p_types) {
+            p_types += strspn( p_types, " \t");
 
-            /** Goto next */
-            del_hnode = __http->response.headers;
-        }
+            eris_size_t n = strcspn( p_types, " \t");
+            if ( ((1 == n) && ('*' == *p_types)) || 
+                 ((0 < n) && (n == type_n) && (0 == strncasecmp( p_types, p_type, n))) ) {
+                matched = true;
+            }
 
-        eris_buffer_free( &(__http->response.body));
-    }
-}/// eris_http_cleanup_response
+            p_types += n;
+        }
 
+        if ( matched) {
+            /** Cache must know response varies by Accept-Encoding */
+            const eris_string_t vary_es = eris_http_response_get_header( __http, "Vary");
+            if ( !vary_es) {
+                (eris_none_t )eris_http_response_set_header( __http, "Vary", "Accept-Encoding");
 
-/**
- * @Brief: Check status is valid.
- *
- * @Parma: __status, Input status code.
- *
- * @Return: Is valid is true, Other is false.
- **/
-eris_bool_t eris_http_status_valid( eris_int_t __status)
-{
-    eris_bool_t is_valid = false;
+            } else if ( (ERIS_STRING_NPOS == eris_string_find( vary_es, "Accept-Encoding")) && !eris_string_isequal( vary_es, "*", false)) {
+                eris_string_t new_vary_es = NULL;
 
-    eris_int_t i = 0;
+                if ( 0 == eris_string_printf( &new_vary_es, "%S, Accept-Encoding", vary_es)) {
+                    (eris_none_t )eris_http_response_set_header( __http, "Vary", new_vary_es);
+                }
 
-    for ( i = 0; i < eris_http_status_map_reason_size; i++) {
-        if ( __status == eris_http_status_map_reason[ i].status) {
-            is_valid = true;
+                eris_string_free( new_vary_es);
+            }
 
-            break;
+            rc = eris_http_accept_gzip( eris_http_request_get_header( __http, "Accept-Encoding"));
         }
     }
 
-    return is_valid;
-}/// eris_eris_http_status_valid
+    /** Deflate stream is reused by all responses of context */
+    if ( rc) {
+        z_stream *zs = (z_stream *)__http->resp_zstream;
+        if ( zs) {
+            if ( Z_OK != deflateReset( zs)) { rc = false; }
 
+        } else {
+            zs = (z_stream *)eris_memory_alloc( sizeof( z_stream));
+            if ( zs) {
+                eris_memory_cleanup( zs, sizeof( z_stream));
 
-/**
- * @Brief: Get status string
- *
- * @Param: __status, Status code.
- *
- * @Return: status string.
- **/
-const eris_char_t *eris_http_status_string( eris_int_t __status)
-{
-    eris_int_t i = 0;
+                /** Window bits 15 + 16 is gzip wrapper */
+                if ( Z_OK == deflateInit2( zs, __http->attrs.gzip_level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY)) {
+                    __http->resp_zstream = zs;
 
-    for ( i = 0; i < eris_http_status_map_reason_size; i++) {
-        if ( __status == eris_http_status_map_reason[ i].status) {
+                } else {
+                    eris_memory_free( zs);
+
+                    rc = false;
+                }
+            } else { rc = false; }
+        }
 
-            return eris_http_status_map_reason[ i].status_s;
+        if ( !rc) {
+            if ( __http->log) {
+                eris_log_dump( __http->log, ERIS_LOG_CORE, "Ready deflate stream failed, errno.<%d>", errno);
+            }
         }
     }
+#endif
 
-    return NULL;
-}/// eris_http_status_reason_phrace
+    return rc;
+}/// eris_http_response_gzip_begin
 
 
 /**
- * @Brief: Get status reason phrace.
+ * @Brief: Deflate data into gzip output buffer, it is sync flushed that 
+ *       : client can inflate it at once, or finish with gzip trailer.
  *
- * @Param: __status, Status code.
+ * @Param: __http,   Eris http context.
+ * @Param: __data,   Input data.
+ * @Param: __size,   Input data size.
+ * @Param: __finish, Is the end of body.
  *
- * @Return: reason phrace string.
+ * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
-const eris_char_t *eris_http_status_reason_phrace( eris_int_t __status)
+static eris_int_t eris_http_response_gzip_deflate( eris_http_t *__http, const eris_void_t *__data, eris_size_t __size, eris_bool_t __finish)
 {
-    eris_int_t i = 0;
+    eris_int_t rc = 0;
+
+#if (ERIS_HAVE_ZLIB_H)
+    z_stream      *zs      = (z_stream *)__http->resp_zstream;
+    eris_buffer_t *zbuffer = &(__http->resp_zbuffer);
+
+    /** Bound of output, and it is doubled when flush is over it */
+    eris_size_t need = deflateBound( zs, __size) + 16;
+
+    zbuffer->size = 0;
+    zs->next_in   = (Bytef *)__data;
+    zs->avail_in  = (uInt )__size;
 
-    for ( i = 0; i < eris_http_status_map_reason_size; i++) {
-        if ( __status == eris_http_status_map_reason[ i].status) {
+    do {
+        if ( need > (zbuffer->alloc - zbuffer->size)) {
+            eris_uchar_t *data_ptr = (eris_uchar_t *)eris_memory_realloc( zbuffer->data, zbuffer->size + need);
+            if ( data_ptr) {
+                zbuffer->data  = data_ptr;
+                zbuffer->alloc = zbuffer->size + need;
 
-            return eris_http_status_map_reason[ i].reason_phrace;
+            } else {
+                rc = EERIS_ERROR;
+
+                if ( __http->log) {
+                    eris_log_dump( __http->log, ERIS_LOG_CORE, "Realloc memory for deflate failed, errno.<%d>", errno);
+                }
+
+                break;
+            }
         }
-    }
 
-    return NULL;
-}/// eris_http_status_reason_phrace
+        zs->next_out  = (Bytef *)(zbuffer->data + zbuffer->size);
+        zs->avail_out = (uInt )(zbuffer->alloc - zbuffer->size);
+
+        if ( Z_STREAM_ERROR == deflate( zs, __finish ? Z_FINISH : Z_SYNC_FLUSH)) {
+            rc = EERIS_ERROR;
+
+            if ( __http->log) {
+                eris_log_dump( __http->log, ERIS_LOG_CORE, "Deflate data failed.");
+            }
+
+            break;
+        }
+
+        zbuffer->size = zbuffer->alloc - zs->avail_out;
+        need = zbuffer->alloc;
+    } while ( 0 == zs->avail_out);
+#else
+    rc = EERIS_ERROR;
+#endif
+
+    return rc;
+}/// eris_http_response_gzip_deflate
 
 
 /**
- * @Brief: Destroy eris http context.
+ * @Brief: Add a hex char of chunk size, chunk size is not more than 15 hex chars of 64 bits,
+ *         and a request chunk is not out of body max size before its data is read.
  *
  * @Param: __http, Eris http context.
+ * @Param: __type, ERIS_HTTP_REQUEST or ERIS_HTTP_RESPONSE.
+ * @Param: __c,    Hexadecimal char.
  *
- * @Return: Nothing.
+ * @Return: Ok is 0, Too large is EERIS_DATA.
  **/
-eris_void_t eris_http_destroy( eris_http_t *__http)
+static eris_int_t eris_http_chunk_size_add( eris_http_t *__http, eris_http_type_t __type, eris_char_t __c)
 {
-    if ( __http) {
-        eris_http_cleanup( __http);
+    eris_int_t rc = 0;
 
-        /** Destroy request/response buffer */
-        eris_buffer_destroy( &(__http->request.body));
-        eris_buffer_destroy( &(__http->response.body));
+    if ( __http->chunk_size > (((eris_size_t )-1) >> 8)) {
+        /** Overflow of size */
+        rc = EERIS_DATA;
 
-        /** Destroy header/body buffer */
-        eris_buffer_destroy( &(__http->hbuffer));
-        eris_buffer_destroy( &(__http->bbuffer));
+    } else {
+        __http->chunk_size = (__http->chunk_size << 4) + ERIS_CHAR_HEX_V( __c);
 
-        {
-            __http->log   = NULL;
+        if ( (ERIS_HTTP_REQUEST == __type) && 
+             ((__http->body_total + __http->request.body.size + __http->chunk_size) > __http->attrs.body_max_size)) {
+            rc = EERIS_DATA;
         }
     }
-}/// eris_http_destroy
 
+    if ( 0 != rc) {
+        if ( ERIS_HTTP_REQUEST == __type) {
+            __http->response.status  = ERIS_HTTP_413;
+            __http->response.version = ERIS_HTTP_V10;
+            eris_string_set( &(__http->response.reason), eris_http_status_desc( 413));
+        }
 
+        if ( __http->log) {
+            eris_log_dump( __http->log, ERIS_LOG_CORE, "A chunk size is too large");
+        }
+    }
 
+    return rc;
+}/// eris_http_chunk_size_add
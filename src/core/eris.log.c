@@ -18,9 +18,35 @@
 #include "core/eris.core.h"
 
 
+/** Level names of log message line */
+static const eris_char_t *eris_log_levels[ ERIS_LOG_LVLMAX + 1] = {
+    "DEBUG " ,
+    "INFO  " ,
+    "NOTICE" ,
+    "WARN  " ,
+    "ERROR " ,
+    "FATAL " ,
+    "CRIT  " ,
+    "ATERT " ,
+    "EMERG " ,
+    "E-CORE" ,
+    NULL
+};
+
+
 /** Truncate the log file to zero size. */
 static eris_void_t eris_log_truncate( eris_log_t *__log);
 
+/** Append a made log message line into kept open log file with one write. */
+static eris_void_t eris_log_append( eris_log_t *__log, eris_log_level_t __level, const eris_char_t *__record);
+
+/** Check kept open log file, it is opened again of renamed and truncated of max size. */
+static eris_void_t eris_log_check( eris_log_t *__log);
+
+/** Append a log message line with time and level into log file. */
+static eris_void_t eris_log_record( eris_log_t *__log, eris_log_level_t __level, const eris_char_t *__file, 
+                                    const eris_char_t *__func, eris_int_t __line, const eris_char_t *__content);
+
 
 /**
  * @brief: Init-log context, Set level, max log message and log file object.
@@ -43,6 +69,13 @@ eris_int_t eris_log_init( eris_log_t *__log, const eris_char_t *__log_file, eris
             }
         } else { __log->log_file = NULL; }
 
+        /** Made records are written to it, failed is written as others */
+        __log->fd        = -1;
+        __log->check_sec = 0;
+        if ( __log->log_file) {
+            __log->fd = open( __log->log_file, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0666);
+        }
+
         if ( (ERIS_LOG_DEBUG <= __min_level) && (ERIS_LOG_LVLMAX > __min_level)) {
             __log->min_level = __min_level;
         } else { __log->min_level = ERIS_LOG_DEBUG; }
@@ -69,99 +102,42 @@ eris_int_t eris_log_init( eris_log_t *__log, const eris_char_t *__log_file, eris
  **/
 eris_void_t eris_log_exec( eris_log_t *__log, eris_log_level_t __level, const eris_char_t *__file, const eris_char_t *__func, eris_int_t __line, const eris_char_t *__fmt, ...)
 {
-    if ( __level >= __log->min_level) {
+    if ( __log && (__level >= __log->min_level)) {
         /** Check log context */
-        if ( __log && (__log->log_file) && __fmt) {
-            eris_int_t rc = 0;
-
-            /** Append */
-            FILE *log_file_context = NULL;
-            log_file_context = fopen( __log->log_file, "a+");
-            if ( log_file_context) {
-                long file_pos = ftell( log_file_context);
-                if ( 0 > file_pos) { file_pos = 0; }
-
-                const eris_char_t *level_arr[ 11] = {
-                    "DEBUG " ,
-                    "INFO  " ,
-                    "NOTICE" ,
-                    "WARN  " ,
-                    "ERROR " ,
-                    "FATAL " ,
-                    "CRIT  " ,
-                    "ATERT " ,
-                    "EMERG " ,
-                    "E-CORE" ,
-                    NULL
-                };
-
-                eris_char_t buffer_time[64] = {0};
-                eris_time_t time_v  = time( NULL);
-                eris_tm_t   tm_v    = *( gmtime( &time_v));
-
-                /** Get GMT format string */
-                (void )strftime( buffer_time, sizeof( buffer_time), "%F %H:%M:%S", &tm_v);
-
-                eris_char_t log_content[ 4096] = {0}; {
-                    va_list vap;
-                    va_start( vap, __fmt);
-                    (void )vsnprintf( log_content, (eris_long_t )sizeof( log_content), __fmt, vap);
-                    va_end( vap);
-                }
+        if ( (__log->log_file) && __fmt) {
+            eris_char_t log_content[ 4096] = {0}; {
+                va_list vap;
+                va_start( vap, __fmt);
+                (void )vsnprintf( log_content, (eris_long_t )sizeof( log_content), __fmt, vap);
+                va_end( vap);
+            }
 
-                /** Lock log file */
-                eris_flock_t lock_w; {
-                    lock_w.l_type   = F_WRLCK;
-                    lock_w.l_start  = 0;
-                    lock_w.l_whence = SEEK_SET;
-                    lock_w.l_len    = 0;
-                    lock_w.l_pid    = getpid();
-                }
+            eris_log_record( __log, __level, __file, __func, __line, log_content);
+        }
+    }
+}/// eris_log_exec
 
-                rc = fcntl( fileno( log_file_context), F_SETLKW, &lock_w);
-                if ( 0 == rc) {
-                    /** Truncate??? */
-                    if ( (0 < __log->max_size) && (__log->max_size < (eris_size_t )file_pos)) {
-                        (void )eris_log_truncate( __log);
-                    }
-
-                    if ( ERIS_LOG_DEBUG == __log->min_level) {
-                        fprintf( log_file_context, "%s [%s]: File.{%s->:%s->:%d} - %s\n",
-                                buffer_time,
-                                level_arr[ __level],
-                                __file,
-                                __func,
-                                __line,
-                                log_content
-                        );
-                    } else {
-                        fprintf( log_file_context, "%s [%s]: %s\n",
-                                buffer_time,
-                                level_arr[ __level],
-                                log_content
-                        );
-                    }
-
-                    /** Flush log message */
-                    (void)fflush( log_file_context);
-
-                    /** Unlock */
-                    {
-                        lock_w.l_type   = F_UNLCK;
-                        lock_w.l_start  = 0;
-                        lock_w.l_whence = 0;
-                        lock_w.l_len    = 0;
-                        lock_w.l_pid    = 0;
-                        (void )fcntl( fileno( log_file_context), F_SETLK, &lock_w);
-                    }
-                }
 
-                /** Close log file */
-                (void )fclose( log_file_context); log_file_context = NULL;
-            }
+/**
+ * @brief: Dump out a made log message, it is not formatted again.
+ *
+ * @param: __log,    Log context...
+ * @Param: __level,  Dump out level log message.
+ * @Param: __record, Log message string.
+ *
+ * @return: Nothing
+ **/
+eris_void_t eris_log_write( eris_log_t *__log, eris_log_level_t __level, const eris_char_t *__record)
+{
+    if ( __log && (__level >= __log->min_level)) {
+        if ( (__log->log_file) && __record) {
+            if ( 0 <= __log->fd) {
+                eris_log_append( __log, __level, __record);
+
+            } else { eris_log_record( __log, __level, NULL, NULL, 0, __record); }
         }
     }
-}/// eris_log_exec
+}/// eris_log_write
 
 
 /**
@@ -174,6 +150,12 @@ eris_void_t eris_log_exec( eris_log_t *__log, eris_log_level_t __level, const er
 eris_void_t eris_log_cleanup( eris_log_t *__log)
 {
     if ( __log) {
+        /** Close kept open log file */
+        if ( __log->log_file && (0 <= __log->fd)) {
+            (void )close( __log->fd);
+        }
+        __log->fd = -1;
+
         /** Free log file memory */
         eris_string_free( __log->log_file);
         eris_string_init( __log->log_file);
@@ -194,6 +176,12 @@ eris_void_t eris_log_cleanup( eris_log_t *__log)
 eris_void_t eris_log_destroy( eris_log_t *__log)
 {
     if ( __log) {
+        /** Close kept open log file */
+        if ( __log->log_file && (0 <= __log->fd)) {
+            (void )close( __log->fd);
+        }
+        __log->fd = -1;
+
         /** Free log file memory */
         eris_string_free( __log->log_file);
         eris_string_init( __log->log_file);
@@ -222,3 +210,182 @@ static eris_void_t eris_log_truncate( eris_log_t *__log)
 }/// eris_log_truncate
 
 
+/**
+ * @Brief: Append a log message line with time and level into log file.
+ *
+ * @Param: __log,     Log context.
+ * @Param: __level,   Dump out level log message.
+ * @Param: __file,    Record execute file name, NULL is not dumped.
+ * @Param: __func,    Record execute function done.
+ * @Param: __line,    Record done line number.
+ * @Param: __content, Log message string.
+ *
+ * @Return: Nothing.
+ **/
+static eris_void_t eris_log_record( eris_log_t *__log, eris_log_level_t __level, const eris_char_t *__file, 
+                                    const eris_char_t *__func, eris_int_t __line, const eris_char_t *__content)
+{
+    eris_int_t rc = 0;
+
+    /** Append */
+    FILE *log_file_context = NULL;
+    log_file_context = fopen( __log->log_file, "a+");
+    if ( log_file_context) {
+        long file_pos = ftell( log_file_context);
+        if ( 0 > file_pos) { file_pos = 0; }
+
+        eris_char_t buffer_time[64] = {0};
+        eris_time_t time_v  = time( NULL);
+        eris_tm_t   tm_v    = *( gmtime( &time_v));
+
+        /** Get GMT format string */
+        (void )strftime( buffer_time, sizeof( buffer_time), "%F %H:%M:%S", &tm_v);
+
+        /** Lock log file */
+        eris_flock_t lock_w; {
+            lock_w.l_type   = F_WRLCK;
+            lock_w.l_start  = 0;
+            lock_w.l_whence = SEEK_SET;
+            lock_w.l_len    = 0;
+            lock_w.l_pid    = getpid();
+        }
+
+        rc = fcntl( fileno( log_file_context), F_SETLKW, &lock_w);
+        if ( 0 == rc) {
+            /** Truncate??? */
+            if ( (0 < __log->max_size) && (__log->max_size < (eris_size_t )file_pos)) {
+                (void )eris_log_truncate( __log);
+            }
+
+            if ( (ERIS_LOG_DEBUG == __log->min_level) && __file) {
+                fprintf( log_file_context, "%s [%s]: File.{%s->:%s->:%d} - %s\n",
+                        buffer_time,
+                        eris_log_levels[ __level],
+                        __file,
+                        __func,
+                        __line,
+                        __content
+                );
+            } else {
+                fprintf( log_file_context, "%s [%s]: %s\n",
+                        buffer_time,
+                        eris_log_levels[ __level],
+                        __content
+                );
+            }
+
+            /** Flush log message */
+            (void)fflush( log_file_context);
+
+            /** Unlock */
+            {
+                lock_w.l_type   = F_UNLCK;
+                lock_w.l_start  = 0;
+                lock_w.l_whence = 0;
+                lock_w.l_len    = 0;
+                lock_w.l_pid    = 0;
+                (void )fcntl( fileno( log_file_context), F_SETLK, &lock_w);
+            }
+        }
+
+        /** Close log file */
+        (void )fclose( log_file_context); log_file_context = NULL;
+    }
+}/// eris_log_record
+
+
+/**
+ * @Brief: Append a made log message line into kept open log file with one write,
+ *         time is the cached string and nothing is formatted.
+ *
+ * @Param: __log,    Log context.
+ * @Param: __level,  Dump out level log message.
+ * @Param: __record, Log message string.
+ *
+ * @Return: Nothing.
+ **/
+static eris_void_t eris_log_append( eris_log_t *__log, eris_log_level_t __level, const eris_char_t *__record)
+{
+    /** Size and rename of file are checked once a second of one thread */
+    eris_time_t now_sec   = time( NULL);
+    eris_time_t check_sec = __log->check_sec;
+
+    if ( (now_sec != check_sec) && eris_atomic_cmp_set( &(__log->check_sec), check_sec, now_sec)) {
+        eris_log_check( __log);
+    }
+
+    /** "time [level]: record\n" */
+    eris_char_t log_line[ 4096 + 64];
+    eris_size_t line_size = 0;
+
+    memcpy( log_line, eris_time_log_cached(), ERIS_TIME_LOG_SIZE);
+    line_size += ERIS_TIME_LOG_SIZE;
+
+    memcpy( log_line + line_size, " [", 2);
+    line_size += 2;
+
+    memcpy( log_line + line_size, eris_log_levels[ __level], 6);
+    line_size += 6;
+
+    memcpy( log_line + line_size, "]: ", 3);
+    line_size += 3;
+
+    eris_size_t record_size = strlen( __record);
+    if ( record_size > (sizeof( log_line) - line_size - 1)) {
+        record_size = sizeof( log_line) - line_size - 1;
+    }
+
+    memcpy( log_line + line_size, __record, record_size);
+    line_size += record_size;
+
+    log_line[ line_size++] = '\n';
+
+    /** O_APPEND line is not mixed with lines of others */
+    (void )write( __log->fd, log_line, line_size);
+}/// eris_log_append
+
+
+/**
+ * @Brief: Check kept open log file, a renamed or removed file is opened again in
+ *         place of fd, and file over max size is truncated of file lock as record.
+ *
+ * @Param: __log, Log context.
+ *
+ * @Return: Nothing.
+ **/
+static eris_void_t eris_log_check( eris_log_t *__log)
+{
+    eris_stat_t fd_info;
+    eris_stat_t path_info;
+
+    if ( 0 == fstat( __log->fd, &fd_info)) {
+        if ( (0 != stat( __log->log_file, &path_info)) || 
+             (path_info.st_ino != fd_info.st_ino) || (path_info.st_dev != fd_info.st_dev)) {
+            eris_fd_t new_fd = open( __log->log_file, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0666);
+            if ( 0 <= new_fd) {
+                /** Writers of other threads go on the same fd */
+                if ( 0 <= dup2( new_fd, __log->fd)) {
+                    (void )fcntl( __log->fd, F_SETFD, FD_CLOEXEC);
+                }
+
+                (void )close( new_fd);
+            }
+        } else if ( (0 < __log->max_size) && (__log->max_size < (eris_size_t )fd_info.st_size)) {
+            eris_flock_t lock_w; {
+                lock_w.l_type   = F_WRLCK;
+                lock_w.l_start  = 0;
+                lock_w.l_whence = SEEK_SET;
+                lock_w.l_len    = 0;
+                lock_w.l_pid    = getpid();
+            }
+
+            if ( 0 == fcntl( __log->fd, F_SETLKW, &lock_w)) {
+                (void )ftruncate( __log->fd, 0);
+
+                lock_w.l_type   = F_UNLCK;
+                lock_w.l_pid    = 0;
+                (void )fcntl( __log->fd, F_SETLK, &lock_w);
+            }
+        }
+    }
+}/// eris_log_check
@@ -22,6 +22,24 @@ static eris_int_t eris_module_erase_compare( eris_module_elem_t *__elem, eris_ar
 /** Release module element. */
 static eris_none_t eris_module_elem_delete( eris_module_elem_t *__elem);
 
+/** Open libfile of module element, it is kept resident while generation is not changed. */
+static eris_void_t *eris_module_libfile_open( eris_module_t *__module, eris_module_elem_t *__elem);
+
+/** Close libfile of module element. */
+static eris_none_t eris_module_libfile_close( eris_module_t *__module, eris_module_elem_t *__elem, eris_void_t *__libfile_context);
+
+/** Deliver deferred request body to service body stream or load it. */
+static eris_int_t eris_module_body_exec( eris_module_t *__module, eris_void_t *__libfile_context, const eris_char_t *__service_s, eris_http_t *__http);
+
+/** Enter service of module element, it waits in queue or is rejected over max_concurrency. */
+static eris_int_t eris_module_bulkhead_enter( eris_module_t *__module, eris_module_elem_t *__elem);
+
+/** Leave service of module element. */
+static eris_none_t eris_module_bulkhead_leave( eris_module_elem_t *__elem);
+
+/** Take a running slot of module element under max_concurrency. */
+static eris_bool_t eris_module_bulkhead_take( eris_module_elem_t *__elem);
+
 
 
 /**
@@ -38,8 +56,9 @@ eris_int_t eris_module_init( eris_module_t *__module, eris_cftree_t *__cftree, e
     eris_int_t rc = 0;
 
     if ( __module) {
-        __module->cftree = __cftree;
-        __module->log    = __log;
+        __module->cftree     = __cftree;
+        __module->log        = __log;
+        __module->generation = NULL;
 
         rc = eris_list_init( &(__module->context), true, __log);
         if ( 0 != rc) {
@@ -156,7 +175,7 @@ eris_int_t eris_module_update( eris_module_t *__module, const eris_module_info_t
  * @Param: __service_path_s, Execute service path string, eg: /xxx/yyy/zzz/hello_service.
  * @Param: __http,   Eris http context, it is request input and output response.
  *
- * @Return: Ok is EERIS_OK,
+ * @Return: Ok is EERIS_OK, Read request body failed is EERIS_4XX,
  *        : Other codes (EERIS_INVALID, EERIS_ALLOC, EERIS_NOTFOUND, EERIS_SERVICE, EERIS_UNSUPPORT).
  **/
 eris_int_t eris_module_exec( eris_module_t *__module, const eris_char_t *__service_path_s, eris_http_t *__http)
@@ -214,52 +233,63 @@ eris_int_t eris_module_exec( eris_module_t *__module, const eris_char_t *__servi
                 /** Call service */
                 if ( '\0' != s) {
                     (eris_none_t )dlerror();
-                    
-#if (RTLD_DEEPBIND)
-                    eris_int_t open_libfile_mode = (RTLD_LAZY | RTLD_GLOBAL | RTLD_DEEPBIND);
-#else
-                    eris_int_t open_libfile_mode = (RTLD_LAZY | RTLD_GLOBAL);
-#endif
-                    eris_void_t *libfile_context = dlopen( cur_elem->libfile, open_libfile_mode);
-                    if ( libfile_context) {
-                        /** Convert service function */
-                        eris_module_service_t service_func = (eris_module_service_t)dlsym( libfile_context, s);
-                        if ( service_func) {
-                            rc = service_func( __module, __http, __module->log);
-                            if ( 0 == rc) {
-                                /** Ok */
-                                rc = EERIS_OK;
 
-                                if ( __module->log) {
-                                    eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Execute service \"%s\" ok", __service_path_s);
+                    /** Bulkhead of module, a shed request does not open libfile or read body */
+                    if ( 0 != eris_module_bulkhead_enter( __module, cur_elem)) {
+                        rc = EERIS_FULL;
+
+                    } else {
+                        eris_void_t *libfile_context = eris_module_libfile_open( __module, cur_elem);
+                        if ( libfile_context) {
+                            /** Convert service function */
+                            eris_module_service_t service_func = (eris_module_service_t)dlsym( libfile_context, s);
+                            if ( service_func) {
+                                rc = eris_module_body_exec( __module, libfile_context, s, __http);
+                                if ( 0 == rc) {
+                                    rc = service_func( __module, __http, __module->log);
+                                }
+
+                                if ( EERIS_4XX == rc) {
+                                    if ( __module->log) {
+                                        eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Read body of service \"%s\" failed", __service_path_s);
+                                    }
+                                } else if ( 0 == rc) {
+                                    /** Ok */
+                                    rc = EERIS_OK;
+
+                                    if ( __module->log) {
+                                        eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Execute service \"%s\" ok", __service_path_s);
+                                    }
+                                } else {
+                                    rc = EERIS_SERVICE;
+
+                                    if ( __module->log) {
+                                        eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Execute Service \"%s\" happend error", __service_path_s);
+                                    }
                                 }
                             } else {
-                                rc = EERIS_SERVICE;
+                                rc = EERIS_NOTFOUND;
 
                                 if ( __module->log) {
-                                    eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Execute Service \"%s\" happend error", __service_path_s);
+                                    eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Dlopen service \"%s\" failed, error.<%s>", __service_path_s, (const char *)dlerror());
                                 }
                             }
+
+                            /** Dlclose do */
+                            {
+                                eris_module_libfile_close( __module, cur_elem, libfile_context); 
+                                libfile_context = NULL;
+                            }
+
                         } else {
-                            rc = EERIS_NOTFOUND;
+                            rc = EERIS_NOSUCH;
 
                             if ( __module->log) {
-                                eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Dlopen service \"%s\" failed, error.<%s>", __service_path_s, (const char *)dlerror());
+                                eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Libfile \"%s\" no such file", cur_elem->libfile);
                             }
                         }
 
-                        /** Dlclose do */
-                        {
-                            dlclose( libfile_context); 
-                            libfile_context = NULL;
-                        }
-
-                    } else {
-                        rc = EERIS_NOSUCH;
-
-                        if ( __module->log) {
-                            eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Libfile \"%s\" no such file", cur_elem->libfile);
-                        }
+                        eris_module_bulkhead_leave( cur_elem);
                     }
                 } else {
                     rc = EERIS_NOTFOUND;
@@ -315,7 +345,7 @@ eris_int_t eris_module_exec( eris_module_t *__module, const eris_char_t *__servi
  * @Param: __service_path_es, Execute eris service path string, eg: /xxx/yyy/zzz/hello_service.
  * @Param: __http,   Eris http context, it is request input and output response.
  *
- * @Return: Ok is EERIS_OK,
+ * @Return: Ok is EERIS_OK, Read request body failed is EERIS_4XX,
  *        : Other codes (EERIS_INVALID, EERIS_ALLOC, EERIS_NOTFOUND, EERIS_SERVICE, EERIS_UNSUPPORT).
  **/
 eris_int_t eris_module_exec_eris( eris_module_t *__module, const eris_string_t __service_path_es, eris_http_t *__http)
@@ -368,52 +398,63 @@ eris_int_t eris_module_exec_eris( eris_module_t *__module, const eris_string_t _
                 /** Call service */
                 if ( '\0' != s) {
                     (eris_none_t )dlerror();
-                    
-#if (RTLD_DEEPBIND)
-                    eris_int_t open_libfile_mode = (RTLD_LAZY | RTLD_GLOBAL | RTLD_DEEPBIND);
-#else
-                    eris_int_t open_libfile_mode = (RTLD_LAZY | RTLD_GLOBAL);
-#endif
-                    eris_void_t *libfile_context = dlopen( cur_elem->libfile, open_libfile_mode);
-                    if ( libfile_context) {
-                        /** Convert service function */
-                        eris_module_service_t service_func = (eris_module_service_t)dlsym( libfile_context, s);
-                        if ( service_func) {
-                            rc = service_func( __module, __http, __module->log);
-                            if ( 0 != rc) {
-                                /** Ok */
-                                rc = EERIS_OK;
 
-                                if ( __module->log) {
-                                    eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Execute service \"%s\" ok", __service_path_es);
+                    /** Bulkhead of module, a shed request does not open libfile or read body */
+                    if ( 0 != eris_module_bulkhead_enter( __module, cur_elem)) {
+                        rc = EERIS_FULL;
+
+                    } else {
+                        eris_void_t *libfile_context = eris_module_libfile_open( __module, cur_elem);
+                        if ( libfile_context) {
+                            /** Convert service function */
+                            eris_module_service_t service_func = (eris_module_service_t)dlsym( libfile_context, s);
+                            if ( service_func) {
+                                rc = eris_module_body_exec( __module, libfile_context, s, __http);
+                                if ( 0 == rc) {
+                                    rc = service_func( __module, __http, __module->log);
+                                }
+
+                                if ( EERIS_4XX == rc) {
+                                    if ( __module->log) {
+                                        eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Read body of service \"%s\" failed", __service_path_es);
+                                    }
+                                } else if ( 0 == rc) {
+                                    /** Ok */
+                                    rc = EERIS_OK;
+
+                                    if ( __module->log) {
+                                        eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Execute service \"%s\" ok", __service_path_es);
+                                    }
+                                } else {
+                                    rc = EERIS_SERVICE;
+
+                                    if ( __module->log) {
+                                        eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Execute Service \"%s\" happend errro", __service_path_es);
+                                    }
                                 }
                             } else {
-                                rc = EERIS_SERVICE;
+                                rc = EERIS_NOTFOUND;
 
                                 if ( __module->log) {
-                                    eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Execute Service \"%s\" happend errro", __service_path_es);
+                                    eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Dlopen service \"%s\" failed, error.<%s>", __service_path_es, (const char *)dlerror());
                                 }
                             }
+
+                            /** Dlclose do */
+                            {
+                                eris_module_libfile_close( __module, cur_elem, libfile_context); 
+                                libfile_context = NULL;
+                            }
+
                         } else {
-                            rc = EERIS_NOTFOUND;
+                            rc = EERIS_NOSUCH;
 
                             if ( __module->log) {
-                                eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Dlopen service \"%s\" failed, error.<%s>", __service_path_es, (const char *)dlerror());
+                                eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Libfile \"%s\" no such file", cur_elem->libfile);
                             }
                         }
 
-                        /** Dlclose do */
-                        {
-                            dlclose( libfile_context); 
-                            libfile_context = NULL;
-                        }
-
-                    } else {
-                        rc = EERIS_NOSUCH;
-
-                        if ( __module->log) {
-                            eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Libfile \"%s\" no such file", cur_elem->libfile);
-                        }
+                        eris_module_bulkhead_leave( cur_elem);
                     }
                 } else {
                     rc = EERIS_NOTFOUND;
@@ -586,7 +627,28 @@ static eris_module_elem_t *eris_module_elem_create( const eris_module_info_t *__
     if ( __info) {
         rc_elem = (eris_module_elem_t *)eris_memory_alloc( sizeof( eris_module_elem_t));
         if ( rc_elem) {
-            rc_elem->lgg = ERIS_MODULE_UNKNOW;
+            rc_elem->lgg          = ERIS_MODULE_UNKNOW;
+            rc_elem->resident     = NULL;
+            rc_elem->resident_gen = 0;
+            rc_elem->inflight     = 0;
+
+            rc_elem->max_concurrency = (0 < __info->max_concurrency) ? __info->max_concurrency : 0;
+            rc_elem->queue_length    = (0 < __info->queue_length)    ? __info->queue_length    : 0;
+            rc_elem->queue_timeout   = (0 < __info->queue_timeout)   ? __info->queue_timeout   : 0;
+            rc_elem->running         = 0;
+            rc_elem->waiting         = 0;
+
+            /** Waiters of queue sleep on cond of monotonic deadline */
+            {
+                pthread_condattr_t cond_attr;
+                (eris_none_t )pthread_condattr_init( &cond_attr);
+#if defined(CLOCK_MONOTONIC)
+                (eris_none_t )pthread_condattr_setclock( &cond_attr, CLOCK_MONOTONIC);
+#endif
+                (eris_none_t )pthread_mutex_init( &(rc_elem->wait_mutex), NULL);
+                (eris_none_t )pthread_cond_init( &(rc_elem->wait_cond), &cond_attr);
+                (eris_none_t )pthread_condattr_destroy( &cond_attr);
+            }
 
             eris_string_init( rc_elem->name);
             eris_string_init( rc_elem->pattern);
@@ -707,6 +769,13 @@ static eris_none_t eris_module_elem_delete( eris_module_elem_t *__elem)
 
         __elem->lgg = ERIS_MODULE_UNKNOW;
 
+        /** Release kept libfile */
+        if ( __elem->resident) {
+            dlclose( __elem->resident);
+
+            __elem->resident = NULL;
+        }
+
         /** Release name */
         {
             eris_string_free( __elem->name);
@@ -725,8 +794,263 @@ static eris_none_t eris_module_elem_delete( eris_module_elem_t *__elem)
             eris_string_init( __elem->libfile);
         }
 
+        (eris_none_t )pthread_cond_destroy( &(__elem->wait_cond));
+        (eris_none_t )pthread_mutex_destroy( &(__elem->wait_mutex));
+
         eris_memory_free( __elem);
     }
 }/// eris_module_elem_delete
 
 
+/**
+ * @Brief: Open libfile of module element. With libfile generation it is kept
+ *       : resident, and a service dlopen is only a reference of loaded image.
+ *       : Changed generation drops it, then the new libfile is loaded when
+ *       : services of old image are done.
+ *
+ * @Param: __module, Eris module context.
+ * @Param: __elem,   Eris module element.
+ *
+ * @Return: Ok is libfile context, Other is NULL.
+ **/
+static eris_void_t *eris_module_libfile_open( eris_module_t *__module, eris_module_elem_t *__elem)
+{
+#if (RTLD_DEEPBIND)
+    eris_int_t open_libfile_mode = (RTLD_LAZY | RTLD_GLOBAL | RTLD_DEEPBIND);
+#else
+    eris_int_t open_libfile_mode = (RTLD_LAZY | RTLD_GLOBAL);
+#endif
+
+    eris_atomic_int_t gen   = 0;
+    eris_bool_t       fresh = false;
+
+    eris_list_lock( &(__module->context)); {
+        if ( __module->generation) {
+            gen = (eris_atomic_int_t )*(__module->generation);
+        }
+
+        if ( __elem->resident && (gen != __elem->resident_gen)) {
+            dlclose( __elem->resident);
+
+            __elem->resident = NULL;
+        }
+
+        /** No service holds old image, the libfile is loaded from file */
+        fresh = ((0 != gen) && !__elem->resident && (0 == __elem->inflight));
+
+        __elem->inflight += 1;
+    }
+    eris_list_unlock( &(__module->context));
+
+    eris_void_t *libfile_context = dlopen( __elem->libfile, open_libfile_mode);
+    if ( libfile_context) {
+        if ( fresh) {
+            eris_list_lock( &(__module->context)); {
+                if ( !__elem->resident) {
+                    __elem->resident     = dlopen( __elem->libfile, open_libfile_mode);
+                    __elem->resident_gen = gen;
+                }
+            }
+            eris_list_unlock( &(__module->context));
+        }
+    } else {
+        eris_list_lock( &(__module->context)); {
+            __elem->inflight -= 1;
+        }
+        eris_list_unlock( &(__module->context));
+    }
+
+    return libfile_context;
+}/// eris_module_libfile_open
+
+
+/**
+ * @Brief: Close libfile of module element.
+ *
+ * @Param: __module,          Eris module context.
+ * @Param: __elem,            Eris module element.
+ * @Param: __libfile_context, Libfile context of eris_module_libfile_open.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t eris_module_libfile_close( eris_module_t *__module, eris_module_elem_t *__elem, eris_void_t *__libfile_context)
+{
+    dlclose( __libfile_context);
+
+    eris_list_lock( &(__module->context)); {
+        __elem->inflight -= 1;
+    }
+    eris_list_unlock( &(__module->context));
+}/// eris_module_libfile_close
+
+
+
+
+/**
+ * @Brief: Deliver deferred request body to service body stream or load it.
+ *
+ * @Param: __module,          Eris module context.
+ * @Param: __libfile_context, Dlopen context of module libfile.
+ * @Param: __service_s,       Service name string, body stream is "<service>_body".
+ * @Param: __http,            Eris http context.
+ *
+ * @Return: Ok is 0, Read body failed is EERIS_4XX, Other is EERIS_ERROR or EERIS_SERVICE.
+ **/
+static eris_int_t eris_module_body_exec( eris_module_t *__module, eris_void_t *__libfile_context, const eris_char_t *__service_s, eris_http_t *__http)
+{
+    eris_int_t rc = 0;
+
+    if ( eris_http_request_body_pending( __http)) {
+        eris_module_body_t body_func = NULL;
+
+        eris_string_t body_name_es;
+        eris_string_init( body_name_es);
+
+        rc = eris_string_printf( &body_name_es, "%s_body", __service_s);
+        if ( 0 == rc) {
+            /** Opt-in of module, not export is buffered body */
+            body_func = (eris_module_body_t)dlsym( __libfile_context, body_name_es);
+        }
+
+        eris_string_free( body_name_es);
+        eris_string_init( body_name_es);
+
+        if ( 0 == rc) {
+            if ( body_func) {
+                const eris_void_t *window_data = NULL;
+                eris_size_t        window_size = 0;
+
+                do {
+                    rc = eris_http_request_body_read( __http, &window_data, &window_size);
+                    if ( 0 == rc) {
+                        /** Window data and end of body is 0 size */
+                        rc = body_func( __module, __http, window_data, window_size, __module->log);
+                        if ( 0 != rc) {
+                            rc = EERIS_SERVICE;
+
+                            /** Service refuse it */
+                            (eris_none_t )eris_http_request_body_discard( __http);
+                        }
+                    }
+                } while ( (0 == rc) && (0 < window_size));
+            } else {
+                rc = eris_http_request_body_load( __http);
+            }
+        } else { rc = EERIS_ERROR; }
+    }
+
+    return rc;
+}/// eris_module_body_exec
+
+
+/**
+ * @Brief: Enter service of module element. Over max_concurrency it waits in queue of
+ *         queue_length for queue_timeout ms, it sleeps on cond until a leave wakes it,
+ *         or it is rejected. New request does not take a slot before waiters of queue.
+ *
+ * @Param: __module, Eris module context.
+ * @Param: __elem,   Eris module element.
+ *
+ * @Return: Ok is 0, Rejected is EERIS_FULL.
+ **/
+static eris_int_t eris_module_bulkhead_enter( eris_module_t *__module, eris_module_elem_t *__elem)
+{
+    eris_int_t rc = 0;
+
+    if ( 0 < __elem->max_concurrency) {
+        if ( (0 < __elem->waiting) || !eris_module_bulkhead_take( __elem)) {
+            rc = EERIS_FULL;
+
+            /** Waiters are counted, queue is full and rejected at once */
+            if ( (0 < __elem->queue_length) && (0 < __elem->queue_timeout)) {
+                if ( (eris_atomic_uint_t )__elem->queue_length > eris_atomic_fetch_inc( &(__elem->waiting))) {
+                    struct timespec deadline;
+#if defined(CLOCK_MONOTONIC)
+                    (eris_none_t )clock_gettime( CLOCK_MONOTONIC, &deadline);
+#else
+                    (eris_none_t )clock_gettime( CLOCK_REALTIME, &deadline);
+#endif
+                    deadline.tv_sec  += __elem->queue_timeout / 1000;
+                    deadline.tv_nsec += (__elem->queue_timeout % 1000) * 1000000L;
+                    if ( 1000000000L <= deadline.tv_nsec) {
+                        deadline.tv_sec  += 1;
+                        deadline.tv_nsec -= 1000000000L;
+                    }
+
+                    /** Take is retried under mutex, a leave signals after it frees a slot */
+                    (eris_none_t )pthread_mutex_lock( &(__elem->wait_mutex));
+
+                    do {
+                        if ( eris_module_bulkhead_take( __elem)) {
+                            rc = 0;
+
+                            break;
+                        }
+                    } while ( ETIMEDOUT != pthread_cond_timedwait( &(__elem->wait_cond), &(__elem->wait_mutex), &deadline));
+
+                    (eris_none_t )pthread_mutex_unlock( &(__elem->wait_mutex));
+                }
+
+                eris_atomic_fetch_dec( &(__elem->waiting));
+            }
+
+            if ( (0 != rc) && __module->log) {
+                eris_log_dump( __module->log, ERIS_LOG_NOTICE, "Module.<%s> is over max_concurrency.<%d>, service is rejected", 
+                               __elem->name, 
+                               __elem->max_concurrency);
+            }
+        }
+    }
+
+    return rc;
+}/// eris_module_bulkhead_enter
+
+
+/**
+ * @Brief: Take a running slot of module element, running is only increased under
+ *         max_concurrency with CAS.
+ *
+ * @Param: __elem, Eris module element.
+ *
+ * @Return: Taken is true, Other is false.
+ **/
+static eris_bool_t eris_module_bulkhead_take( eris_module_elem_t *__elem)
+{
+    eris_bool_t rc = false;
+
+    do {
+        eris_atomic_uint_t running = __elem->running;
+        if ( (eris_atomic_uint_t )__elem->max_concurrency <= running) { break; }
+
+        if ( eris_atomic_cmp_set( &(__elem->running), running, running + 1)) {
+            rc = true;
+
+            break;
+        }
+    } while ( 1);
+
+    return rc;
+}/// eris_module_bulkhead_take
+
+
+/**
+ * @Brief: Leave service of module element.
+ *
+ * @Param: __elem, Eris module element.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t eris_module_bulkhead_leave( eris_module_elem_t *__elem)
+{
+    if ( 0 < __elem->max_concurrency) {
+        eris_atomic_fetch_dec( &(__elem->running));
+
+        /** Waiters are counted before take, one of them gets the free slot */
+        if ( 0 < __elem->waiting) {
+            (eris_none_t )pthread_mutex_lock( &(__elem->wait_mutex));
+            (eris_none_t )pthread_cond_signal( &(__elem->wait_cond));
+            (eris_none_t )pthread_mutex_unlock( &(__elem->wait_mutex));
+        }
+    }
+}/// eris_module_bulkhead_leave
+
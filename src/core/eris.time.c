@@ -14,6 +14,18 @@
 /** Gmt time format string */
 #define ERIS_TIME_GMTFORMAT ("%a, %d %b %Y %T GMT")
 
+/** Log time format string */
+#define ERIS_TIME_LOGFORMAT ("%F %T")
+
+/** Cached gmt time slots, the reader of old slot is not overwritten at once */
+#define ERIS_TIME_GMT_SLOTS 8
+
+static eris_char_t          eris_time_gmt_slots[ ERIS_TIME_GMT_SLOTS][ ERIS_TIME_GMT_SIZE + 1];
+static eris_char_t          eris_time_log_slots[ ERIS_TIME_GMT_SLOTS][ ERIS_TIME_LOG_SIZE + 1];
+static volatile eris_time_t eris_time_gmt_sec  = -1;
+static volatile eris_uint_t eris_time_gmt_slot = 0;
+static eris_atomic_t        eris_time_gmt_lock = 0;
+
 
 /**
  * @Brief: Get now time to gmt format string.
@@ -72,7 +84,7 @@ eris_int_t eris_time_gmt2tm( eris_tm_t *__out_tm, const eris_string_t __in_gmt)
 
     if ( __out_tm && __in_gmt) {
         if ( !strptime( __in_gmt, ERIS_TIME_GMTFORMAT, __out_tm)) {
-            rc = errno;
+            rc = (0 != errno) ? errno : EERIS_INVALID;
         }
     } else { rc = EERIS_INVALID; }
 
@@ -82,3 +94,128 @@ eris_int_t eris_time_gmt2tm( eris_tm_t *__out_tm, const eris_string_t __in_gmt)
 }/// eris_time_gmt2tm
 
 
+/**
+ * @Brief: Format specify time to gmt format string.
+ *
+ * @Param: __out_gmt, Output buffer, size must be more than ERIS_TIME_GMT_SIZE.
+ * @Param: __time,    Specify time.
+ *
+ * @Return: Ok is 0, Other is EERIS_INVALID.
+ **/
+eris_int_t eris_time_gmt_format( eris_char_t *__out_gmt, eris_time_t __time)
+{
+    eris_int_t rc = 0;
+
+    if ( __out_gmt) {
+        eris_tm_t tm;
+
+#if (ERIS_HAVE_GMTIME_R)
+        (eris_none_t )gmtime_r( &__time, &tm);
+#else
+        tm = *((eris_tm_t *)gmtime( &__time));
+#endif
+
+        if ( ERIS_TIME_GMT_SIZE != strftime( __out_gmt, ERIS_TIME_GMT_SIZE + 1, ERIS_TIME_GMTFORMAT, &tm)) {
+            rc = EERIS_INVALID;
+        }
+    } else { rc = EERIS_INVALID; }
+
+    return rc;
+}/// eris_time_gmt_format
+
+
+/**
+ * @Brief: Get now time to gmt format string of cached, it is updated once per second.
+ *
+ * @Param: None.
+ *
+ * @Return: Gmt time format string, and size is ERIS_TIME_GMT_SIZE.
+ **/
+const eris_char_t *eris_time_gmt_cached( eris_none_t)
+{
+    eris_time_t t = 0;
+
+    (eris_none_t )time( &t);
+
+    if ( t != eris_time_gmt_sec) {
+        eris_bool_t is_locked = false;
+
+        if ( 0 > eris_time_gmt_sec) {
+            /** First time, must wait it */
+            eris_spinlock_acquire( &eris_time_gmt_lock, 1, 1);
+
+            is_locked = true;
+        } else {
+            /** Only one updater, and others get old value */
+            is_locked = eris_atomic_cmp_set( &eris_time_gmt_lock, 0, 1);
+        }
+
+        if ( is_locked) {
+            if ( t != eris_time_gmt_sec) {
+                eris_uint_t next_slot = (eris_time_gmt_slot + 1) % ERIS_TIME_GMT_SLOTS;
+                eris_tm_t   tm;
+
+#if (ERIS_HAVE_GMTIME_R)
+                (eris_none_t )gmtime_r( &t, &tm);
+#else
+                tm = *((eris_tm_t *)gmtime( &t));
+#endif
+
+                (eris_none_t )strftime( eris_time_gmt_slots[ next_slot], ERIS_TIME_GMT_SIZE + 1, ERIS_TIME_GMTFORMAT, &tm);
+                (eris_none_t )strftime( eris_time_log_slots[ next_slot], ERIS_TIME_LOG_SIZE + 1, ERIS_TIME_LOGFORMAT, &tm);
+
+                /** Publish new slot after it is made */
+                eris_atomic_barrier();
+
+                eris_time_gmt_slot = next_slot;
+                eris_time_gmt_sec  = t;
+            }
+
+            eris_spinlock_release( &eris_time_gmt_lock, 1);
+        }
+    }
+
+    return eris_time_gmt_slots[ eris_time_gmt_slot];
+}/// eris_time_gmt_cached
+
+
+/**
+ * @Brief: Get now time to log format string of cached, it is updated with gmt cached.
+ *
+ * @Param: None.
+ *
+ * @Return: Log time format string, and size is ERIS_TIME_LOG_SIZE.
+ **/
+const eris_char_t *eris_time_log_cached( eris_none_t)
+{
+    (eris_none_t )eris_time_gmt_cached();
+
+    return eris_time_log_slots[ eris_time_gmt_slot];
+}/// eris_time_log_cached
+
+
+/**
+ * @Brief: Get monotonic time of microseconds, it is for measuring durations.
+ *
+ * @Param: None.
+ *
+ * @Return: Microseconds since an unspecified start.
+ **/
+eris_uint64_t eris_time_mono_us( eris_none_t)
+{
+    struct timespec ts = { 0, 0};
+
+#if defined(CLOCK_MONOTONIC)
+    (eris_none_t )clock_gettime( CLOCK_MONOTONIC, &ts);
+#else
+    struct timeval tv = { 0, 0};
+
+    (eris_none_t )gettimeofday( &tv, NULL);
+
+    ts.tv_sec  = tv.tv_sec;
+    ts.tv_nsec = tv.tv_usec * 1000;
+#endif
+
+    return ((eris_uint64_t )ts.tv_sec * 1000000) + ((eris_uint64_t )ts.tv_nsec / 1000);
+}/// eris_time_mono_us
+
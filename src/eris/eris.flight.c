@@ -0,0 +1,215 @@
+/****************************************************************************//*
+ ** @CopyRight (C) 石正贤(Shizhengxian)
+ **
+ ** @Brief :
+ **        : Flight recorder of slave, every task thread has a circular ring of
+ **        : compact binary records in a mapped file, written with plain stores.
+ **        : The file is kept after slave crashed, and erishttpd-flight decodes it.
+ **
+ ******************************************************************************/
+
+#include "eris.config.h"
+
+#include "os/unix/eris.unix.h"
+
+#include "eris/erishttp.h"
+
+
+/** Mapped flight recorder file of slave */
+static eris_flight_head_t *eris_flight_head = NULL;
+static eris_size_t         eris_flight_size = 0;
+
+/** Ring of current thread, NULL is not recorded */
+static __thread eris_flight_ring_t *eris_flight_ring = NULL;
+
+
+/** Get pid of flight recorder file, Other is -1. */
+static eris_pid_t eris_flight_owner( const eris_char_t *__path);
+
+
+
+/**
+ * @Brief: Open flight recorder file of slave, old file is renamed to ".prev".
+ *         The last ring is of slave main thread, it is bound to the caller.
+ *
+ * @Param: __path,   Flight recorder file path.
+ * @Param: __slave,  Slave index.
+ * @Param: __task_n, Task threads number.
+ * @Param: __log,    Dump log message context.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+eris_int_t eris_flight_open( const eris_char_t *__path, eris_int_t __slave, eris_int_t __task_n, eris_log_t *__log)
+{
+    eris_int_t rc = 0;
+
+    if ( __path && (0 < __task_n) && !eris_flight_head) {
+        eris_size_t   flight_size = sizeof( eris_flight_head_t) + (ERIS_FLIGHT_RING_SIZE * (__task_n + 1));
+        eris_string_t prev_es     = NULL;
+
+        /** Records of crashed slave are kept in ".prev", file of draining slave of reload is
+         ** alive yet, it is kept as ".<pid>" and removed by master after it exited of drain */
+        eris_pid_t owner_pid = eris_flight_owner( __path);
+        if ( (0 < owner_pid) && (owner_pid != eris_get_pid()) && (0 == kill( owner_pid, 0))) {
+            rc = eris_string_printf( &prev_es, "%s.%i", __path, (eris_int_t )owner_pid);
+
+        } else {
+            rc = eris_string_printf( &prev_es, "%s.prev", __path);
+        }
+        if ( 0 == rc) {
+            (eris_none_t )rename( __path, prev_es);
+        }
+
+        eris_string_free( prev_es);
+
+        eris_fd_t fd = open( __path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if ( 0 <= fd) {
+            if ( 0 == ftruncate( fd, (eris_off_t )flight_size)) {
+                eris_void_t *p_map = mmap( NULL, flight_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if ( MAP_FAILED != p_map) {
+                    eris_flight_head_t *p_head = (eris_flight_head_t *)p_map;
+                    struct timeval      tv     = { 0, 0};
+
+                    (eris_none_t )gettimeofday( &tv, NULL);
+
+                    p_head->version     = ERIS_FLIGHT_VERSION;
+                    p_head->record_size = sizeof( eris_flight_record_t);
+                    p_head->records     = ERIS_FLIGHT_RECORDS;
+                    p_head->task_n      = (eris_uint32_t )__task_n + 1;
+                    p_head->pid         = (eris_int32_t )eris_get_pid();
+                    p_head->slave       = (eris_int32_t )__slave;
+                    p_head->start       = ((eris_uint64_t )tv.tv_sec * 1000000) + (eris_uint64_t )tv.tv_usec;
+
+                    /** Magic is the last, file is valid after it */
+                    eris_memory_copy( p_head->magic, ERIS_FLIGHT_MAGIC, ERIS_FLIGHT_MAGIC_SIZE);
+
+                    eris_flight_head = p_head;
+                    eris_flight_size = flight_size;
+
+                    eris_flight_ring = eris_flight_ring_at( p_head, __task_n);
+
+                    eris_flight_record( ERIS_FLIGHT_START, -1, -1, NULL);
+
+                } else { rc = EERIS_ERROR; }
+            } else { rc = EERIS_ERROR; }
+
+            /** Mapping is kept after close */
+            close( fd);
+        } else { rc = EERIS_ERROR; }
+
+        if ( (0 != rc) && __log) {
+            eris_log_dump( __log, ERIS_LOG_ERROR, "Open flight recorder.<%s> failed, errno.<%d>", __path, errno);
+        }
+    } else { rc = EERIS_ERROR; }
+
+    return rc;
+}/// eris_flight_open
+
+
+/**
+ * @Brief: Bind ring of task to current thread.
+ *
+ * @Param: __task, Task thread index.
+ *
+ * @Return: Nothing.
+ **/
+eris_none_t eris_flight_thread( eris_int_t __task)
+{
+    eris_flight_ring = NULL;
+
+    if ( eris_flight_head && (0 <= __task) && ((eris_uint32_t )__task + 1 < eris_flight_head->task_n)) {
+        eris_flight_ring = eris_flight_ring_at( eris_flight_head, __task);
+
+        eris_flight_record( ERIS_FLIGHT_START, -1, __task, NULL);
+    }
+}/// eris_flight_thread
+
+
+/**
+ * @Brief: Write a record into ring of current thread, nothing is done without ring.
+ *
+ * @Param: __code, Record code.
+ * @Param: __fd,   Client socket.
+ * @Param: __arg,  rc, status or signo.
+ * @Param: __data, Data string, NULL is none.
+ *
+ * @Return: Nothing.
+ **/
+eris_none_t eris_flight_record( eris_flight_code_t __code, eris_int32_t __fd, eris_int32_t __arg, const eris_char_t *__data)
+{
+    eris_flight_ring_t *p_ring = eris_flight_ring;
+
+    if ( p_ring) {
+        /** Only written by its thread, plain stores */
+        eris_flight_record_t *p_record = eris_flight_ring_records( p_ring) + (p_ring->seq & (ERIS_FLIGHT_RECORDS - 1));
+        struct timeval        tv       = { 0, 0};
+
+        (eris_none_t )gettimeofday( &tv, NULL);
+
+        p_record->stamp = ((eris_uint64_t )tv.tv_sec * 1000000) + (eris_uint64_t )tv.tv_usec;
+        p_record->fd    = __fd;
+        p_record->code  = (eris_uint16_t )__code;
+        p_record->arg   = __arg;
+        p_record->size  = 0;
+
+        if ( __data) {
+            eris_uint16_t size = 0;
+
+            while ( (size < ERIS_FLIGHT_DATA_SIZE) && __data[ size]) {
+                p_record->data[ size] = __data[ size];
+
+                size++;
+            }
+
+            p_record->size = size;
+        }
+
+        p_ring->seq++;
+    }
+}/// eris_flight_record
+
+
+/**
+ * @Brief: Sync flight recorder file, mapping is released at exit because task threads
+ *         maybe write it yet.
+ *
+ * @Param: None.
+ *
+ * @Return: Nothing.
+ **/
+eris_none_t eris_flight_close( eris_none_t)
+{
+    if ( eris_flight_head) {
+        eris_flight_ring = NULL;
+
+        (eris_none_t )msync( eris_flight_head, eris_flight_size, MS_ASYNC);
+    }
+}/// eris_flight_close
+
+
+/**
+ * @Brief: Get pid of flight recorder file.
+ *
+ * @Param: __path, Flight recorder file path.
+ *
+ * @Return: Ok is slave pid of file, Other is -1.
+ **/
+static eris_pid_t eris_flight_owner( const eris_char_t *__path)
+{
+    eris_pid_t rc_pid = -1;
+
+    eris_fd_t fd = open( __path, O_RDONLY);
+    if ( 0 <= fd) {
+        eris_flight_head_t head;
+
+        if ( ((eris_ssize_t )sizeof( head) == read( fd, &head, sizeof( head))) &&
+             (0 == memcmp( head.magic, ERIS_FLIGHT_MAGIC, ERIS_FLIGHT_MAGIC_SIZE))) {
+            rc_pid = (eris_pid_t )head.pid;
+        }
+
+        close( fd);
+    }
+
+    return rc_pid;
+}/// eris_flight_owner
+
@@ -0,0 +1,189 @@
+/****************************************************************************//*
+ ** @CopyRight (C) 石正贤(Shizhengxian)
+ **
+ ** @Brief :
+ **        : erishttpd-flight, decode flight recorder files of slaves to text.
+ **        :    erishttpd-flight var/log/erishttp.flight.0 [var/log/erishttp.flight.0.prev ...]
+ **
+ ******************************************************************************/
+
+#include "eris.config.h"
+
+#include "os/unix/eris.unix.h"
+
+#include "core/eris.types.h"
+#include "core/eris.errno.h"
+
+#include "eris/eris.flight.h"
+
+
+/** Names of record codes */
+static const eris_char_t *eris_flight_code_names[ ERIS_FLIGHT_CODE_N] = {
+    "start",
+    "get",
+    "parse",
+    "service",
+    "service-end",
+    "file",
+    "pack",
+    "close",
+    "signal",
+};
+
+
+/** Format realtime usec to time string. */
+static const eris_char_t *eris_flight_time( eris_char_t *__buf, eris_size_t __size, eris_uint64_t __usec);
+
+/** Decode a flight recorder file. */
+static eris_int_t eris_flight_dump( const eris_char_t *__file);
+
+
+
+/**
+ * @Brief: Decode flight recorder files of arguments.
+ *
+ * @Param: argc, Arguments count.
+ * @Param: argv, Flight recorder files.
+ *
+ * @Return: Ok is 0, Other is 1.
+ **/
+int main( int argc, char **argv)
+{
+    eris_int_t rc = 0;
+    eris_int_t i  = 0;
+
+    if ( 2 > argc) {
+        fprintf( stderr, "Usage: %s <flight file> [...]\n", argv[0]);
+
+        return 1;
+    }
+
+    for ( i = 1; i < argc; i++) {
+        if ( 0 != eris_flight_dump( argv[ i])) { rc = 1; }
+    }
+
+    return rc;
+}/// main
+
+
+/**
+ * @Brief: Decode a flight recorder file.
+ *
+ * @Param: __file, Flight recorder file.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+static eris_int_t eris_flight_dump( const eris_char_t *__file)
+{
+    eris_int_t rc = 0;
+
+    eris_fd_t fd = open( __file, O_RDONLY);
+    if ( 0 <= fd) {
+        struct stat file_info;
+
+        if ( (0 == fstat( fd, &file_info)) && ((eris_size_t )file_info.st_size >= sizeof( eris_flight_head_t))) {
+            eris_void_t *p_map = mmap( NULL, file_info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if ( MAP_FAILED != p_map) {
+                const eris_flight_head_t *p_head = (const eris_flight_head_t *)p_map;
+
+                if ( (0 != memcmp( p_head->magic, ERIS_FLIGHT_MAGIC, ERIS_FLIGHT_MAGIC_SIZE)) ||
+                     (ERIS_FLIGHT_VERSION != p_head->version) ||
+                     (sizeof( eris_flight_record_t) != p_head->record_size) ||
+                     (ERIS_FLIGHT_RECORDS != p_head->records) ||
+                     (1 > p_head->task_n) ||
+                     ((eris_size_t )file_info.st_size < (sizeof( eris_flight_head_t) + (ERIS_FLIGHT_RING_SIZE * p_head->task_n)))) {
+                    fprintf( stderr, "%s: not a flight recorder file of version.<%d>\n", __file, ERIS_FLIGHT_VERSION);
+
+                    rc = EERIS_ERROR;
+                } else {
+                    eris_char_t  time_buf[ 64];
+                    eris_uint_t  k = 0;
+
+                    printf( "%s: slave.<%d> pid.<%d> start.<%s> threads.<%u>\n",
+                            __file,
+                            p_head->slave,
+                            p_head->pid,
+                            eris_flight_time( time_buf, sizeof( time_buf), p_head->start),
+                            p_head->task_n - 1);
+
+                    for ( k = 0; k < p_head->task_n; k++) {
+                        const eris_flight_ring_t   *p_ring    = eris_flight_ring_at( p_head, k);
+                        const eris_flight_record_t *p_records = eris_flight_ring_records( p_ring);
+
+                        eris_uint64_t seq   = p_ring->seq;
+                        eris_uint64_t first = (seq > ERIS_FLIGHT_RECORDS) ? (seq - ERIS_FLIGHT_RECORDS) : 0;
+
+                        if ( k + 1 < p_head->task_n) {
+                            printf( "thread.<%u> records.<%llu>\n", k, (eris_ullong_t )seq);
+                        } else {
+                            printf( "thread.<main> records.<%llu>\n", (eris_ullong_t )seq);
+                        }
+
+                        for ( ; first < seq; first++) {
+                            const eris_flight_record_t *p_record = p_records + (first & (ERIS_FLIGHT_RECORDS - 1));
+
+                            eris_int_t data_size = (p_record->size > ERIS_FLIGHT_DATA_SIZE) ? ERIS_FLIGHT_DATA_SIZE : p_record->size;
+
+                            printf( "  %s #%llu %-11s fd.<%d> arg.<%d> \"%.*s\"\n",
+                                    eris_flight_time( time_buf, sizeof( time_buf), p_record->stamp),
+                                    (eris_ullong_t )first,
+                                    (p_record->code < ERIS_FLIGHT_CODE_N) ? eris_flight_code_names[ p_record->code] : "unknown",
+                                    p_record->fd,
+                                    p_record->arg,
+                                    data_size,
+                                    p_record->data);
+                        }
+                    }
+                }
+
+                (eris_none_t )munmap( p_map, file_info.st_size);
+
+            } else {
+                fprintf( stderr, "%s: map failed, errno.<%d>\n", __file, errno);
+
+                rc = EERIS_ERROR;
+            }
+        } else {
+            fprintf( stderr, "%s: not a flight recorder file\n", __file);
+
+            rc = EERIS_ERROR;
+        }
+
+        close( fd);
+    } else {
+        fprintf( stderr, "%s: open failed, errno.<%d>\n", __file, errno);
+
+        rc = EERIS_ERROR;
+    }
+
+    return rc;
+}/// eris_flight_dump
+
+
+/**
+ * @Brief: Format realtime usec to time string.
+ *
+ * @Param: __buf,  Output buffer.
+ * @Param: __size, Output buffer size.
+ * @Param: __usec, Realtime of usec.
+ *
+ * @Return: Output buffer.
+ **/
+static const eris_char_t *eris_flight_time( eris_char_t *__buf, eris_size_t __size, eris_uint64_t __usec)
+{
+    eris_char_t sec_buf[ 32] = {0};
+    eris_time_t t            = (eris_time_t )(__usec / 1000000);
+    eris_tm_t   tm_v;
+
+    /** Torn or corrupted stamp is out of range, raw usec is printed */
+    if ( gmtime_r( &t, &tm_v)) {
+        (eris_none_t )strftime( sec_buf, sizeof( sec_buf), "%F %H:%M:%S", &tm_v);
+
+        (eris_none_t )snprintf( __buf, __size, "%s.%06u", sec_buf, (eris_uint_t )(__usec % 1000000));
+    } else {
+        (eris_none_t )snprintf( __buf, __size, "usec.<%llu>", (eris_ullong_t )__usec);
+    }
+
+    return __buf;
+}/// eris_flight_time
+
@@ -0,0 +1,430 @@
+/****************************************************************************//*
+ ** @CopyRight (C) 石正贤(Shizhengxian)
+ **
+ ** @Brief :
+ **        : Access log format, it is compiled at startup into append
+ **        : operations of literals and variables, such as:
+ **        :    $remote_addr, $request, $status, $request_time, $http_<name>
+ **        : and a log record is made without printf format parsing.
+ **
+ ******************************************************************************/
+
+#include "eris.config.h"
+
+#include "os/unix/eris.unix.h"
+
+#include "eris/erishttp.h"
+
+
+/** Variable names of log format */
+typedef struct eris_logfmt_var_s eris_logfmt_var_t;
+struct eris_logfmt_var_s {
+    const eris_char_t  *name;
+    eris_logfmt_code_t  code;
+};
+
+static const eris_logfmt_var_t eris_logfmt_vars[] = {
+    { "remote_addr",     ERIS_LOGFMT_REMOTE_ADDR    },
+    { "remote_port",     ERIS_LOGFMT_REMOTE_PORT    },
+    { "connection",      ERIS_LOGFMT_CONNECTION     },
+    { "request",         ERIS_LOGFMT_REQUEST        },
+    { "request_method",  ERIS_LOGFMT_REQUEST_METHOD },
+    { "request_uri",     ERIS_LOGFMT_REQUEST_URI    },
+    { "server_protocol", ERIS_LOGFMT_PROTOCOL       },
+    { "status",          ERIS_LOGFMT_STATUS         },
+    { "body_bytes_sent", ERIS_LOGFMT_BODY_BYTES     },
+    { "result",          ERIS_LOGFMT_RESULT         },
+    { "request_time",    ERIS_LOGFMT_REQUEST_TIME   },
+    { "queue_time",      ERIS_LOGFMT_QUEUE_TIME     },
+    { "parse_time",      ERIS_LOGFMT_PARSE_TIME     },
+    { "service_time",    ERIS_LOGFMT_SERVICE_TIME   },
+    { "send_time",       ERIS_LOGFMT_SEND_TIME      },
+    { NULL,              ERIS_LOGFMT_LITERAL        },
+};
+
+/** Prefix of request header variable */
+#define ERIS_LOGFMT_HTTP_PREFIX      "http_"
+#define ERIS_LOGFMT_HTTP_PREFIX_SIZE (sizeof( ERIS_LOGFMT_HTTP_PREFIX) - 1)
+
+#define eris_logfmt_is_name(c)  ( (('a' <= (c)) && ('z' >= (c))) || \
+                                  (('A' <= (c)) && ('Z' >= (c))) || \
+                                  (('0' <= (c)) && ('9' >= (c))) || ('_' == (c)) )
+
+
+/** Add an append operation, string is copied. */
+static eris_int_t eris_logfmt_op_add( eris_logfmt_t *__logfmt, eris_logfmt_code_t __code, const eris_char_t *__s, eris_size_t __size);
+
+/** Append string into record buffer, NULL or empty is "-". */
+static eris_size_t eris_logfmt_append_str( eris_char_t *__buf, eris_size_t __pos, eris_size_t __size, const eris_char_t *__s, eris_size_t __n);
+
+/** Append unsigned integer into record buffer. */
+static eris_size_t eris_logfmt_append_uint( eris_char_t *__buf, eris_size_t __pos, eris_size_t __size, eris_uint64_t __v, eris_int_t __width);
+
+/** Append microseconds as seconds into record buffer. */
+static eris_size_t eris_logfmt_append_seconds( eris_char_t *__buf, eris_size_t __pos, eris_size_t __size, eris_uint64_t __usec);
+
+
+
+/**
+ * @Brief: Compile log format string into append operations.
+ *
+ * @Param: __logfmt, Output compiled log format.
+ * @Param: __format, Log format string, NULL is default format.
+ * @Param: __log,    Dump log message context.
+ *
+ * @Return: Ok is 0, Unknown variable is EERIS_INVALID, Other is EERIS_ERROR.
+ **/
+eris_int_t eris_logfmt_compile( eris_logfmt_t *__logfmt, const eris_char_t *__format, eris_log_t *__log)
+{
+    eris_int_t rc = 0;
+
+    if ( __logfmt) {
+        const eris_char_t *p_format = __format ? __format : ERIS_LOGFMT_DEFAULT;
+        const eris_char_t *p_cur    = p_format;
+        const eris_char_t *p_lit    = p_format;
+
+        __logfmt->ops_n = 0;
+        __logfmt->ops   = NULL;
+
+        /** Literals and variables, at most 2 operations of each '$' */
+        eris_size_t ops_max = 1;
+        for ( ; *p_cur; p_cur++) {
+            if ( '$' == *p_cur) { ops_max += 2; }
+        }
+
+        __logfmt->ops = (eris_logfmt_op_t *)eris_memory_calloc( ops_max, sizeof( eris_logfmt_op_t));
+        if ( !__logfmt->ops) {
+            if ( __log) {
+                eris_log_dump( __log, ERIS_LOG_ERROR, "Alloc log format operations failed, errno.<%d>", errno);
+            }
+
+            return EERIS_ERROR;
+        }
+
+        p_cur = p_format;
+        while ( (0 == rc) && *p_cur) {
+            if ( '$' != *p_cur) { p_cur++; continue; }
+
+            /** Variable name, '{' and '}' are not in config value */
+            const eris_char_t *p_name = p_cur + 1;
+            const eris_char_t *p_end  = p_name;
+
+            while ( eris_logfmt_is_name( *p_end)) { p_end++; }
+
+            if ( p_end == p_name) {
+                /** Not a variable, and "$$" is a '$' */
+                if ( '$' == p_cur[ 1]) {
+                    rc = eris_logfmt_op_add( __logfmt, ERIS_LOGFMT_LITERAL, p_lit, (p_cur + 1) - p_lit);
+
+                    p_cur += 2;
+                    p_lit  = p_cur;
+
+                } else { p_cur++; }
+
+                continue;
+            }
+
+            /** Literal before it */
+            if ( p_lit < p_cur) {
+                rc = eris_logfmt_op_add( __logfmt, ERIS_LOGFMT_LITERAL, p_lit, p_cur - p_lit);
+            }
+
+            eris_size_t name_size = p_end - p_name;
+
+            if ( 0 == rc) {
+                if ( (ERIS_LOGFMT_HTTP_PREFIX_SIZE < name_size) &&
+                     (0 == strncmp( p_name, ERIS_LOGFMT_HTTP_PREFIX, ERIS_LOGFMT_HTTP_PREFIX_SIZE))) {
+                    /** Header name, as $http_user_agent is User-Agent */
+                    rc = eris_logfmt_op_add( __logfmt, ERIS_LOGFMT_HTTP,
+                                             p_name + ERIS_LOGFMT_HTTP_PREFIX_SIZE,
+                                             name_size - ERIS_LOGFMT_HTTP_PREFIX_SIZE);
+                    if ( 0 == rc) {
+                        eris_char_t *p_hname = __logfmt->ops[ __logfmt->ops_n - 1].str;
+
+                        for ( ; *p_hname; p_hname++) {
+                            if ( '_' == *p_hname) { *p_hname = '-'; }
+                        }
+                    }
+                } else {
+                    const eris_logfmt_var_t *p_var = eris_logfmt_vars;
+
+                    for ( ; p_var->name; p_var++) {
+                        if ( (strlen( p_var->name) == name_size) && (0 == strncmp( p_var->name, p_name, name_size))) {
+                            break;
+                        }
+                    }
+
+                    if ( p_var->name) {
+                        rc = eris_logfmt_op_add( __logfmt, p_var->code, NULL, 0);
+
+                    } else {
+                        rc = EERIS_INVALID;
+
+                        if ( __log) {
+                            eris_log_dump( __log, ERIS_LOG_ERROR, "Unknown log_format variable.<$%.*s>", (eris_int_t )name_size, p_name);
+                        }
+                    }
+                }
+            }
+
+            p_cur = p_end;
+            p_lit = p_cur;
+        }
+
+        /** Literal of tail */
+        if ( (0 == rc) && (p_lit < p_cur)) {
+            rc = eris_logfmt_op_add( __logfmt, ERIS_LOGFMT_LITERAL, p_lit, p_cur - p_lit);
+        }
+
+        if ( 0 != rc) {
+            eris_logfmt_destroy( __logfmt);
+        }
+    } else { rc = EERIS_ERROR; }
+
+    return rc;
+}/// eris_logfmt_compile
+
+
+/**
+ * @Brief: Make a log record of values, it is truncated to buffer size.
+ *
+ * @Param: __logfmt, Compiled log format.
+ * @Param: __values, Values of log record.
+ * @Param: __buf,    Output record buffer, it is ended with '\0'.
+ * @Param: __size,   Output record buffer size.
+ *
+ * @Return: Record size.
+ **/
+eris_size_t eris_logfmt_make( const eris_logfmt_t *__logfmt, const eris_logfmt_values_t *__values, eris_char_t *__buf, eris_size_t __size)
+{
+    eris_size_t pos = 0;
+
+    if ( __logfmt && __values && __buf && (0 < __size)) {
+        /** Keep a byte of '\0' */
+        eris_size_t size = __size - 1;
+        eris_int_t  i    = 0;
+
+        for ( i = 0; (i < __logfmt->ops_n) && (pos < size); i++) {
+            const eris_logfmt_op_t *p_op = &(__logfmt->ops[ i]);
+
+            switch ( p_op->code) {
+                case ERIS_LOGFMT_LITERAL :
+                    {
+                        pos = eris_logfmt_append_str( __buf, pos, size, p_op->str, p_op->size);
+                    } break;
+                case ERIS_LOGFMT_REMOTE_ADDR :
+                    {
+                        pos = eris_logfmt_append_str( __buf, pos, size, __values->remote_addr, 0);
+                    } break;
+                case ERIS_LOGFMT_REMOTE_PORT :
+                    {
+                        pos = eris_logfmt_append_uint( __buf, pos, size, (eris_uint64_t )__values->remote_port, 0);
+                    } break;
+                case ERIS_LOGFMT_CONNECTION :
+                    {
+                        pos = eris_logfmt_append_uint( __buf, pos, size, (eris_uint64_t )__values->connection, 0);
+                    } break;
+                case ERIS_LOGFMT_REQUEST :
+                    {
+                        pos = eris_logfmt_append_str( __buf, pos, size, __values->method, 0);
+                        pos = eris_logfmt_append_str( __buf, pos, size, " ", 1);
+                        pos = eris_logfmt_append_str( __buf, pos, size, __values->uri, 0);
+                        pos = eris_logfmt_append_str( __buf, pos, size, " ", 1);
+                        pos = eris_logfmt_append_str( __buf, pos, size, __values->protocol, 0);
+                    } break;
+                case ERIS_LOGFMT_REQUEST_METHOD :
+                    {
+                        pos = eris_logfmt_append_str( __buf, pos, size, __values->method, 0);
+                    } break;
+                case ERIS_LOGFMT_REQUEST_URI :
+                    {
+                        pos = eris_logfmt_append_str( __buf, pos, size, __values->uri, 0);
+                    } break;
+                case ERIS_LOGFMT_PROTOCOL :
+                    {
+                        pos = eris_logfmt_append_str( __buf, pos, size, __values->protocol, 0);
+                    } break;
+                case ERIS_LOGFMT_STATUS :
+                    {
+                        pos = eris_logfmt_append_uint( __buf, pos, size, (eris_uint64_t )__values->status, 0);
+                    } break;
+                case ERIS_LOGFMT_BODY_BYTES :
+                    {
+                        pos = eris_logfmt_append_uint( __buf, pos, size, (eris_uint64_t )__values->body_bytes, 0);
+                    } break;
+                case ERIS_LOGFMT_RESULT :
+                    {
+                        pos = eris_logfmt_append_str( __buf, pos, size, __values->result, 0);
+                    } break;
+                case ERIS_LOGFMT_REQUEST_TIME :
+                    {
+                        pos = eris_logfmt_append_seconds( __buf, pos, size, __values->request_us);
+                    } break;
+                case ERIS_LOGFMT_QUEUE_TIME :
+                    {
+                        pos = eris_logfmt_append_seconds( __buf, pos, size, __values->queue_us);
+                    } break;
+                case ERIS_LOGFMT_PARSE_TIME :
+                    {
+                        pos = eris_logfmt_append_seconds( __buf, pos, size, __values->parse_us);
+                    } break;
+                case ERIS_LOGFMT_SERVICE_TIME :
+                    {
+                        pos = eris_logfmt_append_seconds( __buf, pos, size, __values->service_us);
+                    } break;
+                case ERIS_LOGFMT_SEND_TIME :
+                    {
+                        pos = eris_logfmt_append_seconds( __buf, pos, size, __values->send_us);
+                    } break;
+                case ERIS_LOGFMT_HTTP :
+                    {
+                        const eris_string_t value_es = eris_http_request_get_header( __values->http, p_op->str);
+
+                        pos = eris_logfmt_append_str( __buf, pos, size, value_es, value_es ? eris_string_size( value_es) : 0);
+                    } break;
+                default : break;
+            }
+        }
+
+        __buf[ pos] = '\0';
+    }
+
+    return pos;
+}/// eris_logfmt_make
+
+
+/**
+ * @Brief: Destroy compiled log format.
+ *
+ * @Param: __logfmt, Compiled log format.
+ *
+ * @Return: Nothing.
+ **/
+eris_none_t eris_logfmt_destroy( eris_logfmt_t *__logfmt)
+{
+    if ( __logfmt) {
+        eris_int_t i = 0;
+
+        for ( i = 0; i < __logfmt->ops_n; i++) {
+            eris_memory_free( __logfmt->ops[ i].str);
+        }
+
+        eris_memory_free( __logfmt->ops);
+
+        __logfmt->ops_n = 0;
+    }
+}/// eris_logfmt_destroy
+
+
+/**
+ * @Brief: Add an append operation, string is copied.
+ *
+ * @Param: __logfmt, Compiled log format.
+ * @Param: __code,   Operation code.
+ * @Param: __s,      Literal or header name, NULL is none.
+ * @Param: __size,   String size.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+static eris_int_t eris_logfmt_op_add( eris_logfmt_t *__logfmt, eris_logfmt_code_t __code, const eris_char_t *__s, eris_size_t __size)
+{
+    eris_int_t        rc   = 0;
+    eris_logfmt_op_t *p_op = &(__logfmt->ops[ __logfmt->ops_n]);
+
+    p_op->code = __code;
+    p_op->size = 0;
+    p_op->str  = NULL;
+
+    if ( __s) {
+        p_op->str = (eris_char_t *)eris_memory_alloc( __size + 1);
+        if ( p_op->str) {
+            eris_memory_copy( p_op->str, __s, __size);
+
+            p_op->str[ __size] = '\0';
+            p_op->size         = __size;
+
+        } else { rc = EERIS_ERROR; }
+    }
+
+    if ( 0 == rc) {
+        __logfmt->ops_n++;
+    }
+
+    return rc;
+}/// eris_logfmt_op_add
+
+
+/**
+ * @Brief: Append string into record buffer, NULL or empty is "-".
+ *
+ * @Param: __buf,  Record buffer.
+ * @Param: __pos,  Current size of record.
+ * @Param: __size, Max size of record.
+ * @Param: __s,    String.
+ * @Param: __n,    String size, 0 is strlen.
+ *
+ * @Return: Current size of record.
+ **/
+static eris_size_t eris_logfmt_append_str( eris_char_t *__buf, eris_size_t __pos, eris_size_t __size, const eris_char_t *__s, eris_size_t __n)
+{
+    if ( !__s || ('\0' == *__s)) {
+        __s = "-";
+        __n = 1;
+
+    } else if ( 0 == __n) { __n = strlen( __s); }
+
+    if ( __n > (__size - __pos)) {
+        __n = __size - __pos;
+    }
+
+    eris_memory_copy( __buf + __pos, __s, __n);
+
+    return __pos + __n;
+}/// eris_logfmt_append_str
+
+
+/**
+ * @Brief: Append unsigned integer into record buffer.
+ *
+ * @Param: __buf,   Record buffer.
+ * @Param: __pos,   Current size of record.
+ * @Param: __size,  Max size of record.
+ * @Param: __v,     Integer value.
+ * @Param: __width, Min width padded with '0'.
+ *
+ * @Return: Current size of record.
+ **/
+static eris_size_t eris_logfmt_append_uint( eris_char_t *__buf, eris_size_t __pos, eris_size_t __size, eris_uint64_t __v, eris_int_t __width)
+{
+    eris_char_t  digits[ 24];
+    eris_char_t *p_digit = digits + sizeof( digits);
+
+    do {
+        *(--p_digit) = (eris_char_t )('0' + (__v % 10));
+
+        __v /= 10;
+        __width--;
+    } while ( (0 < __v) || (0 < __width));
+
+    return eris_logfmt_append_str( __buf, __pos, __size, p_digit, (digits + sizeof( digits)) - p_digit);
+}/// eris_logfmt_append_uint
+
+
+/**
+ * @Brief: Append microseconds as seconds into record buffer.
+ *
+ * @Param: __buf,  Record buffer.
+ * @Param: __pos,  Current size of record.
+ * @Param: __size, Max size of record.
+ * @Param: __usec, Microseconds.
+ *
+ * @Return: Current size of record.
+ **/
+static eris_size_t eris_logfmt_append_seconds( eris_char_t *__buf, eris_size_t __pos, eris_size_t __size, eris_uint64_t __usec)
+{
+    __pos = eris_logfmt_append_uint( __buf, __pos, __size, __usec / 1000000, 0);
+    __pos = eris_logfmt_append_str( __buf, __pos, __size, ".", 1);
+
+    return eris_logfmt_append_uint( __buf, __pos, __size, __usec % 1000000, 6);
+}/// eris_logfmt_append_seconds
+
@@ -0,0 +1,361 @@
+/****************************************************************************//*
+ ** @CopyRight (C) 石正贤(Shizhengxian)
+ **
+ ** @Brief :
+ **        : Rate limit of client addresses, a fixed-size hash table of token
+ **        : buckets in shared memory, mapped by master before fork and taken
+ **        : by event threads of all slaves without locks.
+ **
+ ******************************************************************************/
+
+#include "eris.config.h"
+
+#include "os/unix/eris.unix.h"
+
+#include "eris/erishttp.h"
+
+
+/** Find slot of address, free or idle slot is taken, NULL is not found. */
+static eris_ratelimit_slot_t *eris_ratelimit_slot( eris_ratelimit_t *__ratelimit, eris_uint32_t __addr, eris_bool_t __take, eris_uint32_t __now);
+
+/** Ledger of this slave, NULL is not tracked */
+static eris_ratelimit_ledger_t *eris_ratelimit_held = NULL;
+
+
+
+/**
+ * @Brief: Create shared rate limit, it is done in master before slaves spawned.
+ *
+ * @Param: __rate,    Requests of second of an address, 0 is off.
+ * @Param: __burst,   Bucket size, 0 is same as rate.
+ * @Param: __conns,   Requests in handling of an address, 0 is off.
+ * @Param: __slave_n, Slaves, a running and a draining slave of each have ledgers.
+ * @Param: __log,     Dump log message context.
+ *
+ * @Return: Ok is shared rate limit, Other is NULL.
+ **/
+eris_ratelimit_t *eris_ratelimit_create( eris_uint32_t __rate, eris_uint32_t __burst, eris_uint32_t __conns, eris_int_t __slave_n, eris_log_t *__log)
+{
+    eris_ratelimit_t *rc_ratelimit = NULL;
+
+    if ( (0 < __rate) || (0 < __conns)) {
+        /** Ledgers are only of conns limit */
+        eris_int_t  ledger_n       = ((0 < __conns) && (0 < __slave_n)) ? (__slave_n * 2) : 0;
+        eris_size_t ratelimit_size = sizeof( eris_ratelimit_t) + (sizeof( eris_ratelimit_ledger_t) * ledger_n);
+
+        /** Anonymous map is zero filled, all slots and ledgers are free */
+        rc_ratelimit = (eris_ratelimit_t *)mmap( NULL, ratelimit_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if ( MAP_FAILED != rc_ratelimit) {
+            if ( 0 == __burst) { __burst = __rate; }
+
+            if ( ERIS_RATELIMIT_BURST_MAX < __burst) { __burst = ERIS_RATELIMIT_BURST_MAX; }
+
+            rc_ratelimit->rate     = __rate;
+            rc_ratelimit->burst    = __burst;
+            rc_ratelimit->conns    = __conns;
+            rc_ratelimit->ledger_n = ledger_n;
+            rc_ratelimit->size     = ratelimit_size;
+
+        } else {
+            rc_ratelimit = NULL;
+
+            if ( __log) {
+                eris_log_dump( __log, ERIS_LOG_ERROR, "Map shared rate limit failed, errno.<%d>", errno);
+            }
+        }
+    }
+
+    return rc_ratelimit;
+}/// eris_ratelimit_create
+
+
+/**
+ * @Brief: Get IPv4 address of client socket.
+ *
+ * @Param: __sock, Client socket.
+ *
+ * @Return: Ok is address of network order, Other is 0.
+ **/
+eris_uint32_t eris_ratelimit_addr( eris_sock_t __sock)
+{
+    eris_uint32_t rc_addr = 0;
+
+    struct sockaddr_in sock_addr;
+    eris_socklen_t     sock_addr_size = sizeof( struct sockaddr_in);
+
+    eris_memory_cleanup( &sock_addr, sock_addr_size);
+
+    if ( (0 <= __sock) && (0 == getpeername( __sock, (struct sockaddr *)&sock_addr, &sock_addr_size))) {
+        if ( AF_INET == sock_addr.sin_family) {
+            rc_addr = (eris_uint32_t )sock_addr.sin_addr.s_addr;
+        }
+    }
+
+    return rc_addr;
+}/// eris_ratelimit_addr
+
+
+/**
+ * @Brief: Take a token and a connection of client address, a connection is released
+ *         by eris_ratelimit_release after request.
+ *
+ * @Param: __ratelimit, Shared rate limit.
+ * @Param: __addr,      Client address.
+ *
+ * @Return: Admitted is -1, Other is limit reason of ERIS_STATS_LIMIT_*.
+ **/
+eris_int_t eris_ratelimit_acquire( eris_ratelimit_t *__ratelimit, eris_uint32_t __addr)
+{
+    eris_int_t rc = -1;
+
+    if ( __ratelimit && (0 != __addr)) {
+        eris_uint32_t now = (eris_uint32_t )(eris_time_mono_us() / 1000);
+
+        /** Address is admitted when its probes are all taken */
+        eris_ratelimit_slot_t *p_slot = eris_ratelimit_slot( __ratelimit, __addr, true, now);
+        if ( p_slot) {
+            if ( 0 < __ratelimit->conns) {
+                if ( __ratelimit->conns <= eris_atomic_fetch_inc( &(p_slot->conns))) {
+                    eris_atomic_fetch_dec( &(p_slot->conns));
+
+                    rc = ERIS_STATS_LIMIT_CONNS;
+                }
+            }
+
+            if ( -1 == rc) {
+                eris_uint64_t full_tokens = (eris_uint64_t )__ratelimit->burst * 1000;
+
+                /** Tokens are filled of elapsed ms, and a token is taken with CAS of other slaves */
+                do {
+                    eris_uint64_t old_bucket = p_slot->bucket;
+                    eris_uint64_t tokens     = full_tokens;
+
+                    if ( 0 != old_bucket) {
+                        eris_uint32_t elapsed = now - (eris_uint32_t )old_bucket;
+
+                        tokens = (old_bucket >> 32) + ((eris_uint64_t )elapsed * __ratelimit->rate);
+                        if ( full_tokens < tokens) { tokens = full_tokens; }
+                    }
+
+                    if ( 0 < __ratelimit->rate) {
+                        if ( 1000 > tokens) {
+                            rc = ERIS_STATS_LIMIT_RATE;
+
+                            break;
+                        }
+
+                        tokens -= 1000;
+                    }
+
+                    eris_uint64_t new_bucket = (tokens << 32) | now;
+                    if ( 0 == new_bucket) { new_bucket = 1; }
+
+                    if ( eris_atomic_cmp_set( &(p_slot->bucket), old_bucket, new_bucket)) { break; }
+
+                    eris_atomic_cpu_pause();
+                } while ( 1);
+
+                if ( (ERIS_STATS_LIMIT_RATE == rc) && (0 < __ratelimit->conns)) {
+                    eris_atomic_fetch_dec( &(p_slot->conns));
+                }
+            }
+
+            /** Connection is held by this slave until released */
+            if ( (-1 == rc) && (0 < __ratelimit->conns) && eris_ratelimit_held) {
+                eris_atomic_fetch_inc( &(eris_ratelimit_held->held[ p_slot - __ratelimit->slots]));
+            }
+        }
+    }
+
+    return rc;
+}/// eris_ratelimit_acquire
+
+
+/**
+ * @Brief: Release a connection of client address.
+ *
+ * @Param: __ratelimit, Shared rate limit.
+ * @Param: __addr,      Client address.
+ *
+ * @Return: Nothing.
+ **/
+eris_none_t eris_ratelimit_release( eris_ratelimit_t *__ratelimit, eris_uint32_t __addr)
+{
+    if ( __ratelimit && (0 < __ratelimit->conns) && (0 != __addr)) {
+        eris_ratelimit_slot_t *p_slot = eris_ratelimit_slot( __ratelimit, __addr, false, 0);
+        if ( p_slot) {
+            /** Admitted without slot is not counted, it is never under 0 */
+            do {
+                eris_atomic_uint_t old_conns = p_slot->conns;
+                if ( 0 == old_conns) { break; }
+
+                if ( eris_atomic_cmp_set( &(p_slot->conns), old_conns, old_conns - 1)) { break; }
+            } while ( 1);
+
+            if ( eris_ratelimit_held) {
+                eris_atomic_t *p_held = &(eris_ratelimit_held->held[ p_slot - __ratelimit->slots]);
+
+                do {
+                    eris_atomic_uint_t old_held = *p_held;
+                    if ( 0 == old_held) { break; }
+
+                    if ( eris_atomic_cmp_set( p_held, old_held, old_held - 1)) { break; }
+                } while ( 1);
+            }
+        }
+    }
+}/// eris_ratelimit_release
+
+
+/**
+ * @Brief: Take a free ledger of this slave, connections of addresses held by it are
+ *         given back by master of its exit. It is done in slave after fork.
+ *
+ * @Param: __ratelimit, Shared rate limit.
+ * @Param: __pid,       Pid of this slave.
+ *
+ * @Return: Ok is 0, No free ledger is EERIS_ERROR, held connections are not tracked.
+ **/
+eris_int_t eris_ratelimit_ledger_take( eris_ratelimit_t *__ratelimit, eris_pid_t __pid)
+{
+    eris_int_t rc = EERIS_ERROR;
+
+    eris_ratelimit_held = NULL;
+
+    if ( __ratelimit && (0 < __pid)) {
+        eris_int_t i = 0;
+        for ( i = 0; i < __ratelimit->ledger_n; i++) {
+            eris_ratelimit_ledger_t *p_ledger = eris_ratelimit_ledger( __ratelimit, i);
+
+            /** Ledger of a reaped slave is given back and cleared by master */
+            if ( (0 == p_ledger->pid) && eris_atomic_cmp_set( &(p_ledger->pid), 0, __pid)) {
+                eris_ratelimit_held = p_ledger;
+
+                rc = 0; break;
+            }
+        }
+    }
+
+    return rc;
+}/// eris_ratelimit_ledger_take
+
+
+/**
+ * @Brief: Give back connections of addresses held by a dead slave, its ledger is free.
+ *         It is done in master after the slave is reaped.
+ *
+ * @Param: __ratelimit, Shared rate limit.
+ * @Param: __pid,       Pid of reaped slave.
+ *
+ * @Return: Connections given back.
+ **/
+eris_uint_t eris_ratelimit_reclaim( eris_ratelimit_t *__ratelimit, eris_pid_t __pid)
+{
+    eris_uint_t rc_conns = 0;
+
+    if ( __ratelimit && (0 < __pid)) {
+        eris_int_t i = 0;
+        for ( i = 0; i < __ratelimit->ledger_n; i++) {
+            eris_ratelimit_ledger_t *p_ledger = eris_ratelimit_ledger( __ratelimit, i);
+
+            if ( __pid == p_ledger->pid) {
+                eris_int_t j = 0;
+                for ( j = 0; j < ERIS_RATELIMIT_SLOTS; j++) {
+                    eris_atomic_uint_t held = p_ledger->held[ j];
+
+                    if ( 0 < held) {
+                        eris_ratelimit_slot_t *p_slot = &(__ratelimit->slots[ j]);
+
+                        /** Slaves alive take and release it, it is never under 0 */
+                        do {
+                            eris_atomic_uint_t old_conns = p_slot->conns;
+                            eris_atomic_uint_t new_conns = (held < old_conns) ? (old_conns - held) : 0;
+
+                            if ( eris_atomic_cmp_set( &(p_slot->conns), old_conns, new_conns)) { break; }
+                        } while ( 1);
+
+                        p_ledger->held[ j] = 0;
+                        rc_conns += (eris_uint_t )held;
+                    }
+                }
+
+                /** Free of other slave at last */
+                eris_atomic_barrier();
+                p_ledger->pid = 0;
+
+                break;
+            }
+        }
+    }
+
+    return rc_conns;
+}/// eris_ratelimit_reclaim
+
+
+/**
+ * @Brief: Destroy shared rate limit.
+ *
+ * @Param: __ratelimit, Shared rate limit.
+ *
+ * @Return: Nothing.
+ **/
+eris_none_t eris_ratelimit_destroy( eris_ratelimit_t *__ratelimit)
+{
+    if ( __ratelimit) {
+        (eris_none_t )munmap( __ratelimit, __ratelimit->size);
+    }
+}/// eris_ratelimit_destroy
+
+
+/**
+ * @Brief: Find slot of address in its probes, free or idle slot is taken.
+ *
+ * @Param: __ratelimit, Shared rate limit.
+ * @Param: __addr,      Client address.
+ * @Param: __take,      Take a slot when not found.
+ * @Param: __now,       Monotonic ms.
+ *
+ * @Return: Ok is slot, Other is NULL.
+ **/
+static eris_ratelimit_slot_t *eris_ratelimit_slot( eris_ratelimit_t *__ratelimit, eris_uint32_t __addr, eris_bool_t __take, eris_uint32_t __now)
+{
+    eris_ratelimit_slot_t *rc_slot   = NULL;
+    eris_ratelimit_slot_t *idle_slot = NULL;
+
+    eris_uint32_t hash = __addr * 2654435761U;
+    hash ^= (hash >> 15);
+
+    eris_int_t i = 0;
+    for ( i = 0; (i < ERIS_RATELIMIT_PROBES) && !rc_slot; i++) {
+        eris_ratelimit_slot_t *p_slot = &(__ratelimit->slots[ (hash + i) & (ERIS_RATELIMIT_SLOTS - 1)]);
+
+        eris_uint32_t slot_addr = p_slot->addr;
+        if ( __addr == slot_addr) {
+            rc_slot = p_slot;
+
+        } else if ( 0 == slot_addr) {
+            if ( !__take) { break; }
+
+            /** Free slot is taken by any slave, other maybe takes it of same address */
+            if ( eris_atomic_cmp_set( &(p_slot->addr), 0, __addr) || (__addr == p_slot->addr)) {
+                rc_slot = p_slot;
+            }
+        } else if ( __take && !idle_slot && (0 == p_slot->conns) && (ERIS_RATELIMIT_IDLE < (__now - (eris_uint32_t )p_slot->bucket))) {
+            idle_slot = p_slot;
+        }
+    }
+
+    /** Idle slot of other address is taken with a full bucket */
+    if ( !rc_slot && idle_slot) {
+        eris_uint32_t slot_addr = idle_slot->addr;
+
+        if ( (0 == idle_slot->conns) && eris_atomic_cmp_set( &(idle_slot->addr), slot_addr, __addr)) {
+            idle_slot->bucket = 0;
+
+            rc_slot = idle_slot;
+        }
+    }
+
+    return rc_slot;
+}/// eris_ratelimit_slot
+
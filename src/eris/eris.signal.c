@@ -96,21 +96,43 @@ static eris_none_t eris_signal_handler( eris_int_t __signo)
 
     switch ( __signo) {
         case SIGHUP  : 
-            { /** nothing */} break;
+            {
+                /** Reload of config is done by supervisor thread of master */
+                if ( eris_get_pid() == p_erishttp_context->ppid) {
+                    p_erishttp_context->reload = 1;
+                }
+            } break;
         case SIGUSR1 : 
             { /** nothing */} break;
         case SIGUSR2 : 
-            { /** nothing */} break;
+            {
+                /** Binary upgrade is done by supervisor thread of master */
+                if ( eris_get_pid() == p_erishttp_context->ppid) {
+                    p_erishttp_context->upgrade = 1;
+                }
+            } break;
         case SIGCHLD : 
-            { /** Nothing */} break;
+            { /** Reaped by supervisor thread of master */} break;
         case SIGQUIT : 
         case SIGTERM : 
         case SIGSEGV : 
                 { 
-                    if ( eris_get_pid() != p_erishttp_context->ppid) {
+                    /** Last record of thread, it is the crashed thread of SIGSEGV */
+                    eris_flight_record( ERIS_FLIGHT_SIGNAL, -1, __signo, NULL);
+
+                    /** Crashed slave is not destroyed, it dies of default action and master respawns it */
+                    if ( (SIGSEGV == __signo) && (eris_get_pid() != p_erishttp_context->ppid)) {
+                        (eris_none_t )signal( SIGSEGV, SIG_DFL);
+                        (eris_none_t )raise( SIGSEGV);
 
-                        erishttp_destroy( true);
+                        break;
+                    }
+
+                    /** Slave stops accepts and exits after busy sockets, it is done in event thread */
+                    if ( eris_get_pid() != p_erishttp_context->ppid) {
+                        p_erishttp_context->quit = 1;
 
+                        break;
                     } else {
                         erishttp_destroy( false);
                     }
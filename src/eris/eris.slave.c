@@ -17,6 +17,62 @@
 
 #include "eris/erishttp.h"
 
+#if (ERIS_HAVE_LINUX_OPENAT2_H)
+#include <linux/openat2.h>
+#include <sys/syscall.h>
+#endif
+
+
+/** Negative lookup cache of static files, two ways of each hash slot */
+#define ERIS_SLAVE_MISS_SLOTS    (1024)
+#define ERIS_SLAVE_MISS_PATH_MAX (128)
+
+typedef struct eris_slave_miss_s eris_slave_miss_t;
+struct eris_slave_miss_s {
+    eris_uint32_t      hash;
+    eris_bool_t        watched;        /** doc_root was watched  */
+    eris_atomic_uint_t all_gen;        /** Watch generations     */
+    eris_atomic_uint_t path_gen;
+    eris_time_t        expire;         /** Not watched expire    */
+    eris_char_t        path[ ERIS_SLAVE_MISS_PATH_MAX];
+};
+
+static eris_atomic_t     eris_slave_miss_lock = 0;
+static eris_slave_miss_t eris_slave_misses[ ERIS_SLAVE_MISS_SLOTS];
+
+
+/** Shared counters of current task thread, NULL is not counted. Slots are also
+ ** of the same thread of new slave while this slave drains, so adds are atomic. */
+static __thread eris_stats_thread_t *eris_slave_stats = NULL;
+
+#define eris_slave_stats_add(field, n) \
+    do { \
+        if ( eris_slave_stats) { (eris_none_t )eris_atomic_fetch_add( &(eris_slave_stats->field), (n)); } \
+    } while (0)
+
+/** Stage timings of current request, microseconds */
+typedef struct eris_slave_timing_s eris_slave_timing_t;
+struct eris_slave_timing_s {
+    eris_uint64_t      queued;         /** Put into event queue  */
+    eris_uint64_t      queue;          /** Wait in event queue   */
+    eris_uint64_t      parse;          /** Request parse         */
+    eris_uint64_t      service;        /** Module service        */
+    eris_uint64_t      send;           /** Response pack         */
+};
+
+static __thread eris_slave_timing_t eris_slave_timing;
+
+/** End of a stage, it is saved and recorded into histogram */
+#define eris_slave_stage_end(field, hist, start) \
+    do { \
+        eris_uint64_t stage_d = eris_time_mono_us() - (start); \
+        eris_slave_timing.field += stage_d; \
+        eris_stats_hist_record( eris_slave_stats, (hist), stage_d); \
+    } while (0)
+
+/** Microseconds as arguments of "%lu.%06lu" seconds */
+#define eris_slave_seconds(us) (eris_ulong_t )((us) / 1000000), (eris_ulong_t )((us) % 1000000)
+
 
 /** eris slave request input callback of http parse. */
 static eris_int_t 
@@ -26,9 +82,38 @@ eris_slave_request_incb( eris_buffer_t *__out_buf, eris_size_t __max_size, eris_
 static eris_int_t 
 eris_slave_response_outcb( eris_buffer_t *__in_buf, eris_size_t __in_size, eris_arg_t __arg, eris_log_t *__log);
 
+/** eris slave response file output cb of http response pack. */
+static eris_int_t 
+eris_slave_response_filecb( eris_fd_t __fd, eris_off_t __offset, eris_size_t __size, eris_arg_t __arg, eris_log_t *__log);
+
 /** Set http response base headers. */
 static eris_int_t eris_slave_set_response_headers( eris_http_t *__http_context, eris_bool_t __keep_alive);
 
+/** Set validators of file, and check request conditions. */
+static eris_int_t eris_slave_file_validate( eris_http_t *__http, const eris_stat_t *__file_info);
+
+/** Normalize request url to file path relative to doc_root. */
+static eris_int_t eris_slave_file_path( const eris_char_t *__url, eris_char_t *__path, eris_size_t __size);
+
+/** Open regular file relative to doc_root, and get its information. */
+static eris_int_t eris_slave_file_open( const eris_char_t *__path, eris_fd_t *__fd, eris_stat_t *__file_info);
+
+/** Open path beneath doc_root, no component of it is a symlink. */
+static eris_fd_t eris_slave_file_openat( const eris_char_t *__path);
+
+/** Check precompressed sidecar file of static file. */
+static eris_bool_t eris_slave_file_gzip_static( eris_http_t *__http, const eris_char_t *__path, const eris_stat_t *__file_info, 
+                                                eris_fd_t *__gz_fd, eris_stat_t *__gz_file_info);
+
+/** Make negative lookup entry of path before file system lookup. */
+static eris_bool_t eris_slave_miss_make( eris_slave_miss_t *__miss, const eris_char_t *__path);
+
+/** Find path in negative lookup cache of static files. */
+static eris_bool_t eris_slave_miss_find( const eris_char_t *__path);
+
+/** Add entry to negative lookup cache of static files. */
+static eris_none_t eris_slave_miss_add( const eris_slave_miss_t *__miss);
+
 /** Get file of specify request url. */
 static eris_int_t eris_slave_get_file( eris_http_t *__http);
 
@@ -69,12 +154,38 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
     eris_event_elem_t ev_elt; {
         ev_elt.sock   = -1;
         ev_elt.events = 0;
+        ev_elt.stamp  = 0;
     }
 
+    /** Start time of measured stage */
+    eris_uint64_t stage_us = 0;
+
     eris_bool_t is_keepalive     = false;
     eris_size_t content_length_v = 0;
     eris_socket_host_t client_host;
 
+    /** Counters of this task thread, its index is of http context */
+    eris_slave_stats = eris_stats_thread( p_erishttp_context->stats, 
+                                          p_erishttp_context->slave_index, 
+                                          (eris_int_t )(http_context - p_erishttp_context->tasks_http));
+
+    /** Flight recorder ring of this task thread */
+    eris_flight_thread( (eris_int_t )(http_context - p_erishttp_context->tasks_http));
+
+    /** Process signals interrupt the event thread, drain and reload are woken at once */
+    {
+        sigset_t block_set;
+        sigemptyset( &block_set);
+        sigaddset( &block_set, SIGHUP);
+        sigaddset( &block_set, SIGUSR1);
+        sigaddset( &block_set, SIGUSR2);
+        sigaddset( &block_set, SIGQUIT);
+        sigaddset( &block_set, SIGTERM);
+        sigaddset( &block_set, SIGCHLD);
+
+        (eris_none_t )pthread_sigmask( SIG_BLOCK, &block_set, NULL);
+    }
+
     do {
         switch ( eris_slave_state_v) {
             case ERIS_SLAVE_GET_WAIT :
@@ -87,6 +198,8 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
                     {
                         ev_elt.sock   = -1;
                         ev_elt.events = 0;
+                        ev_elt.addr   = 0;
+                        ev_elt.stamp  = 0;
                     }
 
                     /** Get event element */
@@ -97,6 +210,24 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
                         if ( 0 <= ev_elt.sock ) {
                             eris_socket_host( ev_elt.sock, &client_host);
 
+                            /** Flag is of the new slave while this slave drains */
+                            if ( eris_slave_stats && !(p_erishttp_context->draining)) { eris_slave_stats->active = 1; }
+
+                            /** Draining slave waits busy sockets */
+                            eris_atomic_fetch_inc( &(p_erishttp_context->busy));
+
+                            eris_flight_record( ERIS_FLIGHT_GET, ev_elt.sock, ev_elt.events, client_host.ipv4);
+
+                            /** Timings of new request, and wait time in event queue */
+                            eris_memory_cleanup( &eris_slave_timing, sizeof( eris_slave_timing));
+
+                            if ( ev_elt.stamp) {
+                                eris_slave_timing.queued = ev_elt.stamp;
+
+                                eris_slave_stage_end( queue, ERIS_STATS_HIST_QUEUE, ev_elt.stamp);
+
+                            } else { eris_slave_timing.queued = eris_time_mono_us(); }
+
                             if ( ERIS_EVENT_OOB & ev_elt.events) {
                                 eris_slave_state_v = ERIS_SLAVE_IS_OOB;
 
@@ -137,7 +268,13 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
                     //eris_log_dump( &(p_erishttp_context->errors_log), ERIS_LOG_NOTICE, "Pid.<%d> - http parse sock.<%d>", eris_get_pid(), ev_elt.sock);
 
                     /** Get data and parse */
+                    stage_us = eris_time_mono_us();
+
                     rc = eris_http_request_parse( http_context, eris_slave_request_incb, &ev_elt);
+
+                    eris_slave_stage_end( parse, ERIS_STATS_HIST_PARSE, stage_us);
+
+                    eris_flight_record( ERIS_FLIGHT_PARSE, ev_elt.sock, rc, eris_http_request_get_url( http_context));
                     if ( 0 == rc) {
 #if 0
                         if ( eris_http_request_keep_alive( http_context) ) {
@@ -237,11 +374,42 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
                          (ERIS_HTTP_PATCH  == http_context->request.command) ||
                          (ERIS_HTTP_POST   == http_context->request.command) ||
                          (ERIS_HTTP_PUT    == http_context->request.command) ) {
+                        /** Base headers and output of streaming response */
+                        (eris_none_t )eris_http_response_set_outcb( http_context, eris_slave_response_outcb, &ev_elt);
+                        (eris_none_t )eris_http_response_set_filecb( http_context, eris_slave_response_filecb);
+                        (eris_none_t )eris_slave_set_response_headers( http_context, is_keepalive);
+
                         /** Call module service */
+                        eris_flight_record( ERIS_FLIGHT_SERVICE, ev_elt.sock, http_context->request.command, eris_http_request_get_url( http_context));
+
+                        stage_us = eris_time_mono_us();
+
                         rc = eris_module_exec( &(p_erishttp_context->mcontext), 
                                                eris_http_request_get_url( http_context), 
                                                http_context);
-                        if ( 0 == rc) {
+                        eris_flight_record( ERIS_FLIGHT_SERVICE_END, ev_elt.sock, rc, NULL);
+
+                        /** Rejected of max_concurrency is not a call of module */
+                        if ( (EERIS_NOTFOUND != rc) && (EERIS_FULL != rc)) {
+                            eris_slave_stage_end( service, ERIS_STATS_HIST_MODULE, stage_us);
+                            eris_slave_stats_add( module_calls, 1);
+
+                            if ( (0 != rc) && (EERIS_4XX != rc)) {
+                                eris_slave_stats_add( module_errors, 1);
+                            }
+                        }
+                        if ( eris_http_response_streaming( http_context)) {
+                            /** Head is sent, and end it or close broken response */
+                            if ( (0 == rc) && (0 == eris_http_response_finish( http_context))) {
+                                eris_slave_log_dump( ev_elt.sock, &client_host, http_context, "ok");
+
+                            } else { eris_slave_log_dump( ev_elt.sock, &client_host, http_context, "failed"); }
+
+                            eris_memory_cleanup( &client_host, sizeof( eris_socket_host_t));
+
+                            eris_slave_state_v = ERIS_SLAVE_CONN_CLOSE;
+
+                        } else if ( 0 == rc) {
                             eris_int_t resp_status = eris_http_response_get_status( http_context);
 
                             if ( ERIS_HTTP_000 == resp_status ) {
@@ -294,6 +462,17 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
 
                                 eris_http_response_set_status( http_context, ERIS_HTTP_406);
 
+                            } else if ( EERIS_4XX == rc) {
+                                /** Read request body failed, status is set */
+                                eris_slave_state_v = ERIS_SLAVE_HTTP_4XX;
+
+                            } else if ( EERIS_FULL == rc) {
+                                /** Module is over max_concurrency */
+                                eris_slave_state_v = ERIS_SLAVE_HTTP_5XX;
+
+                                eris_http_response_set_status( http_context, ERIS_HTTP_503);
+                                (eris_none_t )eris_http_response_set_header( http_context, "Retry-After", "1");
+
                             } else {
                                 eris_slave_state_v = ERIS_SLAVE_HTTP_5XX;
 
@@ -305,6 +484,11 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
 
                         eris_http_response_set_status( http_context, ERIS_HTTP_405);
                     }
+
+                    /** Body is not read by any service */
+                    if ( eris_http_request_body_pending( http_context)) {
+                        (eris_none_t )eris_http_request_body_discard( http_context);
+                    }
                 } break;
             case ERIS_SLAVE_HTTP_GET :
             case ERIS_SLAVE_HTTP_HEAD:
@@ -313,11 +497,24 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
 
                     /** Get file */
                     rc = eris_slave_get_file( http_context);
+
+                    eris_flight_record( ERIS_FLIGHT_FILE, ev_elt.sock, rc, NULL);
                     if ( 0 == rc) {
                         /** Get file content ok */
                         eris_slave_state_v = ERIS_SLAVE_HTTP_2XX;
 
-                        eris_http_response_set_status( http_context, ERIS_HTTP_200);
+                        if ( ERIS_HTTP_206 != eris_http_response_get_status( http_context)) {
+                            eris_http_response_set_status( http_context, ERIS_HTTP_200);
+                        }
+                    } else if ( EERIS_4XX == rc) {
+                        /** Range not satisfiable, status is set */
+                        eris_slave_state_v = ERIS_SLAVE_HTTP_4XX;
+
+                    } else if ( EERIS_3XX == rc) {
+                        /** Client cache is fresh */
+                        eris_slave_state_v = ERIS_SLAVE_HTTP_3XX;
+
+                        eris_http_response_set_status( http_context, ERIS_HTTP_304);
 
                     } else if ( EERIS_NOTFOUND == rc) {
                         /** Not found */
@@ -328,7 +525,7 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
                         /** Not access */
                         eris_slave_state_v = ERIS_SLAVE_HTTP_4XX;
 
-                        eris_http_response_set_status( http_context, ERIS_HTTP_406);
+                        eris_http_response_set_status( http_context, ERIS_HTTP_403);
                     } else {
                         /** server error */
                         eris_slave_state_v = ERIS_SLAVE_HTTP_5XX;
@@ -374,7 +571,13 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
                     eris_http_response_set_version( http_context, eris_http_request_get_version( http_context));
 
                     rc = eris_slave_set_response_headers( http_context, is_keepalive);
-                    if ( 0 == rc) {
+                    if ( (0 == rc) && (ERIS_HTTP_304 == eris_http_response_get_status( http_context))) {
+                        /** 304 has validators and caching headers only, stored headers of cache are replaced by it */
+                        eris_http_response_del_header( http_context, "Content-Type");
+                        eris_http_response_del_header( http_context, "Content-Length");
+                        eris_http_response_del_header( http_context, "Content-Encoding");
+
+                    } else if ( 0 == rc) {
                         /** Set content-xxx */
                         eris_string_t resp_size_es;
                         eris_string_init( resp_size_es);
@@ -465,7 +668,13 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
 
                     if ( 1 == eris_socket_ready_w( ev_elt.sock, 0)) {
                         /** output response to client */
+                        stage_us = eris_time_mono_us();
+
                         rc = eris_http_response_pack( http_context, eris_slave_response_outcb, &ev_elt);
+
+                        eris_slave_stage_end( send, ERIS_STATS_HIST_SEND, stage_us);
+
+                        eris_flight_record( ERIS_FLIGHT_PACK, ev_elt.sock, eris_http_response_get_status( http_context), NULL);
                         if ( 0 == rc) {
                             eris_slave_log_dump( ev_elt.sock, &client_host, http_context, "ok");
 
@@ -508,7 +717,18 @@ eris_void_t *eris_slave_handler( eris_void_t *__arg)
                     //eris_log_dump( &(p_erishttp_context->errors_log), ERIS_LOG_NOTICE, "Pid.<%d> - close sock.<%d>", eris_get_pid(), ev_elt.sock);
                     eris_slave_state_v = ERIS_SLAVE_GET_WAIT;
 
+                    eris_flight_record( ERIS_FLIGHT_CLOSE, ev_elt.sock, 0, NULL);
+
+                    /** Request of client address is done, its connection of rate limit is released */
+                    if ( ERIS_EVENT_READ & ev_elt.events) {
+                        eris_ratelimit_release( p_erishttp_context->ratelimit, ev_elt.addr);
+                    }
+
                     eris_socket_close( ev_elt.sock);
+
+                    if ( eris_slave_stats && !(p_erishttp_context->draining)) { eris_slave_stats->active = 0; }
+
+                    eris_atomic_fetch_dec( &(p_erishttp_context->busy));
                 } break;
             default : break;
         }/// switch ( eris_slave_state_v)
@@ -555,6 +775,8 @@ eris_slave_request_incb( eris_buffer_t *__out_buf, eris_size_t __max_size, eris_
                     rc = -1;
                 }
 
+                eris_slave_stats_add( bytes_in, recv_n);
+
                 break;
             } else if ( 0 == recv_n) {
 
@@ -619,11 +841,15 @@ eris_slave_response_outcb( eris_buffer_t *__in_buf, eris_size_t __in_size, eris_
                         continue;
 
                     } else if ( (EAGAIN == errno) || (EWOULDBLOCK == errno)) {
+                        /** Send buffer is full, wait client read it */
+                        if ( 0 < eris_socket_ready_w( p_ev_elt->sock, p_erishttp_context->attrs.timeout)) {
+                            continue;
 
-                        continue;
+                        } else { rc = -1; break; }
                     } else { rc = -1; break; }
                 }
             }
+            eris_slave_stats_add( bytes_out, send_count);
 #if 0
             eris_log_dump( &(p_erishttp_context->errors_log), ERIS_LOG_NOTICE, "Pid.<%d> - Send over sock.<%d>", eris_get_pid(), p_ev_elt->sock);
 #endif
@@ -636,6 +862,57 @@ eris_slave_response_outcb( eris_buffer_t *__in_buf, eris_size_t __in_size, eris_
 }/// eris_slave_response_outcb
 
 
+/**
+ * @Brief: eris slave response file output cb of http response pack, it is zero-copy.
+ *
+ * @Param: __fd,     File descriptor.
+ * @Param: __offset, File offset of range.
+ * @Param: __size,   Range size.
+ * @Param: __arg,    Input callback argument.
+ * @Param: __log,    Log context.
+ *
+ * @Return: Ok is 0, Other is -1.
+ **/
+static eris_int_t 
+eris_slave_response_filecb( eris_fd_t __fd, eris_off_t __offset, eris_size_t __size, eris_arg_t __arg, eris_log_t *__log)
+{
+    eris_int_t tmp_errno = errno;
+    eris_int_t rc = 0;
+
+    eris_event_elem_t *p_ev_elt = (eris_event_elem_t *)__arg;
+
+    eris_off_t  offset     = __offset;
+    eris_size_t send_count = 0;
+
+    while ( send_count < __size) {
+        eris_ssize_t send_n = eris_socket_sendfile( p_ev_elt->sock, __fd, &offset, __size - send_count);
+        if ( 0 < send_n) {
+            send_count += send_n;
+
+        } else if ( 0 == send_n) {
+            /** File is truncated */
+            rc = -1; break;
+
+        } else if ( EINTR == errno) {
+            continue;
+
+        } else if ( (EAGAIN == errno) || (EWOULDBLOCK == errno)) {
+            /** Send buffer is full, wait client read it */
+            if ( 0 < eris_socket_ready_w( p_ev_elt->sock, p_erishttp_context->attrs.timeout)) {
+                continue;
+
+            } else { rc = -1; break; }
+        } else { rc = -1; break; }
+    }
+
+    eris_slave_stats_add( bytes_out, send_count);
+
+    errno = tmp_errno;
+
+    return rc;
+}/// eris_slave_response_filecb
+
+
 /**
  * @Brief: Set http response base headers.
  *
@@ -645,47 +922,437 @@ eris_slave_response_outcb( eris_buffer_t *__in_buf, eris_size_t __in_size, eris_
  * @Return: Ok is 0, Other is EERIS_ERROR.
  **/
 static eris_int_t eris_slave_set_response_headers( eris_http_t *__http_context, eris_bool_t __keep_alive)
+{
+    /** Server, Date and Connection are preformatted */
+    eris_int_t rc = eris_http_response_set_base_headers( __http_context, __keep_alive);
+
+    if ( 0 == rc) {
+        if ( !eris_http_response_get_header( __http_context, "Content-Type")) {
+            rc = eris_http_response_set_header( __http_context, "Content-Type", "application/octet-stream");
+        }
+    }
+
+    /** 405 */
+    if ( 0 == rc ) {
+        if ( ERIS_HTTP_405 == __http_context->response.status) {
+            rc = eris_http_response_set_header( __http_context, "Allow", "GET DELETE HEAD PATCH POST PUT");
+        }
+    }
+
+    return rc;
+}/// eris_slave_set_response_headers
+
+
+/**
+ * @Brief: Set ETag and Last-Modified of file, and check request conditions.
+ *
+ * @Param: __http,      Eris http context handler.
+ * @Param: __file_info, File information of fstat.
+ *
+ * @Return: Modified is 0, Not modified is EERIS_3XX, other is EERIS_ERROR.
+ **/
+static eris_int_t eris_slave_file_validate( eris_http_t *__http, const eris_stat_t *__file_info)
 {
     eris_int_t rc = 0;
 
-    eris_string_t date_es;
-    eris_string_init( date_es);
+    eris_time_t file_mtime = eris_attrfs_mtime( *__file_info);
 
-    if ( eris_time_gmt( &date_es) ) {
-        /** Set base response headers */
-        rc = eris_http_response_set_header( __http_context, "Server", ERIS_VERSION_DESC);
-        if ( 0 == rc) {
-            rc = eris_http_response_set_header( __http_context, "Date"  , date_es);
+    eris_char_t etag[ 64] = {0};
+    eris_char_t last_modified[ ERIS_TIME_GMT_SIZE + 1] = {0};
+
+    /** Inode, size and mtime */
+    eris_int_t etag_size = snprintf( etag, sizeof( etag), "\"%lx-%lx-%lx\"", 
+                                     (eris_ulong_t )eris_attrfs_inode( *__file_info),
+                                     (eris_ulong_t )eris_attrfs_size( *__file_info),
+                                     (eris_ulong_t )file_mtime);
+
+    rc = eris_http_response_set_header( __http, "ETag", etag);
+    if ( (0 == rc) && (0 == eris_time_gmt_format( last_modified, file_mtime))) {
+        rc = eris_http_response_set_header( __http, "Last-Modified", last_modified);
+    }
+
+    if ( 0 == rc) {
+        const eris_char_t *p_inm = eris_http_request_get_header( __http, "If-None-Match");
+        if ( p_inm) {
+            /** Weak comparison of each entity-tag in list */
+            while ( *p_inm) {
+                while ( (' ' == *p_inm) || ('\t' == *p_inm) || (',' == *p_inm)) { p_inm++; }
+
+                if ( '*' == *p_inm) {
+                    rc = EERIS_3XX; break;
+                }
+
+                if ( ('W' == p_inm[ 0]) && ('/' == p_inm[ 1])) { p_inm += 2; }
+
+                const eris_char_t *p_tag = p_inm;
+                while ( *p_inm && (',' != *p_inm) && (' ' != *p_inm) && ('\t' != *p_inm)) { p_inm++; }
+
+                if ( ((p_inm - p_tag) == etag_size) && (0 == memcmp( p_tag, etag, etag_size))) {
+                    rc = EERIS_3XX; break;
+                }
+            }
+        } else {
+            const eris_string_t ims_es = eris_http_request_get_header( __http, "If-Modified-Since");
+            if ( ims_es) {
+                eris_tm_t ims_tm;
+                eris_memory_cleanup( &ims_tm, sizeof( eris_tm_t));
+
+                if ( 0 == eris_time_gmt2tm( &ims_tm, ims_es)) {
+                    if ( file_mtime <= timegm( &ims_tm)) {
+                        rc = EERIS_3XX;
+                    }
+                }
+            }
         }
-        
-        if ( 0 == rc) {
-            if ( __keep_alive) {
-                rc = eris_http_response_set_header( __http_context, "Connection", "keep-alive");
+    } else { rc = EERIS_ERROR; }
 
-            } else {
-                rc = eris_http_response_set_header( __http_context, "Connection", "close");
+    return rc;
+}/// eris_slave_file_validate
+
+
+/**
+ * @Brief: Normalize request url to file path relative to doc_root, 
+ *       : "." and empty segments are skipped, ".." goes up one.
+ *
+ * @Param: __url,  Request url.
+ * @Param: __path, Output relative path.
+ * @Param: __size, Output path buffer size.
+ *
+ * @Return: Ok is 0, Out of doc_root or too long is EERIS_NOTFOUND.
+ **/
+static eris_int_t eris_slave_file_path( const eris_char_t *__url, eris_char_t *__path, eris_size_t __size)
+{
+    eris_size_t path_n = 0;
+
+    const eris_char_t *p_url = __url ? __url : "";
+    while ( *p_url) {
+        p_url += strspn( p_url, "/");
+
+        const eris_char_t *p_seg = p_url;
+        eris_size_t        seg_n = strcspn( p_url, "/");
+
+        p_url += seg_n;
+
+        if ( (0 == seg_n) || ((1 == seg_n) && ('.' == p_seg[ 0]))) { continue; }
+
+        if ( (2 == seg_n) && ('.' == p_seg[ 0]) && ('.' == p_seg[ 1])) {
+            /** Up is not over doc_root */
+            if ( 0 == path_n) { return EERIS_NOTFOUND; }
+
+            while ( (0 < path_n) && ('/' != __path[ path_n - 1])) { path_n--; }
+            if ( 0 < path_n) { path_n--; }
+
+            continue;
+        }
+
+        if ( (path_n + 1 + seg_n + 1) > __size) { return EERIS_NOTFOUND; }
+
+        if ( 0 < path_n) { __path[ path_n++] = '/'; }
+
+        eris_memory_copy( __path + path_n, p_seg, seg_n);
+        path_n += seg_n;
+    }
+
+    /** Root is index.html */
+    if ( 0 == path_n) {
+        if ( sizeof( "index.html") > __size) { return EERIS_NOTFOUND; }
+
+        eris_memory_copy( __path, "index.html", sizeof( "index.html") - 1);
+        path_n = sizeof( "index.html") - 1;
+    }
+
+    __path[ path_n] = '\0';
+
+    return 0;
+}/// eris_slave_file_path
+
+
+/**
+ * @Brief: Open regular file relative to doc_root, and get its information.
+ *
+ * @Param: __path,      File path relative to doc_root.
+ * @Param: __fd,        Output opened file.
+ * @Param: __file_info, Output file information.
+ *
+ * @Return: Ok is 0, Not found is EERIS_NOTFOUND, no access is EERIS_NOACCESS,
+ *        : other is EERIS_ERROR.
+ **/
+static eris_int_t eris_slave_file_open( const eris_char_t *__path, eris_fd_t *__fd, eris_stat_t *__file_info)
+{
+    eris_int_t rc = 0;
+
+    *__fd = -1;
+
+    if ( 0 > p_erishttp_context->doc_root_fd) { return EERIS_NOTFOUND; }
+
+    /** Generations are taken before lookup, a change after it drops the miss */
+    eris_slave_miss_t miss;
+    eris_bool_t       miss_cached = eris_slave_miss_make( &miss, __path);
+
+    /** Symlink of any component is not followed, and nonblock is not hung on fifo */
+    eris_fd_t fd = eris_slave_file_openat( __path);
+    if ( 0 <= fd) {
+        if ( 0 == fstat( fd, __file_info)) {
+            if ( eris_attrfs_isfile( *__file_info)) {
+                *__fd = fd;
+
+            } else { rc = EERIS_NOACCESS; }
+        } else { rc = EERIS_ERROR; }
+
+        if ( 0 != rc) { close( fd); }
+
+    } else {
+        switch ( errno) {
+            case ENOENT       :
+            case ENOTDIR      : 
+                {
+                    rc = EERIS_NOTFOUND;
+
+                    if ( miss_cached) { eris_slave_miss_add( &miss); }
+                } break;
+            case ENAMETOOLONG : { rc = EERIS_NOTFOUND; } break;
+            case EACCES       :
+            case EPERM        :
+            case EXDEV        :
+            case ELOOP        : { rc = EERIS_NOACCESS; } break;
+            default           : { rc = EERIS_ERROR;    } break;
+        }
+    }
+
+    return rc;
+}/// eris_slave_file_open
+
+
+/**
+ * @Brief: Open path beneath doc_root, no component of it is a symlink. It is one openat2
+ *         of RESOLVE_BENEATH and RESOLVE_NO_SYMLINKS, or a walk of O_NOFOLLOW openat of
+ *         each component when kernel has no openat2.
+ *
+ * @Param: __path, File path relative to doc_root.
+ *
+ * @Return: Ok is opened fd, Other is -1 and errno is set.
+ **/
+static eris_fd_t eris_slave_file_openat( const eris_char_t *__path)
+{
+    eris_fd_t rc_fd = -1;
+
+    const eris_int_t open_flags = O_RDONLY | O_NOFOLLOW | O_CLOEXEC | O_NONBLOCK;
+
+#if (ERIS_HAVE_LINUX_OPENAT2_H) && defined( SYS_openat2)
+    /** Kernel without openat2 is found once */
+    static eris_atomic_t openat2_none = 0;
+
+    if ( !openat2_none) {
+        struct open_how how; {
+            eris_memory_cleanup( &how, sizeof( struct open_how));
+
+            how.flags   = open_flags;
+            how.resolve = RESOLVE_BENEATH | RESOLVE_NO_SYMLINKS;
+        }
+
+        rc_fd = (eris_fd_t )syscall( SYS_openat2, p_erishttp_context->doc_root_fd, __path, &how, sizeof( struct open_how));
+        if ( (0 <= rc_fd) || (ENOSYS != errno)) { return rc_fd; }
+
+        openat2_none = 1;
+    }
+#endif
+
+    eris_char_t path[ PATH_MAX];
+    if ( strlen( __path) >= sizeof( path)) { errno = ENAMETOOLONG; return -1; }
+
+    strcpy( path, __path);
+
+    /** Directories are opened one by one, a symlink of them is ELOOP or ENOTDIR */
+    eris_fd_t    dir_fd = p_erishttp_context->doc_root_fd;
+    eris_char_t *p_name = path;
+    eris_char_t *p_slash = NULL;
+
+    while ( NULL != (p_slash = strchr( p_name, '/'))) {
+        *p_slash = '\0';
+
+        if ( '\0' != *p_name) {
+            eris_fd_t next_fd = openat( dir_fd, p_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+
+            /** Symlink is refused as openat2, other is not a directory */
+            eris_int_t tmp_errno = errno;
+            if ( (0 > next_fd) && (ENOTDIR == tmp_errno)) {
+                eris_stat_t link_info;
+
+                if ( (0 == fstatat( dir_fd, p_name, &link_info, AT_SYMLINK_NOFOLLOW)) && S_ISLNK( link_info.st_mode)) {
+                    tmp_errno = ELOOP;
+                }
             }
+
+            if ( dir_fd != p_erishttp_context->doc_root_fd) { close( dir_fd); }
+            errno = tmp_errno;
+
+            if ( 0 > next_fd) { return -1; }
+
+            dir_fd = next_fd;
         }
-    
-        if ( 0 == rc) {
-            if ( !eris_http_response_get_header( __http_context, "Content-Type")) {
-                rc = eris_http_response_set_header( __http_context, "Content-Type", "application/octet-stream");
+
+        p_name = p_slash + 1;
+    }
+
+    rc_fd = openat( dir_fd, p_name, open_flags);
+
+    eris_int_t tmp_errno = errno;
+    if ( dir_fd != p_erishttp_context->doc_root_fd) { close( dir_fd); }
+    errno = tmp_errno;
+
+    return rc_fd;
+}/// eris_slave_file_openat
+
+
+/**
+ * @Brief: Check precompressed sidecar "file.gz" of static file, it is used
+ *       : when client accepts gzip and it is not older than the file.
+ *
+ * @Param: __http,         Eris http context handler.
+ * @Param: __path,         File path relative to doc_root.
+ * @Param: __file_info,    File information.
+ * @Param: __gz_fd,        Output opened sidecar file.
+ * @Param: __gz_file_info, Output sidecar file information.
+ *
+ * @Return: Sidecar is used is true, other is false.
+ **/
+static eris_bool_t eris_slave_file_gzip_static( eris_http_t *__http, const eris_char_t *__path, const eris_stat_t *__file_info, 
+                                                eris_fd_t *__gz_fd, eris_stat_t *__gz_file_info)
+{
+    eris_bool_t rc = false;
+
+    if ( p_erishttp_context->attrs.gzip_static) {
+        /** Response is varied by Accept-Encoding, both identity and gzip */
+        (eris_none_t )eris_http_response_set_header( __http, "Vary", "Accept-Encoding");
+
+        if ( eris_http_request_accept_gzip( __http)) {
+            eris_char_t gz_path[ PATH_MAX];
+
+            if ( (eris_int_t )sizeof( gz_path) > snprintf( gz_path, sizeof( gz_path), "%s.gz", __path)) {
+                /** Missing sidecar is the common case, and it is cached */
+                if ( !eris_slave_miss_find( gz_path) && (0 == eris_slave_file_open( gz_path, __gz_fd, __gz_file_info))) {
+                    if ( eris_attrfs_mtime( *__file_info) <= eris_attrfs_mtime( *__gz_file_info)) {
+                        rc = true;
+
+                    } else {
+                        close( *__gz_fd);
+
+                        *__gz_fd = -1;
+                    }
+                }
             }
         }
+    }
+
+    return rc;
+}/// eris_slave_file_gzip_static
+
+
+/**
+ * @Brief: Make negative lookup entry of path, it is done before file system
+ *       : lookup, so a change of path after lookup is not missed.
+ *
+ * @Param: __miss, Output entry.
+ * @Param: __path, File path relative to doc_root.
+ *
+ * @Return: Path can be cached is true, other is false.
+ **/
+static eris_bool_t eris_slave_miss_make( eris_slave_miss_t *__miss, const eris_char_t *__path)
+{
+    eris_size_t path_size = strlen( __path);
 
-        /** 405 */
-        if ( 0 == rc ) {
-            if ( ERIS_HTTP_405 == __http_context->response.status) {
-                rc = eris_http_response_set_header( __http_context, "Allow", "GET DELETE HEAD PATCH POST PUT");
+    if ( (0 >= p_erishttp_context->attrs.static_miss_ttl) || (ERIS_SLAVE_MISS_PATH_MAX <= path_size) ) {
+        return false;
+    }
+
+    const eris_watch_t *p_watch = p_erishttp_context->watch;
+
+    __miss->hash     = eris_watch_hash( __path);
+    __miss->watched  = (p_watch && p_watch->active);
+    __miss->all_gen  = __miss->watched ? p_watch->all : 0;
+    __miss->path_gen = __miss->watched ? eris_watch_bucket( p_watch, __miss->hash) : 0;
+    __miss->expire   = time( NULL) + p_erishttp_context->attrs.static_miss_ttl;
+
+    memcpy( __miss->path, __path, path_size + 1);
+
+    return true;
+}/// eris_slave_miss_make
+
+
+/**
+ * @Brief: Find path in negative lookup cache of static files. It is expired by time,
+ *       : and when doc_root is watched it is dropped at once of path changed.
+ *
+ * @Param: __path, File path relative to doc_root.
+ *
+ * @Return: Cached and not changed is true, other is false.
+ **/
+static eris_bool_t eris_slave_miss_find( const eris_char_t *__path)
+{
+    eris_bool_t rc = false;
+
+    eris_slave_miss_t probe;
+    if ( eris_slave_miss_make( &probe, __path)) {
+        eris_uint32_t slot = probe.hash & (ERIS_SLAVE_MISS_SLOTS - 1);
+        eris_uint32_t i    = 0;
+
+        /** Expire of probe is now + ttl */
+        eris_time_t now = probe.expire - p_erishttp_context->attrs.static_miss_ttl;
+
+        eris_spinlock_acquire( &eris_slave_miss_lock, 1, 1);
+
+        for ( i = 0; i < 2; i++) {
+            const eris_slave_miss_t *p_miss = &(eris_slave_misses[ slot ^ i]);
+
+            if ( (probe.hash == p_miss->hash) && (0 == strcmp( __path, p_miss->path))) {
+                /** Time is a backstop of watched, a change not seen by watcher is not kept */
+                rc = (now < p_miss->expire);
+
+                if ( rc && probe.watched && p_miss->watched) {
+                    rc = ((probe.all_gen == p_miss->all_gen) && (probe.path_gen == p_miss->path_gen));
+                }
+
+                break;
             }
         }
-    } else { rc = -1; }
 
-    eris_string_free( date_es);
-    eris_string_init( date_es);
+        eris_spinlock_release( &eris_slave_miss_lock, 1);
+    }
 
     return rc;
-}/// eris_slave_set_response_headers
+}/// eris_slave_miss_find
+
+
+/**
+ * @Brief: Add entry to negative lookup cache of static files, it replaces the
+ *       : entry of the same path, or the older of two ways.
+ *
+ * @Param: __miss, Entry of eris_slave_miss_make.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t eris_slave_miss_add( const eris_slave_miss_t *__miss)
+{
+    eris_uint32_t slot = __miss->hash & (ERIS_SLAVE_MISS_SLOTS - 1);
+
+    eris_spinlock_acquire( &eris_slave_miss_lock, 1, 1);
+
+    eris_slave_miss_t *p_miss = &(eris_slave_misses[ slot]);
+    eris_slave_miss_t *p_way  = &(eris_slave_misses[ slot ^ 1]);
+
+    if ( (__miss->hash == p_way->hash) && (0 == strcmp( __miss->path, p_way->path))) {
+        p_miss = p_way;
+
+    } else if ( !((__miss->hash == p_miss->hash) && (0 == strcmp( __miss->path, p_miss->path))) ) {
+        if ( p_way->expire < p_miss->expire) {
+            p_miss = p_way;
+        }
+    }
+
+    *p_miss = *__miss;
+
+    eris_spinlock_release( &eris_slave_miss_lock, 1);
+}/// eris_slave_miss_add
 
 
 /**
@@ -693,127 +1360,105 @@ static eris_int_t eris_slave_set_response_headers( eris_http_t *__http_context,
  *
  * @Param: __http, Eris http context handler.
  *
- * @Return: OK is 0, 
+ * @Return: OK is 0 (status 206 is set of ranges), Not modified is EERIS_3XX,
  *        : Not found is EERIS_NOTFOUND, no access is EERIS_NOACCESS,
- *        : other is EERIS_ERROR.
+ *        : Unsatisfiable range is EERIS_4XX (status is set), other is EERIS_ERROR.
  **/
 static eris_int_t eris_slave_get_file( eris_http_t *__http)
 {
     eris_int_t tmp_errno = errno;
     eris_int_t rc = 0;
 
-    eris_string_t file_path_es;
-    eris_string_init( file_path_es);
+    eris_char_t file_path[ PATH_MAX];
+
+    rc = eris_slave_file_path( __http->request.url, file_path, sizeof( file_path));
+    if ( (0 == rc) && eris_slave_miss_find( file_path)) {
+        /** Recent miss, the file system is not touched again */
+        rc = EERIS_NOTFOUND;
+
+    } else if ( 0 == rc) {
+        /** Dump get file */
+        if ( ERIS_HTTP_GET == __http->request.command) {
+            eris_log_dump( &(p_erishttp_context->module_log), ERIS_LOG_INFO, "Get.<%s>", file_path);
 
-    eris_string_t clone_url_es = eris_string_clone_eris( __http->request.url);
-    if ( clone_url_es) {
-        if ( eris_string_isequal( clone_url_es, "/", false)) {
-            rc = eris_string_set( &clone_url_es, "/index.html");
+        } else {
+            eris_log_dump( &(p_erishttp_context->module_log), ERIS_LOG_INFO, "HEAD.<%s>", file_path);
         }
 
+        eris_fd_t   fd = -1;
+        eris_stat_t file_info;
+
+        /** One open and fstat, error is not found or no access */
+        rc = eris_slave_file_open( file_path, &fd, &file_info);
         if ( 0 == rc) {
-            rc = eris_string_printf( &file_path_es, "%S%S", p_erishttp_context->attrs.doc_root, clone_url_es);
-            if ( 0 == rc) {
-                /** Dump get file */
-                if ( ERIS_HTTP_GET == __http->request.command) {
-                    eris_log_dump( &(p_erishttp_context->module_log), ERIS_LOG_INFO, "Get.<%s>", file_path_es);
+            /** Precompressed sidecar is sent in place of file */
+            eris_fd_t   gz_fd = -1;
+            eris_stat_t gz_file_info;
 
-                } else {
-                    eris_log_dump( &(p_erishttp_context->module_log), ERIS_LOG_INFO, "HEAD.<%s>", file_path_es);
-                }
+            eris_bool_t gz_static = eris_slave_file_gzip_static( __http, file_path, &file_info, &gz_fd, &gz_file_info);
+            if ( gz_static) {
+                close( fd);
 
-                if ( 0 == access( file_path_es, F_OK)) {
-                    eris_attrfs_t file_type = eris_attrfs_get( file_path_es);
-                    if ( ERIS_ATTRFS_REG == file_type) {
-                        eris_files_t fcontext;
-                        rc = eris_files_init( &fcontext, file_path_es, &(p_erishttp_context->errors_log));
-                        if ( 0 == rc) {
-                            rc = eris_files_open( &fcontext, ERIS_ATTRFS_RDONLY, 0);
-                            if ( 0 == rc) {
-                                //eris_buffer_init( &(__http->response.body), NULL);
+                fd        = gz_fd;
+                file_info = gz_file_info;
+            }
 
-                                eris_size_t  r_count = 0;
-                                eris_uchar_t r_cache[ 512] = {0};
+            /** Check conditions before read, not modified skip it */
+            rc = eris_slave_file_validate( __http, &file_info);
+            if ( 0 == rc) {
+                eris_size_t file_size = (eris_size_t )eris_attrfs_size( file_info);
 
-                                do {
-                                    /** Read file... */
-                                    eris_ssize_t r_size = eris_files_read( &fcontext, r_cache, sizeof( r_cache), r_count);
-                                    if ( 0 < r_size) {
-                                        r_count += r_size;
+                if ( ERIS_HTTP_HEAD == __http->request.command) {
+                    /** HEAD is made of metadata */
+                    rc = eris_http_response_set_file_meta( __http, file_size);
 
-                                        rc = eris_http_response_set_body_append( __http, (const eris_void_t *)r_cache, r_size);
-                                        if ( 0 != rc) {
-                                            rc = EERIS_ERROR;
+                } else {
+                    /** File is sent at pack, and fd is owned by http context */
+                    rc = eris_http_response_set_file( __http, fd, file_size);
+                    if ( 0 == rc) {
+                        fd = -1;
+                    }
+                }
 
-                                            break;
-                                        }
-                                    } else if (0 == r_size) {
-                                        /** End */
-                                        break;
-                                    } else {
-                                        if ( EINTR == errno) {
-                                            continue;
-                                        } else {
-                                            rc = EERIS_ERROR;
+                if ( 0 == rc) {
+                    if ( gz_static) {
+                        (eris_none_t )eris_http_response_set_header( __http, "Content-Encoding", "gzip");
+                    }
 
-                                            break;
-                                        }
-                                    }
-                                } while ( 1);
+                    /** Get file suffix */
+                    const eris_char_t *p_suffix = strrchr( file_path, '.');
+                    if ( p_suffix && !strchr( p_suffix, '/')) {
+                        p_suffix++;
 
-                                /** Read data ok */
-                                if ( 0 == rc) {
-                                    /** Get file suffix */
-                                    eris_size_t suffix_idx = eris_string_rfind( file_path_es, ".");
-                                    if ( ERIS_STRING_NPOS != suffix_idx) {
-                                        eris_string_t suffix_es = eris_string_assign( file_path_es, (suffix_idx + 1), -1);
-                                        if ( suffix_es) {
-                                            (eris_none_t )eris_string_append_c( &suffix_es, ' ');
-
-                                            eris_list_iter_t mt_iter; {
-                                                eris_list_iter_init( &(p_erishttp_context->mime_types), &mt_iter);
-                                            }
-
-                                            /** Found Content-Type */
-                                            erishttp_mime_type_t *p_mt = NULL;
-                                            for ( ; (NULL != (p_mt = eris_list_iter_next( &mt_iter))); ) {
-                                                if ( ERIS_STRING_NPOS != eris_string_find_eris( p_mt->types, suffix_es)) {
-                                                    /** Set MIME-type */
-                                                    eris_http_response_set_header( __http, "Content-Type", p_mt->mime);
-
-                                                    break;
-                                                }
-                                            }
-
-                                            eris_string_free( suffix_es);
-                                            eris_string_init( suffix_es);
-                                        }
-                                    }
-                                }
-                            } else {
-                                if ( 0 != access( file_path_es, F_OK)) {
-                                    rc = EERIS_NOTFOUND;
+                        /** Found Content-Type */
+                        const eris_char_t *p_mime = erishttp_mime_type_find( p_suffix, strlen( p_suffix));
+                        if ( p_mime) {
+                            /** Set MIME-type */
+                            eris_http_response_set_header( __http, "Content-Type", p_mime);
+                        }
+                    }
 
-                                } else {
-                                    rc = EERIS_NOACCESS;
-                                }
-                            }
+                    (eris_none_t )eris_http_response_set_header( __http, "Accept-Ranges", "bytes");
 
-                            /** Destroy file context */
-                            eris_files_destroy( &fcontext);
-                        } else { rc = EERIS_ERROR; }
-                    } else { rc = EERIS_NOACCESS; }
-                } else { rc = EERIS_NOTFOUND; }
-            } else { rc = EERIS_ERROR; }
-        } else { rc = EERIS_ERROR; }
+                    /** Range of file */
+                    rc = eris_http_response_set_ranges( __http);
+                    if ( 0 == rc) {
+                        eris_http_response_set_status( __http, ERIS_HTTP_206);
 
-        eris_string_free( clone_url_es);
-        eris_string_init( clone_url_es);
+                    } else if ( EERIS_NOTFOUND == rc) {
+                        rc = 0;
 
-    } else { rc = EERIS_ERROR; }
+                    } else if ( EERIS_INVALID == rc) {
+                        rc = EERIS_4XX;
+
+                        eris_http_response_set_status( __http, ERIS_HTTP_416);
+                    } else { rc = EERIS_ERROR; }
+                } else { rc = EERIS_ERROR; }
+            }
 
-    eris_string_free( file_path_es);
-    eris_string_init( file_path_es);
+            if ( 0 <= fd) { close( fd); }
+        }
+    }
 
     errno = tmp_errno;
 
@@ -842,7 +1487,6 @@ static eris_none_t eris_slave_log_dump
     const eris_char_t   *p_req_command  = NULL;
     const eris_char_t   *p_resp_version = NULL;
     const eris_string_t  req_url_es     = eris_http_request_get_url( __http); 
-    const eris_string_t  req_user_agent = eris_http_request_get_header( __http, "User-Agent");
     eris_int_t           resp_status    = eris_http_response_get_status( __http);
     eris_size_t          resp_body_size = eris_http_response_get_body_size( __http);
 
@@ -877,10 +1521,72 @@ static eris_none_t eris_slave_log_dump
             } break;
     }
 
-    /** Dump access log */
-    {
-        eris_log_dump( &(p_erishttp_context->access_log), ERIS_LOG_NOTICE, 
-                       "(%s:%d-%d) - \"%s %s %s\" - \"%d %lu\" \"%s\" - %s", 
+    /** Request time is from queued to now */
+    eris_uint64_t request_us = eris_time_mono_us() - eris_slave_timing.queued;
+
+    /** Count response of status class */
+    if ( eris_slave_stats) {
+        eris_int_t status_class = resp_status / 100;
+
+        eris_slave_stats_add( requests, 1);
+        eris_slave_stats_add( status[ ((1 <= status_class) && (5 >= status_class)) ? (status_class - 1) : (ERIS_STATS_STATUS_N - 1)], 1);
+
+        eris_stats_hist_record( eris_slave_stats, ERIS_STATS_HIST_REQUEST, request_us);
+    }
+
+    /** Dump access log of compiled log format */
+    if ( ERIS_LOG_NOTICE >= p_erishttp_context->access_log.min_level) {
+        eris_logfmt_values_t log_values; {
+            log_values.remote_addr = __client->ipv4;
+            log_values.remote_port = __client->port;
+            log_values.connection  = __sock;
+            log_values.method      = p_req_command;
+            log_values.uri         = req_url_es;
+            log_values.protocol    = p_resp_version;
+            log_values.status      = resp_status;
+            log_values.body_bytes  = resp_body_size;
+            log_values.result      = __tail;
+            log_values.request_us  = request_us;
+            log_values.queue_us    = eris_slave_timing.queue;
+            log_values.parse_us    = eris_slave_timing.parse;
+            log_values.service_us  = eris_slave_timing.service;
+            log_values.send_us     = eris_slave_timing.send;
+            log_values.http        = __http;
+        }
+
+        eris_char_t log_record[ ERIS_LOGFMT_RECORD_SIZE];
+
+        (eris_none_t )eris_logfmt_make( &(p_erishttp_context->access_logfmt), &log_values, log_record, sizeof( log_record));
+
+        eris_log_write( &(p_erishttp_context->access_log), ERIS_LOG_NOTICE, log_record);
+    }
+
+    /** Dump slow log with timings and request headers */
+    eris_int_t slow_ms = p_erishttp_context->attrs.slow_request_time;
+    if ( (0 < slow_ms) && (request_us >= ((eris_uint64_t )slow_ms * 1000))) {
+        /** Other time is of 100-continue body, static file and socket waits */
+        eris_uint64_t staged_us = eris_slave_timing.queue + eris_slave_timing.parse + eris_slave_timing.service + eris_slave_timing.send;
+
+        eris_string_t headers_es = eris_string_alloc( 256);
+
+        if ( headers_es) {
+            eris_string_cleanup( headers_es);
+
+            const eris_http_hnode_t *p_hnode = __http->request.headers;
+            for ( ; p_hnode; p_hnode = p_hnode->next) {
+                if ( 0 != eris_string_printf_append( &headers_es, "%s%S: %S", 
+                                                     (p_hnode == __http->request.headers) ? "" : " | ",
+                                                     p_hnode->name,
+                                                     p_hnode->value)) {
+                    break;
+                }
+            }
+        }
+
+        eris_log_dump( &(p_erishttp_context->slow_log), ERIS_LOG_WARN, 
+                       "(%s:%d-%d) - \"%s %s %s\" - \"%d %lu\" - %s"
+                       " request_time=%lu.%06lu queue_time=%lu.%06lu parse_time=%lu.%06lu service_time=%lu.%06lu send_time=%lu.%06lu"
+                       " other_time=%lu.%06lu - headers={%s}", 
                        __client->ipv4, 
                        __client->port,
                        __sock,
@@ -889,8 +1595,16 @@ static eris_none_t eris_slave_log_dump
                        p_resp_version,
                        resp_status,
                        resp_body_size,
-                       req_user_agent,
-                       __tail);
+                       __tail,
+                       eris_slave_seconds( request_us),
+                       eris_slave_seconds( eris_slave_timing.queue),
+                       eris_slave_seconds( eris_slave_timing.parse),
+                       eris_slave_seconds( eris_slave_timing.service),
+                       eris_slave_seconds( eris_slave_timing.send),
+                       eris_slave_seconds( (request_us > staged_us) ? (request_us - staged_us) : 0),
+                       headers_es ? headers_es : "");
+
+        eris_string_free( headers_es);
     }
 }/// eris_slave_log_dump
 
@@ -0,0 +1,566 @@
+/****************************************************************************//*
+ ** @CopyRight (C) 石正贤(Shizhengxian)
+ **
+ ** @Brief :
+ **        : Live counters of slaves and their task threads in shared memory,
+ **        : mapped by master before fork, written by slaves without locks
+ **        : and read by the admin listener of master.
+ **
+ ******************************************************************************/
+
+#include "eris.config.h"
+
+#include "os/unix/eris.unix.h"
+
+#include "eris/erishttp.h"
+
+
+/** Counters are in cache lines of their own, writers are not shared */
+#define ERIS_STATS_LINE          (64)
+#define eris_stats_align(s)      ((((s) + ERIS_STATS_LINE - 1) / ERIS_STATS_LINE) * ERIS_STATS_LINE)
+
+#define ERIS_STATS_HEAD_SIZE     eris_stats_align( sizeof( eris_stats_t))
+#define ERIS_STATS_SLAVE_SIZE    eris_stats_align( sizeof( eris_stats_slave_t))
+#define ERIS_STATS_THREAD_SIZE   eris_stats_align( sizeof( eris_stats_thread_t))
+
+
+/** Names of status classes */
+static const eris_char_t *eris_stats_status_names[ ERIS_STATS_STATUS_N] = {
+    "1xx", "2xx", "3xx", "4xx", "5xx", "other",
+};
+
+/** Shed reasons */
+static const eris_char_t *eris_stats_shed_names[ ERIS_STATS_SHED_N] = {
+    "depth", "latency", "full",
+};
+
+/** Limit reasons */
+static const eris_char_t *eris_stats_limit_names[ ERIS_STATS_LIMIT_N] = {
+    "rate", "conns",
+};
+
+/** Metric names and helps of histograms */
+static const eris_char_t *eris_stats_hist_names[ ERIS_STATS_HIST_N] = {
+    "erishttp_request_duration_seconds",
+    "erishttp_queue_wait_seconds",
+    "erishttp_parse_duration_seconds",
+    "erishttp_module_duration_seconds",
+    "erishttp_send_duration_seconds",
+};
+
+static const eris_char_t *eris_stats_hist_helps[ ERIS_STATS_HIST_N] = {
+    "Time from event queued to response sent.",
+    "Time waited in event queue of slave.",
+    "Time of request parse.",
+    "Time of module service execute.",
+    "Time of response pack and send.",
+};
+
+
+/** Upper bound of histogram bucket, it is inclusive microseconds. */
+static eris_uint64_t eris_stats_hist_upper( eris_int_t __index);
+
+/** Format microseconds to seconds string. */
+static const eris_char_t *eris_stats_seconds( eris_char_t *__buf, eris_size_t __size, eris_uint64_t __usec);
+
+
+
+/**
+ * @Brief: Create shared stats segment, it is done in master before slaves spawned.
+ *
+ * @Param: __slave_n, Slave processors number.
+ * @Param: __task_n,  Task threads number of a slave.
+ * @Param: __log,     Dump log message context.
+ *
+ * @Return: Ok is shared stats, Other is NULL.
+ **/
+eris_stats_t *eris_stats_create( eris_int_t __slave_n, eris_int_t __task_n, eris_log_t *__log)
+{
+    eris_stats_t *rc_stats = NULL;
+
+    if ( (0 < __slave_n) && (0 < __task_n)) {
+        eris_size_t stats_size = ERIS_STATS_HEAD_SIZE +
+                                 (ERIS_STATS_SLAVE_SIZE * __slave_n) +
+                                 (ERIS_STATS_THREAD_SIZE * __slave_n * __task_n);
+
+        /** Anonymous map is zero filled */
+        rc_stats = (eris_stats_t *)mmap( NULL, stats_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if ( MAP_FAILED != rc_stats) {
+            rc_stats->start   = time( NULL);
+            rc_stats->slave_n = __slave_n;
+            rc_stats->task_n  = __task_n;
+            rc_stats->size    = stats_size;
+
+            eris_int_t i = 0;
+            for ( i = 0; i < __slave_n; i++) {
+                eris_stats_slave( rc_stats, i)->last_exit = -1;
+            }
+
+        } else {
+            rc_stats = NULL;
+
+            if ( __log) {
+                eris_log_dump( __log, ERIS_LOG_ERROR, "Map shared stats failed, errno.<%d>", errno);
+            }
+        }
+    }
+
+    return rc_stats;
+}/// eris_stats_create
+
+
+/**
+ * @Brief: Get counters of a slave.
+ *
+ * @Param: __stats, Shared stats.
+ * @Param: __slave, Slave index.
+ *
+ * @Return: Ok is slave counters, Other is NULL.
+ **/
+eris_stats_slave_t *eris_stats_slave( eris_stats_t *__stats, eris_int_t __slave)
+{
+    eris_stats_slave_t *rc_slave = NULL;
+
+    if ( __stats && (0 <= __slave) && (__slave < __stats->slave_n)) {
+        rc_slave = (eris_stats_slave_t *)((eris_char_t *)__stats + ERIS_STATS_HEAD_SIZE + (ERIS_STATS_SLAVE_SIZE * __slave));
+    }
+
+    return rc_slave;
+}/// eris_stats_slave
+
+
+/**
+ * @Brief: Get counters of a task thread of slave.
+ *
+ * @Param: __stats, Shared stats.
+ * @Param: __slave, Slave index.
+ * @Param: __task,  Task thread index.
+ *
+ * @Return: Ok is thread counters, Other is NULL.
+ **/
+eris_stats_thread_t *eris_stats_thread( eris_stats_t *__stats, eris_int_t __slave, eris_int_t __task)
+{
+    eris_stats_thread_t *rc_thread = NULL;
+
+    if ( __stats && (0 <= __slave) && (__slave < __stats->slave_n) && (0 <= __task) && (__task < __stats->task_n)) {
+        rc_thread = (eris_stats_thread_t *)((eris_char_t *)__stats + ERIS_STATS_HEAD_SIZE +
+                                            (ERIS_STATS_SLAVE_SIZE * __stats->slave_n) +
+                                            (ERIS_STATS_THREAD_SIZE * ((__slave * __stats->task_n) + __task)));
+    }
+
+    return rc_thread;
+}/// eris_stats_thread
+
+
+/**
+ * @Brief: Dump stats document of json, slaves and their threads.
+ *
+ * @Param: __stats, Shared stats.
+ * @Param: __out,   Output json document.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+eris_int_t eris_stats_dump_json( eris_stats_t *__stats, eris_string_t *__out)
+{
+    eris_int_t rc = 0;
+
+    if ( __stats && __out) {
+        eris_int_t i = 0;
+        eris_int_t k = 0;
+        eris_int_t s = 0;
+
+        rc = eris_string_printf( __out, "{\"uptime\":%l,\"slaves\":[", (eris_long_t )(time( NULL) - __stats->start));
+
+        for ( i = 0; (0 == rc) && (i < __stats->slave_n); i++) {
+            eris_stats_slave_t *p_slave  = eris_stats_slave( __stats, i);
+            eris_uint_t         active_n = 0;
+
+            /** Active connections of slave are handled by its threads */
+            for ( k = 0; k < __stats->task_n; k++) {
+                active_n += eris_stats_thread( __stats, i, k)->active ? 1 : 0;
+            }
+
+            rc = eris_string_printf_append( __out,
+                                            "%s{\"index\":%i,\"pid\":%i,\"connections\":{\"active\":%u,\"idle\":%u},"
+                                            "\"queue\":{\"depth\":%u,\"high\":%u},"
+                                            "\"respawn\":{\"count\":%u,\"crashes\":%u,\"backoff_ms\":%u,\"last_exit\":%i,\"last_signal\":%i},"
+                                            "\"overload\":{\"accept_paused\":%u,\"accept_pauses\":%u,"
+                                            "\"shed\":{\"depth\":%u,\"latency\":%u,\"full\":%u},"
+                                            "\"limited\":{\"rate\":%u,\"conns\":%u}},"
+                                            "\"threads\":[",
+                                            (0 < i) ? "," : "",
+                                            i,
+                                            (eris_int_t )p_slave->pid,
+                                            active_n,
+                                            (eris_uint_t )p_slave->idle,
+                                            (eris_uint_t )p_slave->queue_depth,
+                                            (eris_uint_t )p_slave->queue_high,
+                                            (eris_uint_t )p_slave->respawns,
+                                            (eris_uint_t )p_slave->crashes,
+                                            (eris_uint_t )p_slave->backoff,
+                                            p_slave->last_exit,
+                                            p_slave->last_signal,
+                                            (eris_uint_t )p_slave->accept_paused,
+                                            (eris_uint_t )p_slave->accept_pauses,
+                                            (eris_uint_t )p_slave->shed[ ERIS_STATS_SHED_DEPTH],
+                                            (eris_uint_t )p_slave->shed[ ERIS_STATS_SHED_LATENCY],
+                                            (eris_uint_t )p_slave->shed[ ERIS_STATS_SHED_FULL],
+                                            (eris_uint_t )p_slave->limited[ ERIS_STATS_LIMIT_RATE],
+                                            (eris_uint_t )p_slave->limited[ ERIS_STATS_LIMIT_CONNS]);
+
+            for ( k = 0; (0 == rc) && (k < __stats->task_n); k++) {
+                eris_stats_thread_t *p_thread = eris_stats_thread( __stats, i, k);
+
+                rc = eris_string_printf_append( __out,
+                                                "%s{\"index\":%i,\"active\":%u,\"requests\":%U,\"bytes_in\":%U,\"bytes_out\":%U,"
+                                                "\"module_calls\":%U,\"module_errors\":%U,\"status\":{",
+                                                (0 < k) ? "," : "",
+                                                k,
+                                                (eris_uint_t )(p_thread->active ? 1 : 0),
+                                                (eris_ullong_t )p_thread->requests,
+                                                (eris_ullong_t )p_thread->bytes_in,
+                                                (eris_ullong_t )p_thread->bytes_out,
+                                                (eris_ullong_t )p_thread->module_calls,
+                                                (eris_ullong_t )p_thread->module_errors);
+
+                for ( s = 0; (0 == rc) && (s < ERIS_STATS_STATUS_N); s++) {
+                    rc = eris_string_printf_append( __out, "%s\"%s\":%U",
+                                                    (0 < s) ? "," : "",
+                                                    eris_stats_status_names[ s],
+                                                    (eris_ullong_t )p_thread->status[ s]);
+                }
+
+                if ( 0 == rc) {
+                    rc = eris_string_append( __out, "}}");
+                }
+            }
+
+            if ( 0 == rc) {
+                rc = eris_string_append( __out, "]}");
+            }
+        }
+
+        if ( 0 == rc) {
+            rc = eris_string_append( __out, "]}\n");
+        }
+    } else { rc = EERIS_ERROR; }
+
+    return rc;
+}/// eris_stats_dump_json
+
+
+/**
+ * @Brief: Record a duration into histogram of thread counters.
+ *
+ * @Param: __counters, Thread counters, NULL is ignored.
+ * @Param: __hist,     Histogram id.
+ * @Param: __usec,     Duration of microseconds.
+ *
+ * @Return: Nothing.
+ **/
+eris_none_t eris_stats_hist_record( eris_stats_thread_t *__counters, eris_stats_hist_id_t __hist, eris_uint64_t __usec)
+{
+    if ( __counters && (0 <= __hist) && (__hist < ERIS_STATS_HIST_N)) {
+        eris_int_t index = 0;
+
+        if ( __usec < (1 << ERIS_STATS_HIST_SUB_BITS)) {
+            /** Linear part */
+            index = (eris_int_t )__usec;
+
+        } else {
+            /** Highest bit, and linear sub bucket below it */
+            eris_int_t    e = 0;
+            eris_uint64_t v = __usec;
+
+            while ( 1 < v) { v >>= 1; e++; }
+
+            if ( e < ERIS_STATS_HIST_MAX_BITS) {
+                index = ((e - ERIS_STATS_HIST_SUB_BITS + 1) << ERIS_STATS_HIST_SUB_BITS) + 
+                        (eris_int_t )((__usec >> (e - ERIS_STATS_HIST_SUB_BITS)) & ((1 << ERIS_STATS_HIST_SUB_BITS) - 1));
+
+            } else { index = ERIS_STATS_HIST_BUCKETS - 1; }
+        }
+
+        /** Thread of draining slave and of new slave write the same slot */
+        (eris_none_t )eris_atomic_fetch_add( &(__counters->hists[ __hist].sum), __usec);
+        (eris_none_t )eris_atomic_fetch_inc( &(__counters->hists[ __hist].buckets[ index]));
+    }
+}/// eris_stats_hist_record
+
+
+/**
+ * @Brief: Dump stats of Prometheus text format, slaves are merged.
+ *
+ * @Param: __stats, Shared stats.
+ * @Param: __out,   Output text document.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+eris_int_t eris_stats_dump_prometheus( eris_stats_t *__stats, eris_string_t *__out)
+{
+    eris_int_t rc = 0;
+
+    if ( __stats && __out) {
+        eris_int_t i = 0;
+        eris_int_t k = 0;
+        eris_int_t s = 0;
+
+        eris_uint64_t counters[ 5]                   = { 0};
+        eris_uint64_t status[ ERIS_STATS_STATUS_N]   = { 0};
+        eris_uint64_t active_n    = 0;
+        eris_uint64_t idle_n      = 0;
+        eris_uint64_t queue_depth = 0;
+        eris_uint64_t queue_high  = 0;
+        eris_uint64_t respawns    = 0;
+        eris_uint64_t crashes     = 0;
+        eris_uint64_t paused_n    = 0;
+        eris_uint64_t pauses      = 0;
+        eris_uint64_t shed[ ERIS_STATS_SHED_N] = { 0};
+        eris_uint64_t limited[ ERIS_STATS_LIMIT_N] = { 0};
+
+        /** Merge counters of all slaves */
+        for ( i = 0; i < __stats->slave_n; i++) {
+            eris_stats_slave_t *p_slave = eris_stats_slave( __stats, i);
+
+            idle_n      += p_slave->idle;
+            queue_depth += p_slave->queue_depth;
+            respawns    += p_slave->respawns;
+            crashes     += p_slave->crashes;
+            paused_n    += p_slave->accept_paused ? 1 : 0;
+            pauses      += p_slave->accept_pauses;
+
+            for ( s = 0; s < ERIS_STATS_SHED_N; s++) {
+                shed[ s] += p_slave->shed[ s];
+            }
+
+            for ( s = 0; s < ERIS_STATS_LIMIT_N; s++) {
+                limited[ s] += p_slave->limited[ s];
+            }
+
+            if ( queue_high < p_slave->queue_high) {
+                queue_high = p_slave->queue_high;
+            }
+
+            for ( k = 0; k < __stats->task_n; k++) {
+                eris_stats_thread_t *p_thread = eris_stats_thread( __stats, i, k);
+
+                active_n    += p_thread->active ? 1 : 0;
+                counters[0] += p_thread->requests;
+                counters[1] += p_thread->bytes_in;
+                counters[2] += p_thread->bytes_out;
+                counters[3] += p_thread->module_calls;
+                counters[4] += p_thread->module_errors;
+
+                for ( s = 0; s < ERIS_STATS_STATUS_N; s++) {
+                    status[ s] += p_thread->status[ s];
+                }
+            }
+        }
+
+        rc = eris_string_printf( __out, 
+                                 "# HELP erishttp_uptime_seconds Seconds since master started.\n"
+                                 "# TYPE erishttp_uptime_seconds gauge\n"
+                                 "erishttp_uptime_seconds %l\n"
+                                 "# HELP erishttp_slaves Slave processors.\n"
+                                 "# TYPE erishttp_slaves gauge\n"
+                                 "erishttp_slaves %i\n"
+                                 "# HELP erishttp_requests_total Responses sent.\n"
+                                 "# TYPE erishttp_requests_total counter\n"
+                                 "erishttp_requests_total %U\n"
+                                 "# HELP erishttp_received_bytes_total Bytes received from clients.\n"
+                                 "# TYPE erishttp_received_bytes_total counter\n"
+                                 "erishttp_received_bytes_total %U\n"
+                                 "# HELP erishttp_sent_bytes_total Bytes sent to clients.\n"
+                                 "# TYPE erishttp_sent_bytes_total counter\n"
+                                 "erishttp_sent_bytes_total %U\n"
+                                 "# HELP erishttp_module_calls_total Module services executed.\n"
+                                 "# TYPE erishttp_module_calls_total counter\n"
+                                 "erishttp_module_calls_total %U\n"
+                                 "# HELP erishttp_module_errors_total Module services failed.\n"
+                                 "# TYPE erishttp_module_errors_total counter\n"
+                                 "erishttp_module_errors_total %U\n"
+                                 "# HELP erishttp_connections Connections of slaves.\n"
+                                 "# TYPE erishttp_connections gauge\n"
+                                 "erishttp_connections{state=\"active\"} %U\n"
+                                 "erishttp_connections{state=\"idle\"} %U\n"
+                                 "# HELP erishttp_queue_depth Event queue depth of slaves.\n"
+                                 "# TYPE erishttp_queue_depth gauge\n"
+                                 "erishttp_queue_depth %U\n"
+                                 "# HELP erishttp_queue_high Event queue high-water of slaves.\n"
+                                 "# TYPE erishttp_queue_high gauge\n"
+                                 "erishttp_queue_high %U\n"
+                                 "# HELP erishttp_slave_respawns_total Slaves respawned by master.\n"
+                                 "# TYPE erishttp_slave_respawns_total counter\n"
+                                 "erishttp_slave_respawns_total %U\n"
+                                 "# HELP erishttp_slave_crashes_total Slaves exited by signal or failure.\n"
+                                 "# TYPE erishttp_slave_crashes_total counter\n"
+                                 "erishttp_slave_crashes_total %U\n"
+                                 "# HELP erishttp_accept_paused Slaves of listener paused by overload.\n"
+                                 "# TYPE erishttp_accept_paused gauge\n"
+                                 "erishttp_accept_paused %U\n"
+                                 "# HELP erishttp_accept_pauses_total Listener paused by overload.\n"
+                                 "# TYPE erishttp_accept_pauses_total counter\n"
+                                 "erishttp_accept_pauses_total %U\n",
+                                 (eris_long_t )(time( NULL) - __stats->start),
+                                 __stats->slave_n,
+                                 (eris_ullong_t )counters[0],
+                                 (eris_ullong_t )counters[1],
+                                 (eris_ullong_t )counters[2],
+                                 (eris_ullong_t )counters[3],
+                                 (eris_ullong_t )counters[4],
+                                 (eris_ullong_t )active_n,
+                                 (eris_ullong_t )idle_n,
+                                 (eris_ullong_t )queue_depth,
+                                 (eris_ullong_t )queue_high,
+                                 (eris_ullong_t )respawns,
+                                 (eris_ullong_t )crashes,
+                                 (eris_ullong_t )paused_n,
+                                 (eris_ullong_t )pauses);
+
+        if ( 0 == rc) {
+            rc = eris_string_append( __out, 
+                                     "# HELP erishttp_shed_total Requests answered 503 by overload of reason.\n"
+                                     "# TYPE erishttp_shed_total counter\n");
+        }
+
+        for ( s = 0; (0 == rc) && (s < ERIS_STATS_SHED_N); s++) {
+            rc = eris_string_printf_append( __out, "erishttp_shed_total{reason=\"%s\"} %U\n", 
+                                            eris_stats_shed_names[ s], 
+                                            (eris_ullong_t )shed[ s]);
+        }
+
+        if ( 0 == rc) {
+            rc = eris_string_append( __out, 
+                                     "# HELP erishttp_limited_total Requests answered 429 by rate limit of reason.\n"
+                                     "# TYPE erishttp_limited_total counter\n");
+        }
+
+        for ( s = 0; (0 == rc) && (s < ERIS_STATS_LIMIT_N); s++) {
+            rc = eris_string_printf_append( __out, "erishttp_limited_total{reason=\"%s\"} %U\n", 
+                                            eris_stats_limit_names[ s], 
+                                            (eris_ullong_t )limited[ s]);
+        }
+
+        if ( 0 == rc) {
+            rc = eris_string_append( __out, 
+                                     "# HELP erishttp_responses_total Responses of status class.\n"
+                                     "# TYPE erishttp_responses_total counter\n");
+        }
+
+        for ( s = 0; (0 == rc) && (s < ERIS_STATS_STATUS_N); s++) {
+            rc = eris_string_printf_append( __out, "erishttp_responses_total{class=\"%s\"} %U\n", 
+                                            eris_stats_status_names[ s], 
+                                            (eris_ullong_t )status[ s]);
+        }
+
+        /** Histograms, buckets are cumulative */
+        eris_int_t h = 0;
+        for ( h = 0; (0 == rc) && (h < ERIS_STATS_HIST_N); h++) {
+            eris_stats_hist_t merged;
+            eris_memory_cleanup( &merged, sizeof( merged));
+
+            for ( i = 0; i < __stats->slave_n; i++) {
+                for ( k = 0; k < __stats->task_n; k++) {
+                    eris_stats_thread_t *p_thread = eris_stats_thread( __stats, i, k);
+
+                    merged.sum += p_thread->hists[ h].sum;
+
+                    for ( s = 0; s < ERIS_STATS_HIST_BUCKETS; s++) {
+                        merged.buckets[ s] += p_thread->hists[ h].buckets[ s];
+                    }
+                }
+            }
+
+            rc = eris_string_printf_append( __out, "# HELP %s %s\n# TYPE %s histogram\n", 
+                                            eris_stats_hist_names[ h],
+                                            eris_stats_hist_helps[ h],
+                                            eris_stats_hist_names[ h]);
+
+            eris_uint64_t count = 0;
+            eris_char_t   seconds_buf[ 32];
+
+            for ( s = 0; (0 == rc) && (s < ERIS_STATS_HIST_BUCKETS); s++) {
+                count += merged.buckets[ s];
+
+                if ( s < (ERIS_STATS_HIST_BUCKETS - 1)) {
+                    rc = eris_string_printf_append( __out, "%s_bucket{le=\"%s\"} %U\n",
+                                                    eris_stats_hist_names[ h],
+                                                    eris_stats_seconds( seconds_buf, sizeof( seconds_buf), eris_stats_hist_upper( s)),
+                                                    (eris_ullong_t )count);
+                }
+            }
+
+            if ( 0 == rc) {
+                rc = eris_string_printf_append( __out, "%s_bucket{le=\"+Inf\"} %U\n%s_sum %s\n%s_count %U\n",
+                                                eris_stats_hist_names[ h],
+                                                (eris_ullong_t )count,
+                                                eris_stats_hist_names[ h],
+                                                eris_stats_seconds( seconds_buf, sizeof( seconds_buf), merged.sum),
+                                                eris_stats_hist_names[ h],
+                                                (eris_ullong_t )count);
+            }
+        }
+    } else { rc = EERIS_ERROR; }
+
+    return rc;
+}/// eris_stats_dump_prometheus
+
+
+/**
+ * @Brief: Upper bound of histogram bucket, it is inclusive microseconds.
+ *
+ * @Param: __index, Bucket index, but not overflow bucket.
+ *
+ * @Return: Upper bound of microseconds.
+ **/
+static eris_uint64_t eris_stats_hist_upper( eris_int_t __index)
+{
+    eris_uint64_t rc_upper = 0;
+
+    if ( __index < (1 << ERIS_STATS_HIST_SUB_BITS)) {
+        rc_upper = (eris_uint64_t )__index;
+
+    } else {
+        eris_int_t e   = (__index >> ERIS_STATS_HIST_SUB_BITS) + ERIS_STATS_HIST_SUB_BITS - 1;
+        eris_int_t sub = __index & ((1 << ERIS_STATS_HIST_SUB_BITS) - 1);
+
+        rc_upper = ((eris_uint64_t )((1 << ERIS_STATS_HIST_SUB_BITS) + sub + 1) << (e - ERIS_STATS_HIST_SUB_BITS)) - 1;
+    }
+
+    return rc_upper;
+}/// eris_stats_hist_upper
+
+
+/**
+ * @Brief: Format microseconds to seconds string.
+ *
+ * @Param: __buf,  Output buffer.
+ * @Param: __size, Output buffer size.
+ * @Param: __usec, Microseconds.
+ *
+ * @Return: Output buffer.
+ **/
+static const eris_char_t *eris_stats_seconds( eris_char_t *__buf, eris_size_t __size, eris_uint64_t __usec)
+{
+    (eris_none_t )snprintf( __buf, __size, "%llu.%06llu", 
+                            (eris_ullong_t )(__usec / 1000000), 
+                            (eris_ullong_t )(__usec % 1000000));
+
+    return __buf;
+}/// eris_stats_seconds
+
+
+/**
+ * @Brief: Destroy shared stats segment.
+ *
+ * @Param: __stats, Shared stats.
+ *
+ * @Return: Nothing.
+ **/
+eris_none_t eris_stats_destroy( eris_stats_t *__stats)
+{
+    if ( __stats) {
+        (eris_none_t )munmap( __stats, __stats->size);
+    }
+}/// eris_stats_destroy
+
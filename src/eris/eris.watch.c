@@ -0,0 +1,565 @@
+/****************************************************************************//*
+ ** @CopyRight (C) 石正贤(Shizhengxian)
+ **
+ ** @Brief :
+ **        : Watch files of doc_root and module libfiles in master, and
+ **        : publish change generations to slaves by shared memory.
+ **
+ ******************************************************************************/
+
+#include "eris.config.h"
+
+#include "os/unix/eris.unix.h"
+
+#include "eris/erishttp.h"
+
+#if (ERIS_HAVE_SYS_INOTIFY_H)
+#include <sys/inotify.h>
+#endif
+
+
+#if (ERIS_HAVE_SYS_INOTIFY_H)
+
+/** Watched directory element type */
+typedef struct eris_watch_dir_s eris_watch_dir_t;
+struct eris_watch_dir_s {
+    eris_int_t       wd;               /** Inotify watch         */
+    eris_bool_t      doc;              /** Under doc_root        */
+    eris_bool_t      module;           /** Has module libfiles   */
+    eris_string_t    path;             /** Directory full path   */
+};
+
+/** Watcher thread context type */
+typedef struct eris_watch_context_s eris_watch_context_t;
+struct eris_watch_context_s {
+    eris_fd_t         fd;              /** Inotify descriptor    */
+    pthread_t         tid;             /** Watcher thread        */
+    eris_bool_t       running;         /** Thread is started     */
+    eris_atomic_t     stop;            /** Stop flag             */
+    eris_watch_t     *watch;           /** Shared generations    */
+    eris_module_t    *module;          /** Module libfiles       */
+    pthread_mutex_t  *lock;            /** Held of events, forks wait */
+    eris_log_t       *log;             /** Dump log context      */
+    eris_size_t       doc_root_size;   /** doc_root path size    */
+    eris_watch_dir_t *dirs;            /** Watched directories   */
+    eris_size_t       dirs_n;          /** Used of dirs          */
+    eris_size_t       dirs_size;       /** Capacity of dirs      */
+};
+
+static eris_watch_context_t eris_watch_context = { -1, 0, false, 0, NULL, NULL, NULL, NULL, 0, NULL, 0, 0};
+
+
+/** Find watched directory of inotify watch. */
+static eris_watch_dir_t *eris_watch_dir_find( eris_int_t __wd);
+
+/** Add inotify watch of directory. */
+static eris_watch_dir_t *eris_watch_dir_add( const eris_char_t *__path, eris_uint32_t __mask);
+
+/** Add watches of doc_root directory and its sub directories. */
+static eris_none_t eris_watch_doc_add( const eris_char_t *__path);
+
+/** Execute an inotify event. */
+static eris_none_t eris_watch_event_exec( const struct inotify_event *__event);
+
+/** Watcher thread handler. */
+static eris_void_t *eris_watch_handler( eris_void_t *__arg);
+
+/** Events of doc_root directories */
+#define ERIS_WATCH_DOC_MASK    (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB | IN_ONLYDIR | IN_DONT_FOLLOW)
+
+/** Events of module libfile directories */
+#define ERIS_WATCH_MODULE_MASK (IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB | IN_ONLYDIR)
+
+#endif /** ERIS_HAVE_SYS_INOTIFY_H */
+
+
+
+/**
+ * @Brief: Create shared generations, it is done in master before slaves spawned.
+ *
+ * @Param: __log, Dump log message context.
+ *
+ * @Return: Ok is shared generations, Other is NULL.
+ **/
+eris_watch_t *eris_watch_create( eris_log_t *__log)
+{
+    eris_watch_t *rc_watch = (eris_watch_t *)mmap( NULL, sizeof( eris_watch_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if ( MAP_FAILED == rc_watch) {
+        rc_watch = NULL;
+
+        if ( __log) {
+            eris_log_dump( __log, ERIS_LOG_ERROR, "Map shared watch generations failed, errno.<%d>", errno);
+        }
+    }
+
+    return rc_watch;
+}/// eris_watch_create
+
+
+/**
+ * @Brief: Start watcher thread of doc_root directories and module libfiles.
+ *
+ * @Param: __watch,    Shared generations.
+ * @Param: __doc_root, Static file document root path.
+ * @Param: __module,   Eris module context, libfiles are watched.
+ * @Param: __lock,     Held of executing events, NULL is none.
+ * @Param: __log,      Dump log message context.
+ *
+ * @Return: Ok is 0, Unsupported is EERIS_UNSUPPORT, Other is EERIS_ERROR.
+ **/
+eris_int_t eris_watch_start( eris_watch_t *__watch, const eris_char_t *__doc_root, eris_module_t *__module, pthread_mutex_t *__lock, eris_log_t *__log)
+{
+    eris_int_t rc = 0;
+
+#if (ERIS_HAVE_SYS_INOTIFY_H)
+    if ( __watch && __doc_root && !eris_watch_context.running) {
+        eris_watch_context.watch         = __watch;
+        eris_watch_context.module        = __module;
+        eris_watch_context.lock          = __lock;
+        eris_watch_context.log           = __log;
+        eris_watch_context.doc_root_size = strlen( __doc_root);
+        eris_watch_context.stop          = 0;
+
+        eris_watch_context.fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC);
+        if ( 0 <= eris_watch_context.fd) {
+            eris_bool_t module_watched = true;
+
+            /** Directories of module libfiles, a replaced libfile is moved or written in */
+            if ( __module) {
+                eris_list_iter_t elem_iter; {
+                    eris_list_iter_init( &(__module->context), &elem_iter);
+                }
+
+                eris_module_elem_t *cur_elem = NULL;
+                for ( ; (NULL != (cur_elem = eris_list_iter_next( &elem_iter))); ) {
+                    eris_char_t *p_slash = strrchr( cur_elem->libfile, '/');
+                    if ( p_slash && (p_slash > cur_elem->libfile)) {
+                        eris_char_t dir_path[ PATH_MAX];
+
+                        if ( (eris_size_t )(p_slash - cur_elem->libfile) < sizeof( dir_path)) {
+                            memcpy( dir_path, cur_elem->libfile, p_slash - cur_elem->libfile);
+                            dir_path[ p_slash - cur_elem->libfile] = '\0';
+
+                            eris_watch_dir_t *p_dir = eris_watch_dir_add( dir_path, ERIS_WATCH_MODULE_MASK);
+                            if ( p_dir) {
+                                p_dir->module = true;
+
+                            } else {
+                                module_watched = false;
+
+                                if ( __log) {
+                                    eris_log_dump( __log, ERIS_LOG_WARN, "Watch module directory.<%s> failed, errno.<%d>", dir_path, errno);
+                                }
+                            }
+                        }
+                    }
+                }
+
+                eris_list_iter_cleanup( &(elem_iter));
+            }
+
+            /** doc_root and its sub directories, any failed is not active */
+            __watch->active = 1;
+
+            eris_watch_doc_add( __doc_root);
+
+            if ( 0 < eris_watch_context.dirs_n) {
+                rc = pthread_create( &(eris_watch_context.tid), NULL, eris_watch_handler, NULL);
+                if ( 0 == rc) {
+                    eris_watch_context.running = true;
+
+                    /** Module generation is not 0, resident libfiles are dropped by it */
+                    if ( __module && module_watched) {
+                        __watch->module = 1;
+                    }
+                } else {
+                    if ( __log) {
+                        eris_log_dump( __log, ERIS_LOG_ERROR, "Create watcher thread failed, rc.<%d>", rc);
+                    }
+
+                    rc = EERIS_ERROR;
+                }
+            } else { rc = EERIS_ERROR; }
+
+            if ( 0 != rc) {
+                eris_watch_stop();
+            }
+        } else {
+            rc = EERIS_ERROR;
+
+            if ( __log) {
+                eris_log_dump( __log, ERIS_LOG_ERROR, "Init inotify failed, errno.<%d>", errno);
+            }
+        }
+    } else { rc = EERIS_ERROR; }
+#else
+    rc = EERIS_UNSUPPORT;
+
+    if ( __log) {
+        eris_log_dump( __log, ERIS_LOG_NOTICE, "Watch files unsupported, static caches are expired by time");
+    }
+#endif
+
+    return rc;
+}/// eris_watch_start
+
+
+/**
+ * @Brief: Stop watcher thread.
+ *
+ * @Param: None.
+ *
+ * @Return: Nothing.
+ **/
+eris_none_t eris_watch_stop( eris_none_t)
+{
+#if (ERIS_HAVE_SYS_INOTIFY_H)
+    if ( eris_watch_context.running) {
+        eris_watch_context.stop = 1;
+
+        (eris_none_t )pthread_join( eris_watch_context.tid, NULL);
+
+        eris_watch_context.running = false;
+    }
+
+    if ( eris_watch_context.watch) {
+        eris_watch_context.watch->active = 0;
+        eris_watch_context.watch->module = 0;
+    }
+
+    if ( 0 <= eris_watch_context.fd) {
+        close( eris_watch_context.fd);
+
+        eris_watch_context.fd = -1;
+    }
+
+    if ( eris_watch_context.dirs) {
+        eris_size_t i = 0;
+
+        for ( i = 0; i < eris_watch_context.dirs_n; i++) {
+            eris_string_free( eris_watch_context.dirs[ i].path);
+        }
+
+        eris_memory_free( eris_watch_context.dirs);
+    }
+
+    eris_watch_context.dirs      = NULL;
+    eris_watch_context.dirs_n    = 0;
+    eris_watch_context.dirs_size = 0;
+#endif
+}/// eris_watch_stop
+
+
+/**
+ * @Brief: Destroy shared generations.
+ *
+ * @Param: __watch, Shared generations.
+ *
+ * @Return: Nothing.
+ **/
+eris_none_t eris_watch_destroy( eris_watch_t *__watch)
+{
+    if ( __watch) {
+        (eris_none_t )munmap( __watch, sizeof( eris_watch_t));
+    }
+}/// eris_watch_destroy
+
+
+/**
+ * @Brief: Hash of path relative to doc_root, it is FNV-1a.
+ *
+ * @Param: __path, Path relative to doc_root.
+ *
+ * @Return: Hash value.
+ **/
+eris_uint32_t eris_watch_hash( const eris_char_t *__path)
+{
+    eris_uint32_t hash = 2166136261U;
+
+    for ( ; *__path; __path++) {
+        hash ^= (eris_uchar_t )*__path;
+        hash *= 16777619U;
+    }
+
+    return hash;
+}/// eris_watch_hash
+
+
+
+#if (ERIS_HAVE_SYS_INOTIFY_H)
+
+/**
+ * @Brief: Find watched directory of inotify watch.
+ *
+ * @Param: __wd, Inotify watch.
+ *
+ * @Return: Found is directory element, Other is NULL.
+ **/
+static eris_watch_dir_t *eris_watch_dir_find( eris_int_t __wd)
+{
+    eris_size_t i = 0;
+
+    for ( i = 0; i < eris_watch_context.dirs_n; i++) {
+        if ( __wd == eris_watch_context.dirs[ i].wd) {
+            return &(eris_watch_context.dirs[ i]);
+        }
+    }
+
+    return NULL;
+}/// eris_watch_dir_find
+
+
+/**
+ * @Brief: Add inotify watch of directory, the same directory is one element.
+ *
+ * @Param: __path, Directory full path.
+ * @Param: __mask, Events mask.
+ *
+ * @Return: Ok is directory element, Other is NULL.
+ **/
+static eris_watch_dir_t *eris_watch_dir_add( const eris_char_t *__path, eris_uint32_t __mask)
+{
+    eris_watch_dir_t *rc_dir = NULL;
+
+    eris_int_t wd = inotify_add_watch( eris_watch_context.fd, __path, __mask | IN_MASK_ADD);
+    if ( 0 <= wd) {
+        rc_dir = eris_watch_dir_find( wd);
+        if ( !rc_dir) {
+            if ( eris_watch_context.dirs_n == eris_watch_context.dirs_size) {
+                eris_size_t new_size = (0 < eris_watch_context.dirs_size) ? (eris_watch_context.dirs_size * 2) : 64;
+
+                eris_watch_dir_t *new_dirs = (eris_watch_dir_t *)eris_memory_realloc( eris_watch_context.dirs, new_size * sizeof( eris_watch_dir_t));
+                if ( new_dirs) {
+                    eris_watch_context.dirs      = new_dirs;
+                    eris_watch_context.dirs_size = new_size;
+                }
+            }
+
+            if ( eris_watch_context.dirs_n < eris_watch_context.dirs_size) {
+                rc_dir = &(eris_watch_context.dirs[ eris_watch_context.dirs_n]);
+
+                rc_dir->wd     = wd;
+                rc_dir->doc    = false;
+                rc_dir->module = false;
+                rc_dir->path   = eris_string_create( __path);
+                if ( rc_dir->path) {
+                    eris_watch_context.dirs_n++;
+
+                } else { rc_dir = NULL; }
+            }
+
+            if ( !rc_dir) {
+                (eris_none_t )inotify_rm_watch( eris_watch_context.fd, wd);
+            }
+        }
+    }
+
+    return rc_dir;
+}/// eris_watch_dir_add
+
+
+/**
+ * @Brief: Add watches of doc_root directory and its sub directories, a failed
+ *       : directory is not watched and doc_root is not active of slaves. A renamed
+ *       : directory is added of its new path, and paths of it are renamed.
+ *
+ * @Param: __path, Directory full path.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t eris_watch_doc_add( const eris_char_t *__path)
+{
+    eris_watch_dir_t *p_dir = eris_watch_dir_add( __path, ERIS_WATCH_DOC_MASK);
+    if ( p_dir) {
+        p_dir->doc = true;
+
+        /** Renamed directory has its watch yet, its path and paths of sub directories are set again */
+        if ( !p_dir->module && (0 != strcmp( p_dir->path, __path))) {
+            if ( 0 != eris_string_set( &(p_dir->path), __path)) {
+                eris_watch_context.watch->active = 0;
+            }
+        }
+
+        /** Sub directories are added after watch, so nothing is lost between */
+        DIR *p_dirp = opendir( __path);
+        if ( p_dirp) {
+            struct dirent *p_dent = NULL;
+
+            while ( NULL != (p_dent = readdir( p_dirp))) {
+                if ( ('.' == p_dent->d_name[ 0]) &&
+                     (('\0' == p_dent->d_name[ 1]) || (('.' == p_dent->d_name[ 1]) && ('\0' == p_dent->d_name[ 2]))) ) {
+                    continue;
+                }
+
+                eris_char_t sub_path[ PATH_MAX];
+                if ( (eris_int_t )sizeof( sub_path) > snprintf( sub_path, sizeof( sub_path), "%s/%s", __path, p_dent->d_name)) {
+                    eris_stat_t sub_info;
+
+                    if ( (0 == lstat( sub_path, &sub_info)) && S_ISDIR( sub_info.st_mode)) {
+                        eris_watch_doc_add( sub_path);
+                    }
+                }
+            }
+
+            (eris_none_t )closedir( p_dirp);
+        }
+    } else {
+        eris_watch_context.watch->active = 0;
+
+        if ( eris_watch_context.log) {
+            eris_log_dump( eris_watch_context.log, ERIS_LOG_WARN, "Watch doc directory.<%s> failed, errno.<%d>", __path, errno);
+        }
+    }
+}/// eris_watch_doc_add
+
+
+/**
+ * @Brief: Execute an inotify event, bump generation of changed path.
+ *
+ * @Param: __event, Inotify event.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t eris_watch_event_exec( const struct inotify_event *__event)
+{
+    eris_watch_t *p_watch = eris_watch_context.watch;
+
+    if ( IN_Q_OVERFLOW & __event->mask) {
+        /** Events are lost, all paths maybe changed */
+        eris_atomic_fetch_inc( &(p_watch->all));
+
+        if ( 0 < p_watch->module) {
+            eris_atomic_fetch_inc( &(p_watch->module));
+        }
+
+        return;
+    }
+
+    eris_watch_dir_t *p_dir = eris_watch_dir_find( __event->wd);
+    if ( !p_dir) { return; }
+
+    if ( IN_IGNORED & __event->mask) {
+        /** Directory is removed, and its watch is gone */
+        eris_size_t i = (eris_size_t )(p_dir - eris_watch_context.dirs);
+
+        eris_string_free( p_dir->path);
+
+        eris_watch_context.dirs[ i] = eris_watch_context.dirs[ eris_watch_context.dirs_n - 1];
+        eris_watch_context.dirs_n--;
+
+        return;
+    }
+
+    if ( 0 == __event->len) { return; }
+
+    eris_char_t full_path[ PATH_MAX];
+    if ( (eris_int_t )sizeof( full_path) <= snprintf( full_path, sizeof( full_path), "%s/%s", p_dir->path, __event->name)) {
+        eris_atomic_fetch_inc( &(p_watch->all));
+
+        return;
+    }
+
+    /** Dirs maybe reallocated by added directories, flags are kept before it */
+    eris_bool_t dir_doc    = p_dir->doc;
+    eris_bool_t dir_module = p_dir->module;
+
+    p_dir = NULL;
+
+    if ( dir_doc) {
+        const eris_char_t *p_rel = full_path + eris_watch_context.doc_root_size;
+        while ( '/' == *p_rel) { p_rel++; }
+
+        eris_atomic_fetch_inc( &(eris_watch_bucket( p_watch, eris_watch_hash( p_rel))));
+
+        if ( IN_ISDIR & __event->mask) {
+            if ( (IN_CREATE | IN_MOVED_TO) & __event->mask) {
+                eris_watch_doc_add( full_path);
+            }
+
+            /** Paths under directory are changed */
+            eris_atomic_fetch_inc( &(p_watch->all));
+        }
+    }
+
+    if ( dir_module && (0 < p_watch->module)) {
+        eris_list_iter_t elem_iter; {
+            eris_list_iter_init( &(eris_watch_context.module->context), &elem_iter);
+        }
+
+        eris_module_elem_t *cur_elem = NULL;
+        for ( ; (NULL != (cur_elem = eris_list_iter_next( &elem_iter))); ) {
+            if ( 0 == strcmp( cur_elem->libfile, full_path)) {
+                eris_atomic_fetch_inc( &(p_watch->module));
+
+                if ( eris_watch_context.log) {
+                    eris_log_dump( eris_watch_context.log, ERIS_LOG_NOTICE, "Module libfile.<%s> changed, it is reloaded", full_path);
+                }
+
+                break;
+            }
+        }
+
+        eris_list_iter_cleanup( &(elem_iter));
+    }
+}/// eris_watch_event_exec
+
+
+/**
+ * @Brief: Watcher thread handler, read inotify events until stop.
+ *
+ * @Param: __arg, Nothing.
+ *
+ * @Return: Nothing is NULL.
+ **/
+static eris_void_t *eris_watch_handler( eris_void_t *__arg)
+{
+    /** Events buffer aligned of inotify event */
+    eris_char_t events_buf[ 16 * 1024] __attribute__ ((aligned( __alignof__( struct inotify_event))));
+
+    /** Changes before the thread are published */
+    eris_atomic_fetch_inc( &(eris_watch_context.watch->all));
+
+    while ( !eris_watch_context.stop) {
+        struct pollfd pfd; {
+            pfd.fd      = eris_watch_context.fd;
+            pfd.events  = POLLIN;
+            pfd.revents = 0;
+        }
+
+        eris_int_t rc = poll( &pfd, 1, 500);
+        if ( 0 < rc) {
+            ssize_t events_size = read( eris_watch_context.fd, events_buf, sizeof( events_buf));
+            if ( 0 < events_size) {
+                const eris_char_t *p_ev = events_buf;
+
+                /** Module list and logs are used of events, master forks out of them */
+                if ( eris_watch_context.lock) { (eris_none_t )pthread_mutex_lock( eris_watch_context.lock); }
+
+                while ( p_ev < (events_buf + events_size)) {
+                    const struct inotify_event *p_event = (const struct inotify_event *)p_ev;
+
+                    eris_watch_event_exec( p_event);
+
+                    p_ev += sizeof( struct inotify_event) + p_event->len;
+                }
+
+                if ( eris_watch_context.lock) { (eris_none_t )pthread_mutex_unlock( eris_watch_context.lock); }
+            }
+        } else if ( (0 > rc) && (EINTR != errno)) {
+            if ( eris_watch_context.log) {
+                eris_log_dump( eris_watch_context.log, ERIS_LOG_ERROR, "Poll inotify failed, errno.<%d>", errno);
+            }
+
+            break;
+        }
+    }
+
+    /** Slaves are back to time expired, and libfiles are not resident */
+    eris_watch_context.watch->active = 0;
+    eris_watch_context.watch->module = 0;
+
+    return NULL;
+}/// eris_watch_handler
+
+#endif /** ERIS_HAVE_SYS_INOTIFY_H */
+
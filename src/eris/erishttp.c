@@ -26,6 +26,9 @@ static eris_int_t erishttp_config_get( const eris_char_t *__key_path, eris_strin
 /** Init erishttp config attributes. */
 static eris_int_t erishttp_attrs_init( eris_none_t);
 
+/** Get doc_root path of config. */
+static eris_int_t erishttp_doc_root_get( eris_string_t *__doc_root);
+
 /** Free mime type element. */
 static eris_none_t erishttp_mime_types_free( erishttp_mime_type_t *__mt);
 
@@ -35,6 +38,9 @@ static eris_none_t erishttp_mime_types_exec( const eris_string_t __mime, const e
 /** Init erishttp mime-types . */
 static eris_none_t erishttp_mime_types_init( eris_none_t);
 
+/** Destroy erishttp mime-types list and hash table. */
+static eris_none_t erishttp_mime_types_destroy( eris_none_t);
+
 /** Destroy erishttp config attributes. */
 static eris_none_t erishttp_attrs_destroy( eris_none_t);
 
@@ -50,18 +56,72 @@ static eris_int_t erishttp_socket_create( eris_none_t);
 /** Create erishttp admin listen socket. */
 static eris_int_t erishttp_admin_socket_create( eris_none_t);
 
+/** Listen socket inherited from old master of binary upgrade. */
+static eris_sock_t erishttp_socket_inherit( eris_int_t __index);
+
 /** Slave worker instance. */
 static eris_none_t erishttp_slave_main( eris_int_t __index);
 
 /** Spawn worker progressors */
 static eris_int_t erishttp_spawn_slaves( eris_none_t);
 
+/** Fork a slave of index */
+static eris_pid_t erishttp_spawn_slave( eris_int_t __index);
+
+/** Fork of master, other master threads are quiescent */
+static eris_pid_t erishttp_fork( eris_none_t);
+
+/** New slave of reload reads config again. */
+static eris_int_t erishttp_slave_reconfig( eris_none_t);
+
+/** Start supervisor thread of slaves */
+static eris_int_t erishttp_supervise_start( eris_none_t);
+
+/** Stop supervisor thread of slaves */
+static eris_none_t erishttp_supervise_stop( eris_none_t);
+
+/** Supervisor thread, reap and respawn slaves */
+static eris_void_t *erishttp_supervise_handler( eris_void_t *__arg);
+
+/** A slave is reaped, respawn is scheduled with backoff */
+static eris_none_t erishttp_supervise_reap( eris_pid_t __pid, eris_int_t __status);
+
+/** Connections of addresses held by a reaped slave are given back. */
+static eris_none_t erishttp_supervise_reclaim( eris_pid_t __pid);
+
+/** Reload of SIGHUP, slaves are replaced one by one. */
+static eris_none_t erishttp_supervise_reload( eris_none_t);
+
+/** Master reads config of reload, watcher is started again of changed doc_root. */
+static eris_none_t erishttp_supervise_rewatch( eris_none_t);
+
+/** Binary upgrade of SIGUSR2, new master inherits listen sockets. */
+static eris_none_t erishttp_supervise_upgrade( eris_none_t);
+
 /** Slave enent dispatch execute */
 static eris_none_t erishttp_slave_event_exec( eris_event_elem_t *__elem, eris_arg_t __arg);
 
+/** Update shared counters of slave */
+static eris_none_t erishttp_slave_stats_update( eris_none_t);
+
+/** Slave stops accepts, and is over after busy sockets. */
+static eris_none_t erishttp_slave_drain( eris_none_t);
+
+/** Overload of event queue, new requests are shed. */
+static eris_int_t erishttp_slave_overload( eris_int_t __put_n);
+
+/** Answer preformatted 503 or 429 and close, it is not entered into tasks. */
+static eris_none_t erishttp_slave_reject( eris_sock_t __sock, const eris_string_t __response);
+
+/** Accepts are paused of full event queue, and resumed at half. */
+static eris_none_t erishttp_slave_accept_update( eris_none_t);
+
 /** Admin event dispatch execute. */
 static eris_none_t erishttp_admin_event_exec( eris_event_elem_t *__elem, eris_arg_t __arg);
 
+/** Admin http request */
+static eris_none_t erishttp_admin_request( eris_sock_t __sock);
+
 
 
 /****************************************************************//*
@@ -95,8 +155,33 @@ int main( int argc, char **argv, char **env)
 
         erishttp_context.svc_sock   = -1;
         erishttp_context.admin_sock = -1;
+        erishttp_context.doc_root_fd= -1;
+        erishttp_context.watch      = NULL;
+        erishttp_context.stats      = NULL;
+        erishttp_context.ratelimit  = NULL;
+        erishttp_context.slave_index= -1;
         erishttp_context.slave_pids = NULL;
+        erishttp_context.respawns   = NULL;
         erishttp_context.tasks_http = NULL;
+
+        erishttp_context.supervise_stop = 0;
+        erishttp_context.supervising    = false;
+
+        (eris_none_t )pthread_mutex_init( &(erishttp_context.fork_lock), NULL);
+
+        erishttp_context.reload      = 0;
+        erishttp_context.upgrade     = 0;
+        erishttp_context.quit        = 0;
+        erishttp_context.draining    = false;
+        erishttp_context.generation  = 0;
+        erishttp_context.upgrade_pid = -1;
+        erishttp_context.busy        = 0;
+        eris_string_init( erishttp_context.exe);
+        eris_string_init( erishttp_context.shed_response);
+        eris_string_init( erishttp_context.limit_response);
+
+        erishttp_context.mime_slots      = NULL;
+        erishttp_context.mime_slots_size = 0;
     ERISHTTP_BLOCK_END
 
 
@@ -288,6 +373,12 @@ int main( int argc, char **argv, char **env)
             /** Is not test, then goto next */
             if ( 0 < eris_string_size( erishttp_context.prefix)) {
                 if ( bl_set_config) {
+                    /** Config is read again by reload after daemon changed working directory */
+                    eris_char_t config_file_buf[ PATH_MAX] = {0};
+                    if ( realpath( config_file, config_file_buf)) {
+                        (eris_none_t )eris_string_set( &config_file, config_file_buf);
+                    }
+
                     erishttp_context.cfile = eris_string_clone_eris( config_file);
                     if ( !erishttp_context.cfile) {
                         goto_next = false;
@@ -310,6 +401,18 @@ int main( int argc, char **argv, char **env)
                     }
                 }
             }
+
+            /** Binary pathname is executed by upgrade */
+            if ( goto_next) {
+                eris_char_t exe_buf[ PATH_MAX] = {0};
+
+                if ( strchr( argv[0], '/') && realpath( argv[0], exe_buf)) {
+                    (eris_none_t )eris_string_set( &(erishttp_context.exe), exe_buf);
+
+                } else {
+                    (eris_none_t )eris_string_set( &(erishttp_context.exe), argv[0]);
+                }
+            }
         }
     }
     
@@ -449,6 +552,8 @@ int main( int argc, char **argv, char **env)
             eris_log_destroy( &(erishttp_context.access_log));
             eris_log_destroy( &(erishttp_context.errors_log));
             eris_log_destroy( &(erishttp_context.module_log));
+            eris_log_destroy( &(erishttp_context.slow_log));
+            eris_logfmt_destroy( &(erishttp_context.access_logfmt));
 
             erishttp_attrs_destroy();
 
@@ -478,6 +583,8 @@ int main( int argc, char **argv, char **env)
             eris_log_destroy( &(erishttp_context.access_log));
             eris_log_destroy( &(erishttp_context.errors_log));
             eris_log_destroy( &(erishttp_context.module_log));
+            eris_log_destroy( &(erishttp_context.slow_log));
+            eris_logfmt_destroy( &(erishttp_context.access_logfmt));
 
             erishttp_attrs_destroy();
 
@@ -520,9 +627,11 @@ int main( int argc, char **argv, char **env)
             eris_log_destroy( &(erishttp_context.access_log));
             eris_log_destroy( &(erishttp_context.errors_log));
             eris_log_destroy( &(erishttp_context.module_log));
+            eris_log_destroy( &(erishttp_context.slow_log));
+            eris_logfmt_destroy( &(erishttp_context.access_logfmt));
 
             erishttp_attrs_destroy();
-            eris_list_destroy( &(erishttp_context.mime_types), (eris_list_free_cb_t )erishttp_mime_types_free);
+            erishttp_mime_types_destroy();
 
             /** Exit processor */
             exit( rc); 
@@ -551,9 +660,11 @@ int main( int argc, char **argv, char **env)
             eris_log_destroy( &(erishttp_context.access_log));
             eris_log_destroy( &(erishttp_context.errors_log));
             eris_log_destroy( &(erishttp_context.module_log));
+            eris_log_destroy( &(erishttp_context.slow_log));
+            eris_logfmt_destroy( &(erishttp_context.access_logfmt));
 
             erishttp_attrs_destroy();
-            eris_list_destroy( &(erishttp_context.mime_types), (eris_list_free_cb_t )erishttp_mime_types_free);
+            erishttp_mime_types_destroy();
 
             /** Exit processor */
             exit( rc); 
@@ -585,9 +696,11 @@ int main( int argc, char **argv, char **env)
             eris_log_destroy( &(erishttp_context.access_log));
             eris_log_destroy( &(erishttp_context.errors_log));
             eris_log_destroy( &(erishttp_context.module_log));
+            eris_log_destroy( &(erishttp_context.slow_log));
+            eris_logfmt_destroy( &(erishttp_context.access_logfmt));
 
             erishttp_attrs_destroy();
-            eris_list_destroy( &(erishttp_context.mime_types), (eris_list_free_cb_t )erishttp_mime_types_free);
+            erishttp_mime_types_destroy();
 
             /** Exit processor */
             exit( rc); 
@@ -595,6 +708,43 @@ int main( int argc, char **argv, char **env)
     ERISHTTP_BLOCK_END
 
 
+    /** Open doc_root once, static files are opened relative to it */
+    ERISHTTP_BLOCK_BEGIN
+        erishttp_context.doc_root_fd = open( erishttp_context.attrs.doc_root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if ( 0 > erishttp_context.doc_root_fd) {
+            erishttp_errors_log_dump( ERIS_LOG_WARN, "Open doc_root.<%s> failed, static files are not found, errno.<%d>", 
+                                      erishttp_context.attrs.doc_root, errno);
+        }
+    ERISHTTP_BLOCK_END
+
+
+    /** Shared watch generations, slaves get it by fork */
+    ERISHTTP_BLOCK_BEGIN
+        erishttp_context.watch = eris_watch_create( &(erishttp_context.errors_log));
+        if ( erishttp_context.watch) {
+            erishttp_context.mcontext.generation = &(erishttp_context.watch->module);
+        }
+    ERISHTTP_BLOCK_END
+
+
+    /** Shared counters of slaves, they are read by admin listener */
+    ERISHTTP_BLOCK_BEGIN
+        erishttp_context.stats = eris_stats_create( erishttp_context.attrs.worker_n, 
+                                                    erishttp_context.attrs.worker_task_n, 
+                                                    &(erishttp_context.errors_log));
+    ERISHTTP_BLOCK_END
+
+
+    /** Shared token buckets of client addresses, NULL is off */
+    ERISHTTP_BLOCK_BEGIN
+        erishttp_context.ratelimit = eris_ratelimit_create( (eris_uint32_t )erishttp_context.attrs.rate_limit,
+                                                            (eris_uint32_t )erishttp_context.attrs.rate_limit_burst,
+                                                            (eris_uint32_t )erishttp_context.attrs.rate_limit_conns,
+                                                            erishttp_context.attrs.worker_n,
+                                                            &(erishttp_context.errors_log));
+    ERISHTTP_BLOCK_END
+
+
     /** Spawn worker processors */
     ERISHTTP_BLOCK_BEGIN
         goto_next = true;
@@ -603,9 +753,7 @@ int main( int argc, char **argv, char **env)
             goto_next = false;
         }
 
-        eris_socket_close( erishttp_context.svc_sock);
-        erishttp_context.svc_sock = -1;
-
+        /** Server socket is kept by master, respawned slaves listen it */
         if ( !goto_next) { 
             erishttp_destroy( false);
 
@@ -614,6 +762,31 @@ int main( int argc, char **argv, char **env)
         }
     ERISHTTP_BLOCK_END
 
+    /** Watch doc_root and module libfiles, slaves caches are dropped by changes */
+    if ( erishttp_context.watch && (0 <= erishttp_context.doc_root_fd)) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = eris_watch_start( erishttp_context.watch, 
+                               erishttp_context.attrs.doc_root, 
+                               &(erishttp_context.mcontext), 
+                               &(erishttp_context.fork_lock),
+                               &(erishttp_context.errors_log));
+        if ( 0 != rc) {
+            erishttp_errors_log_dump( ERIS_LOG_WARN, "Start watcher failed, static caches are expired by time, rc.<%d>", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+
+    /** Supervise slaves, a dead slave is respawned */
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_supervise_start();
+        if ( 0 != rc) {
+            erishttp_errors_log_dump( ERIS_LOG_WARN, "Start supervisor failed, dead slaves are not respawned, rc.<%d>", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+
     /** Init admin server evnet */
     ERISHTTP_BLOCK_BEGIN
         goto_next = true;
@@ -833,10 +1006,35 @@ static eris_int_t erishttp_attrs_init( eris_none_t)
         erishttp_context.attrs.url_max_size      = 1024UL;
         erishttp_context.attrs.header_max_size   = 4096UL;
         erishttp_context.attrs.body_max_size     = 10 * 1024 * 1024UL;
+        erishttp_context.attrs.body_spool_size   = 1024 * 1024UL;
+        eris_string_init( erishttp_context.attrs.body_spool_path);
 
         erishttp_context.attrs.log_max_size = 64 * 1024 * 1024UL;
         eris_string_init( erishttp_context.attrs.log_path);
         eris_string_init( erishttp_context.attrs.doc_root);
+
+        erishttp_context.attrs.gzip            = 0;
+        erishttp_context.attrs.gzip_static     = 0;
+        erishttp_context.attrs.gzip_level      = 1;
+        erishttp_context.attrs.gzip_min_length = 1024UL;
+        eris_string_init( erishttp_context.attrs.gzip_types);
+
+        erishttp_context.attrs.static_miss_ttl = 2;
+
+        erishttp_context.attrs.slow_request_time = 1000;
+        eris_string_init( erishttp_context.attrs.log_format);
+
+        erishttp_context.attrs.flight_recorder = 1;
+
+        erishttp_context.attrs.drain_timeout = 30;
+
+        erishttp_context.attrs.shed_queue_depth = 0;
+        erishttp_context.attrs.shed_queue_time  = 0;
+        erishttp_context.attrs.shed_retry_after = 1;
+
+        erishttp_context.attrs.rate_limit       = 0;
+        erishttp_context.attrs.rate_limit_burst = 0;
+        erishttp_context.attrs.rate_limit_conns = 0;
     ERISHTTP_BLOCK_END
 
     eris_string_t tmp_es = eris_string_alloc( 64);
@@ -1419,6 +1617,26 @@ static eris_int_t erishttp_attrs_init( eris_none_t)
     eris_string_cleanup( tmp_es);
 
 
+    /** Get body_spool_size */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "body_spool_size", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int64_t tmp_size = eris_util_unit_toi64( tmp_es);
+            if ( 0 <= tmp_size) {
+                erishttp_context.attrs.body_spool_size = (eris_size_t )tmp_size;
+            }
+        }
+
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: body_spool_size, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
+
+
     /** Get log_max_size */
     if ( 0 == rc ) 
     ERISHTTP_BLOCK_BEGIN
@@ -1478,705 +1696,2157 @@ static eris_int_t erishttp_attrs_init( eris_none_t)
     /** Get doc_root path */
     if ( 0 == rc) 
     ERISHTTP_BLOCK_BEGIN
-        rc = erishttp_config_get( "doc_root", &tmp_es, NULL);
+        rc = erishttp_doc_root_get( &(erishttp_context.attrs.doc_root));
+    ERISHTTP_BLOCK_END
+
+
+    /** Get body_spool_path */
+    if ( 0 == rc) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "body_spool_path", &tmp_es, NULL);
         if ( (0 == rc) && (0 < eris_string_size( tmp_es))) {
             if ( '/' == tmp_es[0]) {
-                erishttp_context.attrs.doc_root = eris_string_clone_eris( tmp_es);
-                if ( !erishttp_context.attrs.doc_root) {
+                erishttp_context.attrs.body_spool_path = eris_string_clone_eris( tmp_es);
+                if ( !erishttp_context.attrs.body_spool_path) {
                     rc = EERIS_ERROR;
 
-                    erishttp_stderr_print( "[ERROR]: Merge doc_root failed, errno.<%d>\n", errno);
+                    erishttp_stderr_print( "[ERROR]: Merge body_spool_path failed, errno.<%d>\n", errno);
                 }
             } else {
-                rc = eris_string_printf( &(erishttp_context.attrs.doc_root), "%S/%S", erishttp_context.prefix, tmp_es);
+                rc = eris_string_printf( &(erishttp_context.attrs.body_spool_path), "%S/%S", erishttp_context.prefix, tmp_es);
                 if ( 0 != rc) {
                     rc = EERIS_ERROR;
 
-                    erishttp_stderr_print( "[ERROR]: Merge doc_root failed, errno.<%d>\n", errno);
+                    erishttp_stderr_print( "[ERROR]: Merge body_spool_path failed, errno.<%d>\n", errno);
                 }
             }
         } else {
             if ( EERIS_NOTFOUND == rc) {
-                erishttp_stdout_print( "[NOTICE]: Not found a config option: doc_root, rc.<%d>\n", rc);
+                erishttp_stdout_print( "[NOTICE]: Not found a config option: body_spool_path, rc.<%d>\n", rc);
 
-                rc = eris_string_printf( &(erishttp_context.attrs.doc_root), "%S/var/www/htdoc", erishttp_context.prefix);
+                rc = eris_string_printf( &(erishttp_context.attrs.body_spool_path), "%S/var/tmp", erishttp_context.prefix);
                 if ( 0 != rc) {
                     rc = EERIS_ERROR;
 
-                    erishttp_stderr_print( "[ERROR]: Merge doc_root failed, errno.<%d>\n", errno);
+                    erishttp_stderr_print( "[ERROR]: Merge body_spool_path failed, errno.<%d>\n", errno);
                 }
-            } else { erishttp_stdout_print( "[ERROR]: Get log_path option failed, errno.<%d>\n", errno); }
+            } else { erishttp_stdout_print( "[ERROR]: Get body_spool_path option failed, errno.<%d>\n", errno); }
         }
     ERISHTTP_BLOCK_END
-    
-    eris_string_free( tmp_es);
-    eris_string_init( tmp_es);
+    eris_string_cleanup( tmp_es);
 
-    return rc;
-}/// erishttp_attrs_init
 
+    /** Get gzip flag */
+    if ( 0 == rc)
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "gzip", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            if ( eris_string_isequal( tmp_es, "on", true)) {
+                erishttp_context.attrs.gzip = 1;
+            }
+        }
 
-/**
- * @Brief: Free mime type element.
- *
- * @Param: __mt, MIME-type element pointer.
- *
- * @Return: Nothing.
- **/
-static eris_none_t erishttp_mime_types_free( erishttp_mime_type_t *__mt)
-{
-    eris_string_free( __mt->mime);
-    eris_string_free( __mt->types);
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: gzip, rc.<%d>\n", rc);
 
-    eris_memory_free( __mt);
-}/// erishttp_mime_types_free
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
 
 
-/**
- * @Brief: erishttp mime-types callback.
- *
- * @Param: None.
- *
- * @Return: Nothing.
- **/
-static eris_none_t erishttp_mime_types_exec( const eris_string_t __mime, const eris_string_t __types)
-{
-    if ( __mime && __types) {
-        eris_int_t rc = 0;
+    /** Get gzip_static flag */
+    if ( 0 == rc)
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "gzip_static", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            if ( eris_string_isequal( tmp_es, "on", true)) {
+                erishttp_context.attrs.gzip_static = 1;
+            }
+        }
 
-        erishttp_mime_type_t *new_mime_types = (erishttp_mime_type_t *)eris_memory_alloc( sizeof( erishttp_mime_type_t));
-        if ( new_mime_types) {
-            new_mime_types->mime  = eris_string_clone_eris( __mime);
-            new_mime_types->types = eris_string_clone_eris( __types);
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: gzip_static, rc.<%d>\n", rc);
 
-            eris_string_append_c( &(new_mime_types->types), ' ');
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
 
-            rc = eris_list_push( &(erishttp_context.mime_types), new_mime_types, 0);
-            if (0 != rc) {
-                erishttp_mime_types_free( new_mime_types);
+
+    /** Get gzip_level number */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "gzip_level", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int_t tmp_gzip_level = eris_string_atoi( tmp_es);
+            if ( (1 <= tmp_gzip_level) && (9 >= tmp_gzip_level)) {
+                erishttp_context.attrs.gzip_level = tmp_gzip_level;
             }
         }
-    }
-}/// erishttp_mime_types_exec
 
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: gzip_level, rc.<%d>\n", rc);
 
-/**
- * @Brief: Init erishttp mime-types. 
- *
- * @Param: None.
- *
- * @Return: Nothing.
- **/
-static eris_none_t erishttp_mime_types_init( eris_none_t)
-{
-    eris_list_init( &(erishttp_context.mime_types), false, &(erishttp_context.errors_log));
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
 
-    const eris_char_t *p_mt_key_path = "http.mime-types";
-    if ( eris_cftree_existed( &(erishttp_context.cftree), p_mt_key_path, &(erishttp_context.errors_log)) ) {
-        /** Each all mime-types */
-        eris_cftree_each( &(erishttp_context.cftree), p_mt_key_path, erishttp_mime_types_exec, &(erishttp_context.errors_log));
 
-    } else {
-        p_mt_key_path = "mime-types";
+    /** Get gzip_min_length */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "gzip_min_length", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int64_t tmp_size = eris_util_unit_toi64( tmp_es);
+            if ( 0 <= tmp_size) {
+                erishttp_context.attrs.gzip_min_length = (eris_size_t )tmp_size;
+            }
+        }
 
-        if ( eris_cftree_existed( &(erishttp_context.cftree), p_mt_key_path, &(erishttp_context.errors_log)) ) {
-            /** Each all mime-types */
-            eris_cftree_each( &(erishttp_context.cftree), p_mt_key_path, erishttp_mime_types_exec, &(erishttp_context.errors_log));
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: gzip_min_length, rc.<%d>\n", rc);
 
+            rc = 0;
         }
-    }
-}/// erishttp_mime_types_init
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
 
 
-/**
- * @Brief: Destroy erishttp config attributes.
- *
- * @Param: None.
- *
- * @Return: Nothing.
- **/
-static eris_none_t erishttp_attrs_destroy( eris_none_t)
-{
-    /** Eris init */
+    /** Get gzip_types, media types are compared in lowercase */
+    if ( 0 == rc ) 
     ERISHTTP_BLOCK_BEGIN
-        /** Release attributes */
-        eris_string_free( erishttp_context.attrs.user);
-        eris_string_free( erishttp_context.attrs.group);
-        eris_string_free( erishttp_context.attrs.pidfile);
-        eris_string_free( erishttp_context.attrs.listen);
-        eris_string_free( erishttp_context.attrs.admin_listen);
-        eris_string_free( erishttp_context.attrs.log_path);
-        eris_string_free( erishttp_context.attrs.doc_root);
+        rc = erishttp_config_get( "gzip_types", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            rc = eris_string_set_eris( &(erishttp_context.attrs.gzip_types), tmp_es);
 
-        eris_memory_free( erishttp_context.attrs.cpuset);
-        erishttp_context.attrs.cpuset = NULL;
+        } else if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: gzip_types, rc.<%d>\n", rc);
 
-        /** Reinit */
-        eris_string_init( erishttp_context.attrs.user);
-        eris_string_init( erishttp_context.attrs.group);
-        eris_string_init( erishttp_context.attrs.pidfile);
-        eris_string_init( erishttp_context.attrs.listen);
-        eris_string_init( erishttp_context.attrs.admin_listen);
-        eris_string_init( erishttp_context.attrs.log_path);
-        eris_string_init( erishttp_context.attrs.doc_root);
-    ERISHTTP_BLOCK_END
-}/// erishttp_attrs_destroy
+            rc = eris_string_set( &(erishttp_context.attrs.gzip_types), "text/html");
+        }
 
+        if ( 0 == rc) {
+            eris_size_t i = 0;
+            eris_size_t gzip_types_size = eris_string_size( erishttp_context.attrs.gzip_types);
 
-/**
- * @Brief: Init erishttp context logs context.
- *
- * @Param: None.
- *
- * @Return: Ok is 0, Other is EERIS_ERROR.
- **/
-static eris_int_t erishttp_logs_init( eris_none_t )
-{
-    eris_int_t       rc = 0;
-    eris_log_level_t log_level    = erishttp_context.attrs.log_level;
-    eris_size_t      log_max_size = erishttp_context.attrs.log_max_size;
+            for ( i = 0; i < gzip_types_size; i++) {
+                erishttp_context.attrs.gzip_types[ i] = tolower( (eris_uchar_t )erishttp_context.attrs.gzip_types[ i]);
+            }
+        } else { erishttp_stderr_print( "[ERROR]: Save gzip_types failed, errno.<%d>\n", errno); }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
 
-    eris_string_t access_log_es;
-    eris_string_t errors_log_es;
-    eris_string_t module_log_es;
 
-    eris_string_init( access_log_es);
-    eris_string_init( errors_log_es);
-    eris_string_init( module_log_es);
+    /** Get static_miss_ttl seconds, 0 is disabled */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "static_miss_ttl", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int_t tmp_ttl = eris_string_atoi( tmp_es);
+            if ( 0 <= tmp_ttl) {
+                erishttp_context.attrs.static_miss_ttl = tmp_ttl;
+            }
+        }
 
-    /** Make all logs */
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: static_miss_ttl, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
+
+
+    /** Get slow_request_time milliseconds, 0 is disabled */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "slow_request_time", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int_t tmp_ms = eris_string_atoi( tmp_es);
+            if ( 0 <= tmp_ms) {
+                erishttp_context.attrs.slow_request_time = tmp_ms;
+            }
+        }
+
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: slow_request_time, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
+
+
+    /** Get log_format of access log, enclosing single quotes are stripped */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "log_format", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_size_t format_size = eris_string_size( tmp_es);
+
+            if ( (2 <= format_size) && ('\'' == tmp_es[ 0]) && ('\'' == tmp_es[ format_size - 1])) {
+                rc = eris_string_append_n( &(erishttp_context.attrs.log_format), tmp_es + 1, format_size - 2);
+
+            } else {
+                rc = eris_string_set_eris( &(erishttp_context.attrs.log_format), tmp_es);
+            }
+
+            if ( 0 != rc) { erishttp_stderr_print( "[ERROR]: Save log_format failed, errno.<%d>\n", errno); }
+        }
+
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: log_format, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
+
+
+    /** Get flight_recorder flag */
+    if ( 0 == rc)
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "flight_recorder", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            if ( eris_string_isequal( tmp_es, "off", true)) {
+                erishttp_context.attrs.flight_recorder = 0;
+            }
+        }
+
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: flight_recorder, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
+
+
+    /** Get drain_timeout seconds of old slaves */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "drain_timeout", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int_t tmp_drain_timeout = eris_string_atoi( tmp_es);
+            if ( 0 < tmp_drain_timeout) {
+                erishttp_context.attrs.drain_timeout = tmp_drain_timeout;
+            }
+        }
+
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: drain_timeout, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
+
+
+    /** Get shed_queue_depth of event queue, 0 is off */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "shed_queue_depth", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int_t tmp_depth = eris_string_atoi( tmp_es);
+            if ( 0 <= tmp_depth) {
+                erishttp_context.attrs.shed_queue_depth = tmp_depth;
+            }
+        }
+
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: shed_queue_depth, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
+
+
+    /** Get shed_queue_time milliseconds of event queue wait, 0 is off */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "shed_queue_time", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int_t tmp_ms = eris_string_atoi( tmp_es);
+            if ( 0 <= tmp_ms) {
+                erishttp_context.attrs.shed_queue_time = tmp_ms;
+            }
+        }
+
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: shed_queue_time, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
+
+
+    /** Get shed_retry_after seconds of 503 */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "shed_retry_after", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int_t tmp_retry_after = eris_string_atoi( tmp_es);
+            if ( 0 <= tmp_retry_after) {
+                erishttp_context.attrs.shed_retry_after = tmp_retry_after;
+            }
+        }
+
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: shed_retry_after, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
+
+
+    /** Get rate_limit requests of second of a client address, 0 is off */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "rate_limit", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int_t tmp_rate = eris_string_atoi( tmp_es);
+            if ( 0 <= tmp_rate) {
+                erishttp_context.attrs.rate_limit = tmp_rate;
+            }
+        }
+
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: rate_limit, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
+
+
+    /** Get rate_limit_burst requests of token bucket, 0 is same as rate_limit */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "rate_limit_burst", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int_t tmp_burst = eris_string_atoi( tmp_es);
+            if ( 0 <= tmp_burst) {
+                erishttp_context.attrs.rate_limit_burst = tmp_burst;
+            }
+        }
+
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: rate_limit_burst, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    eris_string_cleanup( tmp_es);
+
+
+    /** Get rate_limit_conns requests in handling of a client address, 0 is off */
+    if ( 0 == rc ) 
+    ERISHTTP_BLOCK_BEGIN
+        rc = erishttp_config_get( "rate_limit_conns", &tmp_es, NULL);
+        if ( (0 == rc) && (0 < eris_string_size( tmp_es)) ) {
+            eris_int_t tmp_conns = eris_string_atoi( tmp_es);
+            if ( 0 <= tmp_conns) {
+                erishttp_context.attrs.rate_limit_conns = tmp_conns;
+            }
+        }
+
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: rate_limit_conns, rc.<%d>\n", rc);
+
+            rc = 0;
+        }
+    ERISHTTP_BLOCK_END
+    
+    eris_string_free( tmp_es);
+    eris_string_init( tmp_es);
+
+    return rc;
+}/// erishttp_attrs_init
+
+
+/**
+ * @Brief: Get doc_root path of config, relative path is of prefix.
+ *
+ * @Param: __doc_root, Output doc_root path.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+static eris_int_t erishttp_doc_root_get( eris_string_t *__doc_root)
+{
+    eris_int_t rc = 0;
+
+    eris_string_t tmp_es;
+    eris_string_init( tmp_es);
+
+    rc = erishttp_config_get( "doc_root", &tmp_es, NULL);
+    if ( (0 == rc) && (0 < eris_string_size( tmp_es))) {
+        if ( '/' == tmp_es[0]) {
+            *__doc_root = eris_string_clone_eris( tmp_es);
+            if ( !*__doc_root) {
+                rc = EERIS_ERROR;
+
+                erishttp_stderr_print( "[ERROR]: Merge doc_root failed, errno.<%d>\n", errno);
+            }
+        } else {
+            rc = eris_string_printf( __doc_root, "%S/%S", erishttp_context.prefix, tmp_es);
+            if ( 0 != rc) {
+                rc = EERIS_ERROR;
+
+                erishttp_stderr_print( "[ERROR]: Merge doc_root failed, errno.<%d>\n", errno);
+            }
+        }
+    } else {
+        if ( EERIS_NOTFOUND == rc) {
+            erishttp_stdout_print( "[NOTICE]: Not found a config option: doc_root, rc.<%d>\n", rc);
+
+            rc = eris_string_printf( __doc_root, "%S/var/www/htdoc", erishttp_context.prefix);
+            if ( 0 != rc) {
+                rc = EERIS_ERROR;
+
+                erishttp_stderr_print( "[ERROR]: Merge doc_root failed, errno.<%d>\n", errno);
+            }
+        } else { erishttp_stdout_print( "[ERROR]: Get log_path option failed, errno.<%d>\n", errno); }
+    }
+
+    eris_string_free( tmp_es);
+
+    return rc;
+}/// erishttp_doc_root_get
+
+
+/**
+ * @Brief: Free mime type element.
+ *
+ * @Param: __mt, MIME-type element pointer.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t erishttp_mime_types_free( erishttp_mime_type_t *__mt)
+{
+    eris_string_free( __mt->mime);
+    eris_string_free( __mt->types);
+
+    eris_memory_free( __mt);
+}/// erishttp_mime_types_free
+
+
+/**
+ * @Brief: erishttp mime-types callback.
+ *
+ * @Param: None.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t erishttp_mime_types_exec( const eris_string_t __mime, const eris_string_t __types)
+{
+    if ( __mime && __types) {
+        eris_int_t rc = 0;
+
+        erishttp_mime_type_t *new_mime_types = (erishttp_mime_type_t *)eris_memory_alloc( sizeof( erishttp_mime_type_t));
+        if ( new_mime_types) {
+            new_mime_types->mime  = eris_string_clone_eris( __mime);
+            new_mime_types->types = eris_string_clone_eris( __types);
+
+            /** Extensions match without case */
+            if ( new_mime_types->types) {
+                eris_size_t i = 0;
+                eris_size_t types_size = eris_string_size( new_mime_types->types);
+
+                for ( i = 0; i < types_size; i++) {
+                    new_mime_types->types[ i] = tolower( (eris_uchar_t )new_mime_types->types[ i]);
+                }
+            }
+
+            rc = eris_list_push( &(erishttp_context.mime_types), new_mime_types, 0);
+            if (0 != rc) {
+                erishttp_mime_types_free( new_mime_types);
+            }
+        }
+    }
+}/// erishttp_mime_types_exec
+
+
+/**
+ * @Brief: Init erishttp mime-types. 
+ *
+ * @Param: None.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t erishttp_mime_types_init( eris_none_t)
+{
+    eris_list_init( &(erishttp_context.mime_types), false, &(erishttp_context.errors_log));
+
+    const eris_char_t *p_mt_key_path = "http.mime-types";
+    if ( eris_cftree_existed( &(erishttp_context.cftree), p_mt_key_path, &(erishttp_context.errors_log)) ) {
+        /** Each all mime-types */
+        eris_cftree_each( &(erishttp_context.cftree), p_mt_key_path, erishttp_mime_types_exec, &(erishttp_context.errors_log));
+
+    } else {
+        p_mt_key_path = "mime-types";
+
+        if ( eris_cftree_existed( &(erishttp_context.cftree), p_mt_key_path, &(erishttp_context.errors_log)) ) {
+            /** Each all mime-types */
+            eris_cftree_each( &(erishttp_context.cftree), p_mt_key_path, erishttp_mime_types_exec, &(erishttp_context.errors_log));
+
+        }
+    }
+
+    /** Count all extensions */
+    eris_size_t ext_count = 0;
+    erishttp_mime_type_t *p_mt = NULL;
+
+    eris_list_iter_t mt_iter; {
+        eris_list_iter_init( &(erishttp_context.mime_types), &mt_iter);
+    }
+
+    for ( ; (NULL != (p_mt = eris_list_iter_next( &mt_iter))); ) {
+        const eris_char_t *p_types = p_mt->types;
+
+        while ( p_types && *p_types) {
+            while ( isspace( (eris_uchar_t )*p_types)) { p_types++; }
+            if ( *p_types) { ext_count++; }
+            while ( *p_types && !isspace( (eris_uchar_t )*p_types)) { p_types++; }
+        }
+    }
+
+    if ( 0 < ext_count) {
+        /** Keep the load factor under one half */
+        eris_size_t slots_size = 16;
+        while ( slots_size < (ext_count * 2)) { slots_size <<= 1; }
+
+        erishttp_context.mime_slots = (erishttp_mime_slot_t *)eris_memory_calloc( slots_size, sizeof( erishttp_mime_slot_t));
+        if ( erishttp_context.mime_slots) {
+            erishttp_context.mime_slots_size = slots_size;
+
+            eris_list_iter_init( &(erishttp_context.mime_types), &mt_iter);
+
+            for ( ; (NULL != (p_mt = eris_list_iter_next( &mt_iter))); ) {
+                const eris_char_t *p_types = p_mt->types;
+
+                while ( p_types && *p_types) {
+                    while ( isspace( (eris_uchar_t )*p_types)) { p_types++; }
+
+                    const eris_char_t *p_ext = p_types;
+                    while ( *p_types && !isspace( (eris_uchar_t )*p_types)) { p_types++; }
+
+                    eris_size_t ext_len = p_types - p_ext;
+                    if ( 0 < ext_len) {
+                        eris_uint32_t hv = 2166136261u;
+                        eris_size_t   i  = 0;
+
+                        for ( i = 0; i < ext_len; i++) {
+                            hv = (hv ^ (eris_uchar_t )p_ext[ i]) * 16777619u;
+                        }
+
+                        /** Linear probing, the first define is used */
+                        eris_size_t x = hv & (slots_size - 1);
+                        for ( ; (NULL != erishttp_context.mime_slots[ x].ext); x = (x + 1) & (slots_size - 1)) {
+                            if ( (ext_len == erishttp_context.mime_slots[ x].ext_len) && 
+                                 (0 == memcmp( p_ext, erishttp_context.mime_slots[ x].ext, ext_len)) ) {
+                                break;
+                            }
+                        }
+
+                        if ( !erishttp_context.mime_slots[ x].ext) {
+                            erishttp_context.mime_slots[ x].ext     = p_ext;
+                            erishttp_context.mime_slots[ x].ext_len = ext_len;
+                            erishttp_context.mime_slots[ x].mime    = p_mt->mime;
+                        }
+                    }
+                }
+            }
+        } else {
+            erishttp_errors_log_dump( ERIS_LOG_ERROR, "Alloced mime-types hash table failed, errno.<%d>", errno);
+        }
+    }
+}/// erishttp_mime_types_init
+
+
+/**
+ * @Brief: Destroy erishttp mime-types list and hash table.
+ *
+ * @Param: None.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t erishttp_mime_types_destroy( eris_none_t)
+{
+    if ( erishttp_context.mime_slots) {
+        eris_memory_free( erishttp_context.mime_slots);
+
+        erishttp_context.mime_slots = NULL;
+    }
+    erishttp_context.mime_slots_size = 0;
+
+    eris_list_destroy( &(erishttp_context.mime_types), (eris_list_free_cb_t )erishttp_mime_types_free);
+}/// erishttp_mime_types_destroy
+
+
+/**
+ * @Brief: Find Content-Type of file extension, no allocated.
+ *
+ * @Param: __ext,     File extension without dot, any case.
+ * @Param: __ext_len, Extension length.
+ *
+ * @Return: Mime string, not found is NULL.
+ **/
+const eris_char_t *erishttp_mime_type_find( const eris_char_t *__ext, eris_size_t __ext_len)
+{
+    const eris_char_t *p_mime = NULL;
+
+    if ( __ext && (0 < __ext_len) && erishttp_context.mime_slots) {
+        eris_uint32_t hv = 2166136261u;
+        eris_size_t   i  = 0;
+
+        for ( i = 0; i < __ext_len; i++) {
+            hv = (hv ^ (eris_uchar_t )tolower( (eris_uchar_t )__ext[ i])) * 16777619u;
+        }
+
+        eris_size_t mask = erishttp_context.mime_slots_size - 1;
+        eris_size_t x    = hv & mask;
+
+        for ( ; (NULL != erishttp_context.mime_slots[ x].ext); x = (x + 1) & mask) {
+            if ( __ext_len == erishttp_context.mime_slots[ x].ext_len) {
+                const eris_char_t *p_ext = erishttp_context.mime_slots[ x].ext;
+
+                for ( i = 0; i < __ext_len; i++) {
+                    if ( p_ext[ i] != tolower( (eris_uchar_t )__ext[ i])) { break; }
+                }
+
+                if ( i == __ext_len) {
+                    p_mime = erishttp_context.mime_slots[ x].mime;
+
+                    break;
+                }
+            }
+        }
+    }
+
+    return p_mime;
+}/// erishttp_mime_type_find
+
+
+/**
+ * @Brief: Destroy erishttp config attributes.
+ *
+ * @Param: None.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t erishttp_attrs_destroy( eris_none_t)
+{
+    /** Eris init */
+    ERISHTTP_BLOCK_BEGIN
+        /** Release attributes */
+        eris_string_free( erishttp_context.attrs.user);
+        eris_string_free( erishttp_context.attrs.group);
+        eris_string_free( erishttp_context.attrs.pidfile);
+        eris_string_free( erishttp_context.attrs.listen);
+        eris_string_free( erishttp_context.attrs.admin_listen);
+        eris_string_free( erishttp_context.attrs.log_path);
+        eris_string_free( erishttp_context.attrs.doc_root);
+        eris_string_free( erishttp_context.attrs.body_spool_path);
+        eris_string_free( erishttp_context.attrs.gzip_types);
+        eris_string_free( erishttp_context.attrs.log_format);
+
+        eris_memory_free( erishttp_context.attrs.cpuset);
+        erishttp_context.attrs.cpuset = NULL;
+
+        /** Reinit */
+        eris_string_init( erishttp_context.attrs.user);
+        eris_string_init( erishttp_context.attrs.group);
+        eris_string_init( erishttp_context.attrs.pidfile);
+        eris_string_init( erishttp_context.attrs.listen);
+        eris_string_init( erishttp_context.attrs.admin_listen);
+        eris_string_init( erishttp_context.attrs.log_path);
+        eris_string_init( erishttp_context.attrs.doc_root);
+        eris_string_init( erishttp_context.attrs.body_spool_path);
+        eris_string_init( erishttp_context.attrs.gzip_types);
+        eris_string_init( erishttp_context.attrs.log_format);
+    ERISHTTP_BLOCK_END
+}/// erishttp_attrs_destroy
+
+
+/**
+ * @Brief: Init erishttp context logs context, and compile access log format.
+ *
+ * @Param: None.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+static eris_int_t erishttp_logs_init( eris_none_t )
+{
+    eris_int_t       rc = 0;
+    eris_log_level_t log_level    = erishttp_context.attrs.log_level;
+    eris_size_t      log_max_size = erishttp_context.attrs.log_max_size;
+
+    eris_string_t access_log_es;
+    eris_string_t errors_log_es;
+    eris_string_t module_log_es;
+    eris_string_t slow_log_es;
+
+    eris_string_init( access_log_es);
+    eris_string_init( errors_log_es);
+    eris_string_init( module_log_es);
+    eris_string_init( slow_log_es);
+
+    /** Make all logs */
     rc = eris_string_printf( &access_log_es, "%S/erishttp.access.log", erishttp_context.attrs.log_path);
     if ( 0 == rc) {
-        rc = eris_string_printf( &errors_log_es, "%S/erishttp.errors.log", erishttp_context.attrs.log_path);
+        rc = eris_string_printf( &errors_log_es, "%S/erishttp.errors.log", erishttp_context.attrs.log_path);
+        if ( 0 == rc) {
+            rc = eris_string_printf( &module_log_es, "%S/erishttp.module.log", erishttp_context.attrs.log_path);
+            if ( 0 == rc) {
+                rc = eris_string_printf( &slow_log_es, "%S/erishttp.slow.log", erishttp_context.attrs.log_path);
+            }
+
+            if ( 0 == rc) {
+                /** Init all log context */
+                rc = eris_log_init( &(erishttp_context.access_log), access_log_es, log_level, log_max_size);
+                if ( 0 == rc) {
+                    rc = eris_log_init( &(erishttp_context.errors_log), errors_log_es, log_level, log_max_size);
+                    if ( 0 == rc) {
+                        rc = eris_log_init( &(erishttp_context.module_log), module_log_es, log_level, log_max_size);
+                        if ( 0 == rc) {
+                            rc = eris_log_init( &(erishttp_context.slow_log), slow_log_es, log_level, log_max_size);
+                            if ( 0 != rc) {
+                                eris_log_destroy( &(erishttp_context.access_log));
+                                eris_log_destroy( &(erishttp_context.errors_log));
+                                eris_log_destroy( &(erishttp_context.module_log));
+
+                                erishttp_stderr_print( "[ERROR]: Init slow log context failed, errno.<%d>\n", errno);
+                            }
+                        } else {
+                            eris_log_destroy( &(erishttp_context.access_log));
+                            eris_log_destroy( &(erishttp_context.errors_log));
+
+                            erishttp_stderr_print( "[ERROR]: Init module log context failed, errno.<%d>\n", errno);
+                        }
+                    } else { 
+                        eris_log_destroy( &(erishttp_context.access_log));
+
+                        erishttp_stderr_print( "[ERROR]: Init errors log context failed, errno.<%d>\n", errno); 
+                    }
+                } else { erishttp_stderr_print( "[ERROR]: Init access log context failed, errno.<%d>\n", errno); }
+            } else { erishttp_stderr_print( "[ERROR]: Merge module or slow log file string failed, errno.<%d>\n", errno); }
+        } else { erishttp_stderr_print( "[ERROR]: Merge errors log file string failed, errno.<%d>\n", errno); }
+    } else { erishttp_stderr_print( "[ERROR]: Merge access log file string failed, errno.<%d>\n", errno); }
+
+    /** Compile access log format, slaves get it by fork */
+    if ( 0 == rc) {
+        const eris_char_t *p_log_format = NULL;
+        if ( 0 < eris_string_size( erishttp_context.attrs.log_format)) {
+            p_log_format = erishttp_context.attrs.log_format;
+        }
+
+        rc = eris_logfmt_compile( &(erishttp_context.access_logfmt), p_log_format, &(erishttp_context.errors_log));
+        if ( 0 != rc) {
+            eris_log_destroy( &(erishttp_context.access_log));
+            eris_log_destroy( &(erishttp_context.errors_log));
+            eris_log_destroy( &(erishttp_context.module_log));
+            eris_log_destroy( &(erishttp_context.slow_log));
+
+            erishttp_stderr_print( "[ERROR]: Compile log_format failed, rc.<%d>\n", rc);
+        }
+    }
+
+    /** Release all eris string */
+    eris_string_free( access_log_es);
+    eris_string_free( errors_log_es);
+    eris_string_free( module_log_es);
+    eris_string_free( slow_log_es);
+
+    eris_string_init( access_log_es);
+    eris_string_init( errors_log_es);
+    eris_string_init( module_log_es);
+    eris_string_init( slow_log_es);
+
+    return rc;
+}/// erishttp_logs_init
+#undef erishttp_stdout_print
+#undef erishttp_stderr_print
+
+
+/**
+ * @Brief: Init modules of erishttp server.
+ *
+ * @Param: None.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+static eris_int_t erishttp_module_init( eris_none_t)
+{
+    eris_int_t rc = 0;
+
+    eris_string_t tmp_libfile_es;
+    eris_string_t module_path_es;
+    eris_module_info_t mod_info; 
+
+    eris_string_init( tmp_libfile_es);
+    eris_string_init( module_path_es);
+    eris_module_info_init( mod_info);
+
+    enum {
+        ERISHTTP_MODULE_PATTERN = 0,
+        ERISHTTP_MODULE_NAME    ,
+        ERISHTTP_MODULE_LANGUAGE,
+        ERISHTTP_MODULE_LIBFILE ,
+        ERISHTTP_MODULE_LIMIT   ,
+        ERISHTTP_MODULE_ADD     ,
+        ERISHTTP_MODULE_FINISH  ,
+        ERISHTTP_MODULE_ERROR   ,
+    } erishttp_module_state_v = ERISHTTP_MODULE_PATTERN;
+
+    /** Init eris module context */
+    rc = eris_module_init( &(erishttp_context.mcontext), &(erishttp_context.cftree), &(erishttp_context.module_log));
+    if ( 0 == rc) {
+        eris_int_t module_count = eris_cftree_esize( &(erishttp_context.cftree), "http.module", &(erishttp_context.errors_log));
+        if ( 0 >= module_count) {
+            module_count = eris_cftree_esize( &(erishttp_context.cftree), "module", &(erishttp_context.errors_log));
+        }
+
+        erishttp_module_log_dump( ERIS_LOG_DEBUG, "erishttp service modules count.<%d>", module_count);
+
+        /** Get all modules configuration */
+        eris_int_t i = 0;
+        for ( i = 0; i < module_count; i++) {
+            eris_module_info_cleanup( mod_info);
+
+            rc = eris_string_printf( &module_path_es, "module[%i]", i);
+            if ( 0 == rc) {
+                do {
+                    switch ( erishttp_module_state_v) {
+                        case ERISHTTP_MODULE_PATTERN: 
+                            {
+                                erishttp_module_state_v = ERISHTTP_MODULE_NAME;
+
+                                /** Get pattern */
+                                rc = erishttp_config_get( module_path_es, &(mod_info.pattern), &(erishttp_context.errors_log));
+                                if ( !((0 == rc) && (0 < eris_string_size( mod_info.pattern))) ) {
+                                    rc = eris_string_set( &(mod_info.pattern), "/");
+                                    if ( 0 != rc) {
+                                        erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+
+                                        erishttp_module_log_dump( ERIS_LOG_ERROR, "Set module pattern value failed, errno.<%d>", errno);
+
+                                        break;
+                                    }
+                                }
+                            } break;
+                        case ERISHTTP_MODULE_NAME :
+                            {
+                                erishttp_module_state_v = ERISHTTP_MODULE_LANGUAGE;
+
+                                /** Get module name */
+                                rc = eris_string_printf( &module_path_es, "module[%i].name", i);
+                                if ( 0 == rc) {
+                                    rc = erishttp_config_get( module_path_es, &(mod_info.name), &(erishttp_context.errors_log));
+                                    if ( (0 != rc) || (0 == eris_string_size( mod_info.name)) ) {
+                                        erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+
+                                        erishttp_module_log_dump( ERIS_LOG_ERROR, "Get module name.<%s> failed, rc.<%d>", module_path_es, rc);
+                                    }
+
+                                } else {
+                                    erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+
+                                    erishttp_module_log_dump( ERIS_LOG_ERROR, "Make module name key path failed, errno.<%d>", errno);
+                                }
+                            } break;
+                        case ERISHTTP_MODULE_LANGUAGE :
+                            {
+                                erishttp_module_state_v = ERISHTTP_MODULE_LIBFILE;
+
+                                /** Get module language */
+                                rc = eris_string_printf( &module_path_es, "module[%i].language", i);
+                                if ( 0 == rc) {
+                                    rc = erishttp_config_get( module_path_es, &(mod_info.language), &(erishttp_context.errors_log));
+                                    if ( 0 != rc) {
+                                        rc = eris_string_set( &(mod_info.pattern), "c");
+                                        if ( 0 != rc) {
+                                            erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+
+                                            erishttp_module_log_dump( ERIS_LOG_ERROR, "Set module language.<%s> failed, errno.<%d>", module_path_es, errno);
+                                        }
+                                    }
+
+                                } else {
+                                    erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+
+                                    erishttp_module_log_dump( ERIS_LOG_ERROR, "Make module language key path failed, errno.<%d>", errno);
+                                }
+                            } break;
+                        case ERISHTTP_MODULE_LIBFILE :
+                            {
+                                erishttp_module_state_v = ERISHTTP_MODULE_LIMIT;
+
+                                /** Get module libfile */
+                                rc = eris_string_printf( &module_path_es, "module[%i].libfile", i);
+                                if ( 0 == rc) {
+                                    eris_string_t tmp_libfile_es;
+                                    eris_string_init( tmp_libfile_es);
+
+                                    rc = erishttp_config_get( module_path_es, &tmp_libfile_es, &(erishttp_context.errors_log));
+                                    if ( (0 == rc) && (0 < eris_string_size( tmp_libfile_es)) ) {
+                                        if ( '/' == eris_string_at( tmp_libfile_es, 0)) {
+                                            mod_info.libfile = eris_string_clone_eris( tmp_libfile_es);
+
+                                        } else {
+                                            eris_string_printf( &(mod_info.libfile), "%S/%S", 
+                                                                erishttp_context.prefix, 
+                                                                tmp_libfile_es);
+                                        }
+
+                                        if ( !mod_info.libfile) {
+                                            erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+
+                                            erishttp_module_log_dump( ERIS_LOG_ERROR, "Merge module libfile.<%s> failed, rc.<%d>", module_path_es, rc);
+                                        }
+
+                                    } else {
+                                        erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+
+                                        erishttp_module_log_dump( ERIS_LOG_ERROR, "Get module libfile.<%s> failed, rc.<%d>", module_path_es, rc);
+                                    }
+
+                                    eris_string_free( tmp_libfile_es);
+                                    eris_string_init( tmp_libfile_es);
+
+                                } else {
+                                    erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+
+                                    erishttp_module_log_dump( ERIS_LOG_ERROR, "Make module libfile key path failed, errno.<%d>", errno);
+                                }
+                            } break;
+                        case ERISHTTP_MODULE_LIMIT :
+                            {
+                                erishttp_module_state_v = ERISHTTP_MODULE_ADD;
+
+                                /** Get max_concurrency, queue_length and queue_timeout of module, they are optional */
+                                const eris_char_t *limit_keys[ 3] = { "max_concurrency", "queue_length", "queue_timeout"};
+                                eris_int_t        *limit_vals[ 3] = { &(mod_info.max_concurrency), &(mod_info.queue_length), &(mod_info.queue_timeout)};
+
+                                eris_int_t k = 0;
+                                for ( k = 0; k < 3; k++) {
+                                    rc = eris_string_printf( &module_path_es, "module[%i].%s", i, limit_keys[ k]);
+                                    if ( 0 == rc) {
+                                        eris_string_t tmp_limit_es;
+                                        eris_string_init( tmp_limit_es);
+
+                                        rc = erishttp_config_get( module_path_es, &tmp_limit_es, NULL);
+                                        if ( (0 == rc) && (0 < eris_string_size( tmp_limit_es)) ) {
+                                            eris_int_t tmp_limit = eris_string_atoi( tmp_limit_es);
+                                            if ( 0 <= tmp_limit) {
+                                                *(limit_vals[ k]) = tmp_limit;
+                                            }
+                                        }
+
+                                        eris_string_free( tmp_limit_es);
+                                        eris_string_init( tmp_limit_es);
+
+                                        rc = 0;
+                                    } else {
+                                        erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+
+                                        erishttp_module_log_dump( ERIS_LOG_ERROR, "Make module %s key path failed, errno.<%d>", limit_keys[ k], errno);
+
+                                        break;
+                                    }
+                                }
+                            } break;
+                        case ERISHTTP_MODULE_ADD :
+                            {
+                                erishttp_module_state_v = ERISHTTP_MODULE_FINISH;
+
+                                /** Add new module into mcontext */
+                                rc = eris_module_add( &(erishttp_context.mcontext), &mod_info);
+                                if ( 0 != rc) {
+                                    erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+
+                                    erishttp_module_log_dump( ERIS_LOG_ERROR, "Add a module to mcontext failed, errno.<%d>", errno);
+                                }
+                            } break;
+                        case ERISHTTP_MODULE_FINISH:
+                            {
+                                rc = 0;
+
+                                erishttp_module_state_v = ERISHTTP_MODULE_PATTERN;
+                            } break;
+                        case ERISHTTP_MODULE_ERROR :
+                        default : break;
+                    }/// switch ( erishttp_module_state_v)
+
+                    if ( ERISHTTP_MODULE_ERROR == erishttp_module_state_v) {
+                        rc = EERIS_ERROR; break;
+                    }
+                    
+                    if ( ERISHTTP_MODULE_FINISH == erishttp_module_state_v) {
+                        break;
+                    }
+                } while ( 1); /** Get module attributes */
+
+                if ( 0 != rc) { break; }
+            } else { 
+                erishttp_module_log_dump( ERIS_LOG_ERROR, "Make module key path failed, errno.<%d>", errno);
+
+                break;
+            }
+        }/// for ( i = 0; i < module_count; i++);
+
+        /** Happen error */
+        if ( 0 != rc) {
+            eris_module_destroy( &(erishttp_context.mcontext));
+        }
+
+        eris_string_free( tmp_libfile_es);
+        eris_string_free( module_path_es);
+        eris_string_init( tmp_libfile_es);
+        eris_string_init( module_path_es);
+
+        eris_module_info_destroy( mod_info);
+    }/// if module context init ok
+
+    return rc;
+}/// erishttp_module_init
+
+
+/**
+ * @Brief: Create erishttp server listen socket.
+ *
+ * @Param: None.
+ *
+ * @Return: Ok is 0, Other is -1.
+ **/
+static eris_int_t erishttp_socket_create( eris_none_t)
+{
+    eris_int_t rc = 0;
+
+    eris_socket_attr_t sock_attrs;
+    ERISHTTP_BLOCK_BEGIN
+        sock_attrs.nonblock     = 1;
+        sock_attrs.backlog      = erishttp_context.attrs.backlog;
+        sock_attrs.tcp_nodelay  = erishttp_context.attrs.tcp_nodelay;
+        sock_attrs.tcp_nopush   = erishttp_context.attrs.tcp_nopush;
+        sock_attrs.linger       = 0;
+        sock_attrs.zero         = 0;
+        sock_attrs.sendbuf_size = erishttp_context.attrs.send_buffer_size;
+        sock_attrs.recvbuf_size = erishttp_context.attrs.recv_buffer_size;
+    ERISHTTP_BLOCK_END
+
+    /** Create server socket context, it is inherited of binary upgrade */
+    erishttp_context.svc_sock = erishttp_socket_inherit( 0);
+    if ( -1 == erishttp_context.svc_sock) {
+        erishttp_context.svc_sock = eris_socket_tcp_listen( erishttp_context.attrs.listen, 
+                                                            &sock_attrs, 
+                                                            &(erishttp_context.errors_log));
+    }
+    if ( -1 == erishttp_context.svc_sock) {
+        rc = EERIS_ERROR;
+
+        erishttp_errors_log_dump( ERIS_LOG_ERROR, "Create server socket object failed, errno.<%d>", errno);
+    }
+
+    return rc;
+}/// erishttp_socket_create
+
+
+/**
+ * @Brief: Create erishttp admin listen socket.
+ *
+ * @Param: None.
+ *
+ * @Return: Ok is 0, Other is -1.
+ **/
+static eris_int_t erishttp_admin_socket_create( eris_none_t)
+{
+    eris_int_t rc = 0;
+
+    eris_socket_attr_t sock_attrs;
+    ERISHTTP_BLOCK_BEGIN
+        sock_attrs.nonblock     = 1;
+        sock_attrs.backlog      = erishttp_context.attrs.backlog;
+        sock_attrs.tcp_nodelay  = erishttp_context.attrs.tcp_nodelay;
+        sock_attrs.tcp_nopush   = erishttp_context.attrs.tcp_nopush;
+        sock_attrs.linger       = 0;
+        sock_attrs.zero         = 0;
+        sock_attrs.sendbuf_size = erishttp_context.attrs.send_buffer_size;
+        sock_attrs.recvbuf_size = erishttp_context.attrs.recv_buffer_size;
+    ERISHTTP_BLOCK_END
+
+    /** Create admin socket context, it is inherited of binary upgrade */
+    erishttp_context.admin_sock = erishttp_socket_inherit( 1);
+    if ( -1 == erishttp_context.admin_sock) {
+        erishttp_context.admin_sock = eris_socket_tcp_listen( erishttp_context.attrs.admin_listen, 
+                                                              &sock_attrs, 
+                                                              &(erishttp_context.errors_log));
+    }
+
+    if ( -1 == erishttp_context.admin_sock) {
+        rc = EERIS_ERROR;
+
+        erishttp_errors_log_dump( ERIS_LOG_ERROR, "Create admin server socket object failed, errno.<%d>", errno);
+    }
+
+    /** Both sockets are taken, environment is not passed to next upgrade */
+    (eris_none_t )unsetenv( ERISHTTP_LISTEN_FDS_ENV);
+
+    return rc;
+}/// erishttp_admin_socket_create
+
+
+/**
+ * @Brief: Listen socket inherited from old master of binary upgrade, 
+ *         "ERISHTTP_LISTEN_FDS=svc_sock,admin_sock" is set by old master.
+ *
+ * @Param: __index, 0 is svc_sock, 1 is admin_sock.
+ *
+ * @Return: Ok is socket, Other is -1.
+ **/
+static eris_sock_t erishttp_socket_inherit( eris_int_t __index)
+{
+    eris_sock_t a_sock = -1;
+
+    const eris_char_t *p_fds_env = getenv( ERISHTTP_LISTEN_FDS_ENV);
+    if ( p_fds_env) {
+        eris_int_t svc_fd   = -1;
+        eris_int_t admin_fd = -1;
+
+        if ( 2 == sscanf( p_fds_env, "%d,%d", &svc_fd, &admin_fd)) {
+            eris_int_t  a_fd = (0 == __index) ? svc_fd : admin_fd;
+            struct stat sock_info;
+
+            if ( (0 <= a_fd) && (0 == fstat( a_fd, &sock_info)) && S_ISSOCK( sock_info.st_mode)) {
+                a_sock = a_fd;
+
+                erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Inherit listen socket.<%d> of binary upgrade", a_sock);
+            }
+        }
+    }
+
+    return a_sock;
+}/// erishttp_socket_inherit
+
+
+/**
+ * @Brief: Slave worker instance.
+ *
+ * @Param: __index, Processor index number.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t erishttp_slave_main( eris_int_t __index)
+{
+    ERISHTTP_BLOCK_BEGIN
+        erishttp_context.slave_index = __index;
+
+        eris_stats_slave_t *p_stats_slave = eris_stats_slave( erishttp_context.stats, __index);
+        if ( p_stats_slave) {
+            p_stats_slave->pid         = eris_get_pid();
+            p_stats_slave->idle        = 0;
+            p_stats_slave->queue_depth = 0;
+            p_stats_slave->queue_high  = 0;
+        }
+
+        /** Connections of addresses held by this slave are given back by master of its exit */
+        if ( erishttp_context.ratelimit && (0 != eris_ratelimit_ledger_take( erishttp_context.ratelimit, eris_get_pid()))) {
+            erishttp_errors_log_dump( ERIS_LOG_WARN, "Slave index.<%d> - pid.<%d> has no free rate limit ledger", __index, eris_get_pid());
+        }
+
+        /** Flight recorder of task threads */
+        if ( erishttp_context.attrs.flight_recorder) {
+            eris_string_t flight_es;
+            eris_string_init( flight_es);
+
+            if ( 0 == eris_string_printf( &flight_es, "%S/erishttp.flight.%i", erishttp_context.attrs.log_path, __index)) {
+                (eris_none_t )eris_flight_open( flight_es, __index, erishttp_context.attrs.worker_task_n, &(erishttp_context.errors_log));
+            }
+
+            eris_string_free( flight_es);
+            eris_string_init( flight_es);
+        }
+
+        eris_proctitle_set( "slave", __index);
+        erishttp_errors_log_dump( ERIS_LOG_NOTICE, 
+                                  "Slave progress index.<%d> - pid.<%d> ok",
+                                  __index, 
+                                  eris_get_pid());
+    ERISHTTP_BLOCK_END
+
+    /** Enabile/Disable cpu affinity */
+    if ( 1 == erishttp_context.attrs.cpuset_enable) {
+        eris_cpuset_bind( erishttp_context.attrs.cpuset[ __index + 1], 0);
+    }
+
+    eris_int_t rc = 0;
+    rc = eris_signal_init( &(erishttp_context.errors_log));
+
+    if ( 0 == rc)
+    ERISHTTP_BLOCK_BEGIN
+        eris_socket_close( erishttp_context.admin_sock);
+        erishttp_context.admin_sock = -1;
+
+        /** Preformatted 503 of overload, it is written by event thread */
+        rc = eris_string_printf( &(erishttp_context.shed_response), 
+                                 "HTTP/1.1 503 Service Unavailable\r\nServer: %s\r\nContent-Type: text/plain\r\n"
+                                 "Content-Length: 20\r\nRetry-After: %i\r\nConnection: close\r\n\r\nService Unavailable\n",
+                                 ERIS_VERSION_DESC,
+                                 erishttp_context.attrs.shed_retry_after);
+        if ( 0 != rc) {
+            erishttp_errors_log_dump( ERIS_LOG_ERROR, "Make 503 response of overload failed, errno.<%d>", errno);
+        }
+
+        /** Preformatted 429 of rate limit */
+        if ( 0 == rc) {
+            rc = eris_string_printf( &(erishttp_context.limit_response), 
+                                     "HTTP/1.1 429 Too Many Requests\r\nServer: %s\r\nContent-Type: text/plain\r\n"
+                                     "Content-Length: 18\r\nRetry-After: 1\r\nConnection: close\r\n\r\nToo Many Requests\n",
+                                     ERIS_VERSION_DESC);
+            if ( 0 != rc) {
+                erishttp_errors_log_dump( ERIS_LOG_ERROR, "Make 429 response of rate limit failed, errno.<%d>", errno);
+            }
+        }
+
+        /** Init event queue */
+        if ( 0 == rc) {
+            rc = eris_event_queue_init( &(erishttp_context.svc_event_queue), 
+                                        erishttp_context.attrs.max_connections);
+        }
+
+        if ( 0 == rc) {
+            /** Create all task */
+            erishttp_context.tasks_http = (eris_http_t *)eris_memory_alloc( sizeof( eris_http_t) *
+                                                                            erishttp_context.attrs.worker_task_n);
+            if ( erishttp_context.tasks_http) {
+                eris_int_t i = 0;
+                eris_int_t k = 0;
+
+                ERISHTTP_BLOCK_BEGIN
+                eris_http_attr_t http_attrs; {
+                    http_attrs.url_max_size      = erishttp_context.attrs.url_max_size;
+                    http_attrs.header_max_size   = erishttp_context.attrs.header_max_size;
+                    http_attrs.body_max_size     = erishttp_context.attrs.body_max_size;
+                    http_attrs.header_cache_size = erishttp_context.attrs.header_cache_size;
+                    http_attrs.body_cache_size   = erishttp_context.attrs.body_cache_size;
+                    http_attrs.body_defer        = true;
+                    http_attrs.body_spool_size   = erishttp_context.attrs.body_spool_size;
+                    http_attrs.body_spool_path   = erishttp_context.attrs.body_spool_path;
+                    http_attrs.gzip              = erishttp_context.attrs.gzip ? true : false;
+                    http_attrs.gzip_level        = erishttp_context.attrs.gzip_level;
+                    http_attrs.gzip_min_length   = erishttp_context.attrs.gzip_min_length;
+                    http_attrs.gzip_types        = erishttp_context.attrs.gzip_types;
+                    http_attrs.server            = ERIS_VERSION_DESC;
+                }
+
+
+                for ( k = 0; k < erishttp_context.attrs.worker_task_n; k++) {
+                    rc = eris_http_init( &(erishttp_context.tasks_http[ k]), &http_attrs, &(erishttp_context.errors_log));
+                    if ( 0 != rc) {
+                        erishttp_errors_log_dump( ERIS_LOG_ERROR, "Init http context of task woring failed, errno.<%d>", errno);
+
+                        break;
+                    }
+                }
+                ERISHTTP_BLOCK_END
+
+                /** Create tasks http context ok */
+                if ( 0 == rc) {
+                    eris_task_init( &(erishttp_context.tasks), 0);
+
+                    for ( k = 0; k < erishttp_context.attrs.worker_task_n; k++) {
+                        rc = eris_task_create( &(erishttp_context.tasks), 
+                                                eris_slave_handler, 
+                                               &(erishttp_context.tasks_http[ k]), 
+                                               &(erishttp_context.errors_log));
+                        if ( 0 != rc) {
+                            /** Create thread error */
+                            k = erishttp_context.attrs.worker_task_n;
+
+                            break;
+                        }
+                    }
+
+                    /** Create tasks thread ok */
+                    if ( 0 == rc) {
+                        ERISHTTP_BLOCK_BEGIN
+                        eris_event_attr_t evt_attrs; {
+                            evt_attrs.iot              = erishttp_context.attrs.event_iot;
+                            evt_attrs.timeout          = erishttp_context.attrs.timeout;;
+                            evt_attrs.keepalive        = erishttp_context.attrs.keepalive;;
+                            evt_attrs.max_events       = erishttp_context.attrs.max_connections;
+                            evt_attrs.recv_buffer_size = erishttp_context.attrs.recv_buffer_size;
+                            evt_attrs.send_buffer_size = erishttp_context.attrs.send_buffer_size;
+                            evt_attrs.tcp_nodelay      = erishttp_context.attrs.tcp_nodelay;
+                            evt_attrs.tcp_nopush       = erishttp_context.attrs.tcp_nopush;
+                            evt_attrs.zero             = erishttp_context.attrs.zero;
+                            evt_attrs.log              = &(erishttp_context.errors_log);
+                        }
+
+                        /** Init server evnet */
+                        rc = eris_event_init( &(erishttp_context.svc_event), &evt_attrs);
+                        ERISHTTP_BLOCK_END
+
+                        if ( 0 == rc) {
+                            ERISHTTP_BLOCK_BEGIN
+                            eris_event_elem_t svc_elt; {
+                                svc_elt.sock   = erishttp_context.svc_sock;
+                                svc_elt.events = ERIS_EVENT_ACCEPT;
+                            }
+                            rc = eris_event_add( &(erishttp_context.svc_event), &svc_elt);
+                            ERISHTTP_BLOCK_END
+
+                            /** Accepting, old slave of reload is retired after it */
+                            if ( 0 == rc) {
+                                eris_stats_slave_t *p_stats_slave = eris_stats_slave( erishttp_context.stats, __index);
+                                if ( p_stats_slave) {
+                                    p_stats_slave->ready = eris_get_pid();
+                                }
+                            }
+
+                            /** Dispatch */
+                            if ( 0 == rc) {
+                                erishttp_errors_log_dump( ERIS_LOG_DEBUG, "Dispatch...");
+
+                                rc = eris_event_dispatch( &(erishttp_context.svc_event), 
+                                                          erishttp_slave_event_exec,
+                                                          &(erishttp_context.errors_log));
+
+                                erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Dispatch over, rc.<%d>", rc);
+                            }
+
+                            /** End destroy event */
+                            eris_event_destroy( &erishttp_context.svc_event);
+                        } else {
+                            erishttp_errors_log_dump( ERIS_LOG_ERROR, "Init server event context, errno.<%d>", errno);
+                        }
+                    } else {
+                        erishttp_errors_log_dump( ERIS_LOG_ERROR, "Create slave task failed, errno.<%d>", errno);
+                    }
+                }
+
+                /** Destroy http context */
+                for ( i = 0; i < k; i++) {
+                    eris_http_destroy( &(erishttp_context.tasks_http[ i]));
+                }
+
+                eris_memory_free( erishttp_context.tasks_http);
+                eris_task_destroy( &erishttp_context.tasks);
+
+            } else {
+                erishttp_errors_log_dump( ERIS_LOG_ERROR, "Create http context pool failed, errno.<%d>", errno);
+            }
+
+            /** End destroy event queue */
+            eris_event_queue_destroy( &(erishttp_context.svc_event_queue));
+        } else {
+            erishttp_errors_log_dump( ERIS_LOG_ERROR, "Init event queue failed, errno.<%d>", errno);
+        }
+
+        eris_string_free( erishttp_context.shed_response);
+        eris_string_init( erishttp_context.shed_response);
+
+        eris_string_free( erishttp_context.limit_response);
+        eris_string_init( erishttp_context.limit_response);
+
+        /** Close svc_sock exit */
+        eris_socket_close( erishttp_context.svc_sock);
+        erishttp_context.svc_sock = -1;
+    ERISHTTP_BLOCK_END
+}/// erishttp_slave_main
+
+
+/**
+ * @Brief: Spawn worker progressors.
+ *
+ * @Param: None.
+ *
+ * @return: Ok is 0, Other is -1.
+ **/
+static eris_int_t erishttp_spawn_slaves( eris_none_t)
+{
+    eris_int_t rc = 0;
+
+    ERISHTTP_BLOCK_BEGIN
+        /** Create slave pids cache */
+        erishttp_context.slave_pids = (eris_pid_t *)eris_memory_alloc
+                                      (sizeof( eris_pid_t) * erishttp_context.attrs.worker_n);
+        erishttp_context.respawns   = (erishttp_respawn_t *)eris_memory_alloc
+                                      (sizeof( erishttp_respawn_t) * erishttp_context.attrs.worker_n);
+        if ( erishttp_context.slave_pids && erishttp_context.respawns) {
+            /** Init pids cache */
+            eris_int_t i = 0;
+
+            for ( i = 0; i < erishttp_context.attrs.worker_n; i++) {
+                erishttp_context.slave_pids[ i] = -1;
+
+                erishttp_context.respawns[ i].start      = 0;
+                erishttp_context.respawns[ i].due        = 0;
+                erishttp_context.respawns[ i].backoff    = 0;
+                erishttp_context.respawns[ i].retire     = -1;
+                erishttp_context.respawns[ i].retire_due = 0;
+            }
+
+            /** Create all slave pids */
+            for ( i = 0; i < erishttp_context.attrs.worker_n; i++) {
+                if ( 0 > erishttp_spawn_slave( i)) {
+                    /** error of fork */
+                    rc = EERIS_ERROR;
+
+                    break;
+                }
+            }
+
+            erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Create slave pids cache ok");
+        } else { 
+            /** Alloced memory failed */
+            rc = EERIS_ERROR;
+
+            erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Create slave pids cache failed, errno.<%d>", errno);
+        }
+    ERISHTTP_BLOCK_END
+
+    return rc;
+}/// erishttp_spawn_slaves
+
+
+/**
+ * @Brief: Fork a slave of index, it is bound to the same cpuset of index.
+ *
+ * @Param: __index, Slave index.
+ *
+ * @return: Ok is slave pid, Other is -1.
+ **/
+static eris_pid_t erishttp_spawn_slave( eris_int_t __index)
+{
+    eris_pid_t a_slave_pid = erishttp_fork();
+    if ( 0 == a_slave_pid) {
+        /** Signals are blocked in supervisor thread, slave is restored */
+        sigset_t empty_set;
+        sigemptyset( &empty_set);
+
+        (eris_none_t )pthread_sigmask( SIG_SETMASK, &empty_set, NULL);
+
+        /** Slaves of reload read config again, invalid config is a crash */
+        if ( (0 < erishttp_context.generation) && (0 != erishttp_slave_reconfig())) {
+            exit( 2);
+        }
+
+        /** Execute slave pid */
+        (eris_none_t )erishttp_slave_main( __index);
+
+        exit( 0);
+    } else if ( 0 < a_slave_pid) {
+        /** Save a slave pid */
+        erishttp_context.slave_pids[ __index]     = a_slave_pid;
+        erishttp_context.respawns[ __index].start = eris_time_mono_us();
+        erishttp_context.respawns[ __index].due   = 0;
+
+    } else {
+        erishttp_errors_log_dump( ERIS_LOG_ERROR, "Create a slave index.<%d> failed, errno.<%d>", __index, errno);
+    }
+
+    return a_slave_pid;
+}/// erishttp_spawn_slave
+
+
+/**
+ * @Brief: Fork of master, it waits watcher thread and admin requests of main thread
+ *         out of module list and logs, so locks of them are not kept in child.
+ *
+ * @Param: None.
+ *
+ * @return: Child is 0, Parent is child pid, Other is -1.
+ **/
+static eris_pid_t erishttp_fork( eris_none_t)
+{
+    (eris_none_t )pthread_mutex_lock( &(erishttp_context.fork_lock));
+
+    eris_pid_t rc_pid = fork();
+
+    /** Child has only the forking thread, it unlocks the copy of its own */
+    (eris_none_t )pthread_mutex_unlock( &(erishttp_context.fork_lock));
+
+    return rc_pid;
+}/// erishttp_fork
+
+
+/**
+ * @Brief: New slave of reload reads config again, it is done in child after fork.
+ *         listen, admin_listen, worker_n, worker_task_n, cpuset, pidfile and daemon
+ *         are kept, they are changed by restart.
+ *
+ * @Param: None.
+ *
+ * @return: Ok is 0, Other is EERIS_ERROR.
+ **/
+static eris_int_t erishttp_slave_reconfig( eris_none_t)
+{
+    eris_int_t rc = 0;
+
+    /** Config is tested by master, slave exits of error */
+    eris_cftree_destroy( &(erishttp_context.cftree));
+    eris_cftree_init( &(erishttp_context.cftree));
+
+    rc = eris_cftree_parse( &(erishttp_context.cftree), erishttp_context.cfile, NULL);
+    if ( 0 == rc) {
+        erishttp_attrs_t old_attrs = erishttp_context.attrs;
+
+        /** Strings of old attrs are owned by old_attrs */
+        rc = erishttp_attrs_init();
         if ( 0 == rc) {
-            rc = eris_string_printf( &module_log_es, "%S/erishttp.module.log", erishttp_context.attrs.log_path);
+            /** Changed by restart */
+            eris_string_free( erishttp_context.attrs.listen);
+            eris_string_free( erishttp_context.attrs.admin_listen);
+            eris_string_free( erishttp_context.attrs.pidfile);
+            eris_memory_free( erishttp_context.attrs.cpuset);
+
+            erishttp_context.attrs.listen        = old_attrs.listen;
+            erishttp_context.attrs.admin_listen  = old_attrs.admin_listen;
+            erishttp_context.attrs.pidfile       = old_attrs.pidfile;
+            erishttp_context.attrs.cpuset        = old_attrs.cpuset;
+            erishttp_context.attrs.cpuset_enable = old_attrs.cpuset_enable;
+            erishttp_context.attrs.worker_n      = old_attrs.worker_n;
+            erishttp_context.attrs.worker_task_n = old_attrs.worker_task_n;
+            erishttp_context.attrs.daemon        = old_attrs.daemon;
+
+            eris_string_free( old_attrs.user);
+            eris_string_free( old_attrs.group);
+            eris_string_free( old_attrs.log_path);
+            eris_string_free( old_attrs.doc_root);
+            eris_string_free( old_attrs.body_spool_path);
+            eris_string_free( old_attrs.gzip_types);
+            eris_string_free( old_attrs.log_format);
+
+            /** Logs, mime-types and modules of new config */
+            eris_log_destroy( &(erishttp_context.access_log));
+            eris_log_destroy( &(erishttp_context.errors_log));
+            eris_log_destroy( &(erishttp_context.module_log));
+            eris_log_destroy( &(erishttp_context.slow_log));
+            eris_logfmt_destroy( &(erishttp_context.access_logfmt));
+
+            rc = erishttp_logs_init();
             if ( 0 == rc) {
-                /** Init all log context */
-                rc = eris_log_init( &(erishttp_context.access_log), access_log_es, log_level, log_max_size);
-                if ( 0 == rc) {
-                    rc = eris_log_init( &(erishttp_context.errors_log), errors_log_es, log_level, log_max_size);
-                    if ( 0 == rc) {
-                        rc = eris_log_init( &(erishttp_context.module_log), module_log_es, log_level, log_max_size);
-                        if ( 0 != rc) {
-                            eris_log_destroy( &(erishttp_context.access_log));
-                            eris_log_destroy( &(erishttp_context.errors_log));
+                erishttp_mime_types_destroy();
+                erishttp_mime_types_init();
 
-                            erishttp_stderr_print( "[ERROR]: Init module log context failed, errno.<%d>\n", errno);
-                        }
-                    } else { 
-                        eris_log_destroy( &(erishttp_context.access_log));
+                eris_module_destroy( &(erishttp_context.mcontext));
 
-                        erishttp_stderr_print( "[ERROR]: Init errors log context failed, errno.<%d>\n", errno); 
+                rc = erishttp_module_init();
+                if ( 0 == rc) {
+                    if ( erishttp_context.watch) {
+                        erishttp_context.mcontext.generation = &(erishttp_context.watch->module);
                     }
-                } else { erishttp_stderr_print( "[ERROR]: Init access log context failed, errno.<%d>\n", errno); }
-            } else { erishttp_stderr_print( "[ERROR]: Merge module log file string failed, errno.<%d>\n", errno); }
-        } else { erishttp_stderr_print( "[ERROR]: Merge errors log file string failed, errno.<%d>\n", errno); }
-    } else { erishttp_stderr_print( "[ERROR]: Merge access log file string failed, errno.<%d>\n", errno); }
 
-    /** Release all eris string */
-    eris_string_free( access_log_es);
-    eris_string_free( errors_log_es);
-    eris_string_free( module_log_es);
+                    /** doc_root is maybe changed */
+                    if ( 0 <= erishttp_context.doc_root_fd) {
+                        close( erishttp_context.doc_root_fd);
+                    }
 
-    eris_string_init( access_log_es);
-    eris_string_init( errors_log_es);
-    eris_string_init( module_log_es);
+                    erishttp_context.doc_root_fd = open( erishttp_context.attrs.doc_root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+                    if ( 0 > erishttp_context.doc_root_fd) {
+                        erishttp_errors_log_dump( ERIS_LOG_WARN, "Open doc_root.<%s> failed, static files are not found, errno.<%d>", 
+                                                  erishttp_context.attrs.doc_root, errno);
+                    }
+
+                    erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Slave reads config.<%s> of generation.<%d>", 
+                                              erishttp_context.cfile, 
+                                              erishttp_context.generation);
+                } else {
+                    erishttp_errors_log_dump( ERIS_LOG_ERROR, "Slave inits modules of reload failed, rc.<%d>", rc);
+                }
+            }
+        }
+    }
 
     return rc;
-}/// erishttp_logs_init
-#undef erishttp_stdout_print
-#undef erishttp_stderr_print
+}/// erishttp_slave_reconfig
 
 
 /**
- * @Brief: Init modules of erishttp server.
+ * @Brief: Start supervisor thread of slaves.
  *
  * @Param: None.
  *
- * @Return: Ok is 0, Other is EERIS_ERROR.
+ * @return: Ok is 0, Other is EERIS_ERROR.
  **/
-static eris_int_t erishttp_module_init( eris_none_t)
+static eris_int_t erishttp_supervise_start( eris_none_t)
 {
     eris_int_t rc = 0;
 
-    eris_string_t tmp_libfile_es;
-    eris_string_t module_path_es;
-    eris_module_info_t mod_info; 
+    if ( erishttp_context.slave_pids && erishttp_context.respawns && !erishttp_context.supervising) {
+        erishttp_context.supervise_stop = 0;
 
-    eris_string_init( tmp_libfile_es);
-    eris_string_init( module_path_es);
-    eris_module_info_init( mod_info);
+        rc = pthread_create( &(erishttp_context.supervise_tid), NULL, erishttp_supervise_handler, NULL);
+        if ( 0 == rc) {
+            erishttp_context.supervising = true;
 
-    enum {
-        ERISHTTP_MODULE_PATTERN = 0,
-        ERISHTTP_MODULE_NAME    ,
-        ERISHTTP_MODULE_LANGUAGE,
-        ERISHTTP_MODULE_LIBFILE ,
-        ERISHTTP_MODULE_ADD     ,
-        ERISHTTP_MODULE_FINISH  ,
-        ERISHTTP_MODULE_ERROR   ,
-    } erishttp_module_state_v = ERISHTTP_MODULE_PATTERN;
+        } else {
+            erishttp_errors_log_dump( ERIS_LOG_ERROR, "Create supervisor thread failed, errno.<%d>", rc);
 
-    /** Init eris module context */
-    rc = eris_module_init( &(erishttp_context.mcontext), &(erishttp_context.cftree), &(erishttp_context.module_log));
-    if ( 0 == rc) {
-        eris_int_t module_count = eris_cftree_esize( &(erishttp_context.cftree), "http.module", &(erishttp_context.errors_log));
-        if ( 0 >= module_count) {
-            module_count = eris_cftree_esize( &(erishttp_context.cftree), "module", &(erishttp_context.errors_log));
+            rc = EERIS_ERROR;
         }
+    } else { rc = EERIS_ERROR; }
 
-        erishttp_module_log_dump( ERIS_LOG_DEBUG, "erishttp service modules count.<%d>", module_count);
+    return rc;
+}/// erishttp_supervise_start
 
-        /** Get all modules configuration */
-        eris_int_t i = 0;
-        for ( i = 0; i < module_count; i++) {
-            eris_module_info_cleanup( mod_info);
 
-            rc = eris_string_printf( &module_path_es, "module[%i]", i);
-            if ( 0 == rc) {
-                do {
-                    switch ( erishttp_module_state_v) {
-                        case ERISHTTP_MODULE_PATTERN: 
-                            {
-                                erishttp_module_state_v = ERISHTTP_MODULE_NAME;
+/**
+ * @Brief: Stop supervisor thread of slaves, slaves are not respawned after it.
+ *
+ * @Param: None.
+ *
+ * @return: Nothing.
+ **/
+static eris_none_t erishttp_supervise_stop( eris_none_t)
+{
+    if ( erishttp_context.supervising) {
+        erishttp_context.supervise_stop = 1;
 
-                                /** Get pattern */
-                                rc = erishttp_config_get( module_path_es, &(mod_info.pattern), &(erishttp_context.errors_log));
-                                if ( !((0 == rc) && (0 < eris_string_size( mod_info.pattern))) ) {
-                                    rc = eris_string_set( &(mod_info.pattern), "/");
-                                    if ( 0 != rc) {
-                                        erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+        (eris_none_t )pthread_join( erishttp_context.supervise_tid, NULL);
 
-                                        erishttp_module_log_dump( ERIS_LOG_ERROR, "Set module pattern value failed, errno.<%d>", errno);
+        erishttp_context.supervising = false;
+    }
+}/// erishttp_supervise_stop
 
-                                        break;
-                                    }
-                                }
-                            } break;
-                        case ERISHTTP_MODULE_NAME :
-                            {
-                                erishttp_module_state_v = ERISHTTP_MODULE_LANGUAGE;
 
-                                /** Get module name */
-                                rc = eris_string_printf( &module_path_es, "module[%i].name", i);
-                                if ( 0 == rc) {
-                                    rc = erishttp_config_get( module_path_es, &(mod_info.name), &(erishttp_context.errors_log));
-                                    if ( (0 != rc) || (0 == eris_string_size( mod_info.name)) ) {
-                                        erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+/**
+ * @Brief: Supervisor thread, dead slaves are reaped by waitpid, and respawned
+ *         of the same index when backoff is due.
+ *
+ * @Param: __arg, Nothing.
+ *
+ * @return: NULL.
+ **/
+static eris_void_t *erishttp_supervise_handler( eris_void_t *__arg)
+{
+    /** Signals are handled by master main thread */
+    sigset_t block_set;
+    sigfillset( &block_set);
 
-                                        erishttp_module_log_dump( ERIS_LOG_ERROR, "Get module name.<%s> failed, rc.<%d>", module_path_es, rc);
-                                    }
+    (eris_none_t )pthread_sigmask( SIG_BLOCK, &block_set, NULL);
 
-                                } else {
-                                    erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+    while ( !erishttp_context.supervise_stop) {
+        eris_int_t status = 0;
+        eris_pid_t a_pid  = -1;
 
-                                    erishttp_module_log_dump( ERIS_LOG_ERROR, "Make module name key path failed, errno.<%d>", errno);
-                                }
-                            } break;
-                        case ERISHTTP_MODULE_LANGUAGE :
-                            {
-                                erishttp_module_state_v = ERISHTTP_MODULE_LIBFILE;
+        /** Reap all exited slaves */
+        while ( 0 < (a_pid = waitpid( -1, &status, WNOHANG))) {
+            erishttp_supervise_reap( a_pid, status);
+        }
 
-                                /** Get module language */
-                                rc = eris_string_printf( &module_path_es, "module[%i].language", i);
-                                if ( 0 == rc) {
-                                    rc = erishttp_config_get( module_path_es, &(mod_info.language), &(erishttp_context.errors_log));
-                                    if ( 0 != rc) {
-                                        rc = eris_string_set( &(mod_info.pattern), "c");
-                                        if ( 0 != rc) {
-                                            erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+        /** Flags are set by signal handler of master main thread */
+        if ( erishttp_context.reload) {
+            erishttp_context.reload = 0;
 
-                                            erishttp_module_log_dump( ERIS_LOG_ERROR, "Set module language.<%s> failed, errno.<%d>", module_path_es, errno);
-                                        }
-                                    }
+            erishttp_supervise_reload();
+        }
 
-                                } else {
-                                    erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+        if ( erishttp_context.upgrade) {
+            erishttp_context.upgrade = 0;
 
-                                    erishttp_module_log_dump( ERIS_LOG_ERROR, "Make module language key path failed, errno.<%d>", errno);
-                                }
-                            } break;
-                        case ERISHTTP_MODULE_LIBFILE :
-                            {
-                                erishttp_module_state_v = ERISHTTP_MODULE_ADD;
+            erishttp_supervise_upgrade();
+        }
+
+        /** Respawn slaves of due backoff */
+        eris_uint64_t now_us = eris_time_mono_us();
+        eris_int_t    i      = 0;
+
+        /** Old slaves of reload are killed after drain_timeout */
+        for ( i = 0; i < erishttp_context.attrs.worker_n; i++) {
+            if ( (0 < erishttp_context.respawns[ i].retire) && (erishttp_context.respawns[ i].retire_due <= now_us)) {
+                erishttp_errors_log_dump( ERIS_LOG_WARN, "Old slave index.<%d> - pid.<%d> is not drained in %ds, kill it",
+                                          i, 
+                                          erishttp_context.respawns[ i].retire,
+                                          erishttp_context.attrs.drain_timeout);
+
+                (eris_none_t )kill( erishttp_context.respawns[ i].retire, SIGKILL);
+
+                erishttp_context.respawns[ i].retire_due = now_us + 1000000;
+            }
+        }
+
+        for ( i = 0; (i < erishttp_context.attrs.worker_n) && !erishttp_context.supervise_stop; i++) {
+            if ( (0 > erishttp_context.slave_pids[ i]) && (erishttp_context.respawns[ i].due <= now_us)) {
+                eris_stats_slave_t *p_stats_slave = eris_stats_slave( erishttp_context.stats, i);
+
+                if ( 0 < erishttp_spawn_slave( i)) {
+                    if ( p_stats_slave) {
+                        p_stats_slave->respawns++;
+                    }
+
+                    erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Respawn slave index.<%d> - pid.<%d>", i, erishttp_context.slave_pids[ i]);
+
+                } else {
+                    /** Fork failed, retry after max backoff */
+                    erishttp_context.respawns[ i].due = now_us + ((eris_uint64_t )ERISHTTP_RESPAWN_BACKOFF_MAX * 1000);
+                }
+            }
+        }
+
+        (eris_none_t )poll( NULL, 0, 100);
+    }
+
+    return NULL;
+}/// erishttp_supervise_handler
+
+
+/**
+ * @Brief: A slave is reaped, respawn is scheduled with backoff of crash-loop.
+ *
+ * @Param: __pid,    Reaped pid.
+ * @Param: __status, Wait status.
+ *
+ * @return: Nothing.
+ **/
+static eris_none_t erishttp_supervise_reap( eris_pid_t __pid, eris_int_t __status)
+{
+    eris_int_t i = 0;
 
-                                /** Get module libfile */
-                                rc = eris_string_printf( &module_path_es, "module[%i].libfile", i);
-                                if ( 0 == rc) {
-                                    eris_string_t tmp_libfile_es;
-                                    eris_string_init( tmp_libfile_es);
+    /** Connections held by a crashed or killed slave are not released by itself */
+    erishttp_supervise_reclaim( __pid);
 
-                                    rc = erishttp_config_get( module_path_es, &tmp_libfile_es, &(erishttp_context.errors_log));
-                                    if ( (0 == rc) && (0 < eris_string_size( tmp_libfile_es)) ) {
-                                        if ( '/' == eris_string_at( tmp_libfile_es, 0)) {
-                                            mod_info.libfile = eris_string_clone_eris( tmp_libfile_es);
+    /** Old slave of reload is drained, its index has a new slave */
+    for ( i = 0; i < erishttp_context.attrs.worker_n; i++) {
+        if ( __pid == erishttp_context.respawns[ i].retire) {
+            erishttp_context.respawns[ i].retire = -1;
 
-                                        } else {
-                                            eris_string_printf( &(mod_info.libfile), "%S/%S", 
-                                                                erishttp_context.prefix, 
-                                                                tmp_libfile_es);
-                                        }
+            erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Old slave index.<%d> - pid.<%d> exited, code.<%d> signal.<%d>",
+                                      i, 
+                                      __pid,
+                                      WIFEXITED( __status) ? WEXITSTATUS( __status) : -1,
+                                      WIFSIGNALED( __status) ? WTERMSIG( __status) : 0);
 
-                                        if ( !mod_info.libfile) {
-                                            erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+            /** Flight records of drained slave are removed, they are kept of its crash */
+            if ( WIFEXITED( __status) && (0 == WEXITSTATUS( __status))) {
+                eris_string_t flight_es;
+                eris_string_init( flight_es);
 
-                                            erishttp_module_log_dump( ERIS_LOG_ERROR, "Merge module libfile.<%s> failed, rc.<%d>", module_path_es, rc);
-                                        }
+                if ( 0 == eris_string_printf( &flight_es, "%S/erishttp.flight.%i.%i", erishttp_context.attrs.log_path, i, (eris_int_t )__pid)) {
+                    (eris_none_t )unlink( flight_es);
+                }
 
-                                    } else {
-                                        erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+                eris_string_free( flight_es);
+                eris_string_init( flight_es);
+            }
 
-                                        erishttp_module_log_dump( ERIS_LOG_ERROR, "Get module libfile.<%s> failed, rc.<%d>", module_path_es, rc);
-                                    }
+            return;
+        }
+    }
 
-                                    eris_string_free( tmp_libfile_es);
-                                    eris_string_init( tmp_libfile_es);
+    /** New master of binary upgrade exited, it is failed if not exit of daemon */
+    if ( __pid == erishttp_context.upgrade_pid) {
+        erishttp_context.upgrade_pid = -1;
 
-                                } else {
-                                    erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+        if ( WIFSIGNALED( __status) || (WIFEXITED( __status) && (0 != WEXITSTATUS( __status)))) {
+            eris_string_t pidfile_es;
+            eris_string_init( pidfile_es);
 
-                                    erishttp_module_log_dump( ERIS_LOG_ERROR, "Make module libfile key path failed, errno.<%d>", errno);
-                                }
-                            } break;
-                        case ERISHTTP_MODULE_ADD :
-                            {
-                                erishttp_module_state_v = ERISHTTP_MODULE_FINISH;
+            eris_size_t pidfile_size = eris_string_size( erishttp_context.attrs.pidfile);
+            eris_size_t suffix_size  = strlen( ERISHTTP_OLDBIN_SUFFIX);
 
-                                /** Add new module into mcontext */
-                                rc = eris_module_add( &(erishttp_context.mcontext), &mod_info);
-                                if ( 0 != rc) {
-                                    erishttp_module_state_v = ERISHTTP_MODULE_ERROR;
+            /** Pidfile of this master is restored */
+            if ( (suffix_size < pidfile_size) && 
+                 (0 == eris_string_append_n( &pidfile_es, erishttp_context.attrs.pidfile, pidfile_size - suffix_size)) &&
+                 (0 == rename( erishttp_context.attrs.pidfile, pidfile_es))) {
+                eris_string_free( erishttp_context.attrs.pidfile);
 
-                                    erishttp_module_log_dump( ERIS_LOG_ERROR, "Add a module to mcontext failed, errno.<%d>", errno);
-                                }
-                            } break;
-                        case ERISHTTP_MODULE_FINISH:
-                            {
-                                rc = 0;
+                erishttp_context.attrs.pidfile = pidfile_es;
+                eris_string_init( pidfile_es);
+            }
 
-                                erishttp_module_state_v = ERISHTTP_MODULE_PATTERN;
-                            } break;
-                        case ERISHTTP_MODULE_ERROR :
-                        default : break;
-                    }/// switch ( erishttp_module_state_v)
+            eris_string_free( pidfile_es);
 
-                    if ( ERISHTTP_MODULE_ERROR == erishttp_module_state_v) {
-                        rc = EERIS_ERROR; break;
-                    }
-                    
-                    if ( ERISHTTP_MODULE_FINISH == erishttp_module_state_v) {
-                        break;
-                    }
-                } while ( 1); /** Get module attributes */
+            erishttp_errors_log_dump( ERIS_LOG_ERROR, "New master pid.<%d> of binary upgrade exited, code.<%d> signal.<%d>, upgrade is failed",
+                                      __pid,
+                                      WIFEXITED( __status) ? WEXITSTATUS( __status) : -1,
+                                      WIFSIGNALED( __status) ? WTERMSIG( __status) : 0);
+        }
 
-                if ( 0 != rc) { break; }
-            } else { 
-                erishttp_module_log_dump( ERIS_LOG_ERROR, "Make module key path failed, errno.<%d>", errno);
+        return;
+    }
 
-                break;
+    for ( i = 0; i < erishttp_context.attrs.worker_n; i++) {
+        if ( __pid == erishttp_context.slave_pids[ i]) {
+            erishttp_respawn_t *p_respawn     = &(erishttp_context.respawns[ i]);
+            eris_stats_slave_t *p_stats_slave = eris_stats_slave( erishttp_context.stats, i);
+
+            eris_uint64_t now_us   = eris_time_mono_us();
+            eris_bool_t   is_crash = (WIFSIGNALED( __status) || (WIFEXITED( __status) && (0 != WEXITSTATUS( __status))));
+
+            /** Exited before stable uptime is a crash-loop, backoff is doubled */
+            if ( (now_us - p_respawn->start) < ((eris_uint64_t )ERISHTTP_RESPAWN_STABLE * 1000)) {
+                p_respawn->backoff = (0 < p_respawn->backoff) ? (p_respawn->backoff * 2) : ERISHTTP_RESPAWN_BACKOFF_MIN;
+
+                if ( ERISHTTP_RESPAWN_BACKOFF_MAX < p_respawn->backoff) {
+                    p_respawn->backoff = ERISHTTP_RESPAWN_BACKOFF_MAX;
+                }
+            } else {
+                p_respawn->backoff = 0;
             }
-        }/// for ( i = 0; i < module_count; i++);
 
-        /** Happen error */
-        if ( 0 != rc) {
-            eris_module_destroy( &(erishttp_context.mcontext));
-        }
+            p_respawn->due = now_us + ((eris_uint64_t )p_respawn->backoff * 1000);
 
-        eris_string_free( tmp_libfile_es);
-        eris_string_free( module_path_es);
-        eris_string_init( tmp_libfile_es);
-        eris_string_init( module_path_es);
+            erishttp_context.slave_pids[ i] = -1;
 
-        eris_module_info_destroy( mod_info);
-    }/// if module context init ok
+            if ( p_stats_slave) {
+                eris_int_t k = 0;
 
-    return rc;
-}/// erishttp_module_init
+                if ( is_crash) { p_stats_slave->crashes++; }
+
+                p_stats_slave->backoff     = p_respawn->backoff;
+                p_stats_slave->last_exit   = WIFEXITED( __status) ? WEXITSTATUS( __status) : -1;
+                p_stats_slave->last_signal = WIFSIGNALED( __status) ? WTERMSIG( __status) : 0;
+                p_stats_slave->idle        = 0;
+                p_stats_slave->queue_depth = 0;
+
+                /** Connections of dead threads are gone */
+                for ( k = 0; k < erishttp_context.attrs.worker_task_n; k++) {
+                    eris_stats_thread_t *p_thread = eris_stats_thread( erishttp_context.stats, i, k);
+                    if ( p_thread) { p_thread->active = 0; }
+                }
+            }
+
+            erishttp_errors_log_dump( is_crash ? ERIS_LOG_ERROR : ERIS_LOG_WARN, 
+                                      "Slave index.<%d> - pid.<%d> exited, code.<%d> signal.<%d>, respawn after %dms",
+                                      i, 
+                                      __pid,
+                                      WIFEXITED( __status) ? WEXITSTATUS( __status) : -1,
+                                      WIFSIGNALED( __status) ? WTERMSIG( __status) : 0,
+                                      p_respawn->backoff);
+
+            break;
+        }
+    }
+}/// erishttp_supervise_reap
 
 
 /**
- * @Brief: Create erishttp server listen socket.
+ * @Brief: Connections of addresses held by a reaped slave are given back, so its
+ *         addresses are not limited by rate_limit_conns of leaked connections.
  *
- * @Param: None.
+ * @Param: __pid, Pid of reaped slave.
  *
- * @Return: Ok is 0, Other is -1.
+ * @return: Nothing.
  **/
-static eris_int_t erishttp_socket_create( eris_none_t)
+static eris_none_t erishttp_supervise_reclaim( eris_pid_t __pid)
 {
-    eris_int_t rc = 0;
-
-    eris_socket_attr_t sock_attrs;
-    ERISHTTP_BLOCK_BEGIN
-        sock_attrs.nonblock     = 1;
-        sock_attrs.backlog      = erishttp_context.attrs.backlog;
-        sock_attrs.tcp_nodelay  = erishttp_context.attrs.tcp_nodelay;
-        sock_attrs.tcp_nopush   = erishttp_context.attrs.tcp_nopush;
-        sock_attrs.linger       = 0;
-        sock_attrs.zero         = 0;
-        sock_attrs.sendbuf_size = erishttp_context.attrs.send_buffer_size;
-        sock_attrs.recvbuf_size = erishttp_context.attrs.recv_buffer_size;
-    ERISHTTP_BLOCK_END
-
-    /** Create server socket context */
-    erishttp_context.svc_sock = eris_socket_tcp_listen( erishttp_context.attrs.listen, 
-                                                        &sock_attrs, 
-                                                        &(erishttp_context.errors_log));
-    if ( -1 == erishttp_context.svc_sock) {
-        rc = EERIS_ERROR;
-
-        erishttp_errors_log_dump( ERIS_LOG_ERROR, "Create server socket object failed, errno.<%d>", errno);
+    eris_uint_t conns = eris_ratelimit_reclaim( erishttp_context.ratelimit, __pid);
+    if ( 0 < conns) {
+        erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Slave pid.<%d> exited, connections.<%u> of rate limit are given back", __pid, conns);
     }
-
-    return rc;
-}/// erishttp_socket_create
+}/// erishttp_supervise_reclaim
 
 
 /**
- * @Brief: Create erishttp admin listen socket.
+ * @Brief: Reload of SIGHUP, config is tested at first. A new slave of index reads
+ *         config in child, the old slave is drained after the new one accepts, so
+ *         listen socket is always accepted. Reload is aborted by a failed slave,
+ *         its old slave is kept.
  *
  * @Param: None.
  *
- * @Return: Ok is 0, Other is -1.
+ * @return: Nothing.
  **/
-static eris_int_t erishttp_admin_socket_create( eris_none_t)
+static eris_none_t erishttp_supervise_reload( eris_none_t)
 {
     eris_int_t rc = 0;
 
-    eris_socket_attr_t sock_attrs;
-    ERISHTTP_BLOCK_BEGIN
-        sock_attrs.nonblock     = 1;
-        sock_attrs.backlog      = erishttp_context.attrs.backlog;
-        sock_attrs.tcp_nodelay  = erishttp_context.attrs.tcp_nodelay;
-        sock_attrs.tcp_nopush   = erishttp_context.attrs.tcp_nopush;
-        sock_attrs.linger       = 0;
-        sock_attrs.zero         = 0;
-        sock_attrs.sendbuf_size = erishttp_context.attrs.send_buffer_size;
-        sock_attrs.recvbuf_size = erishttp_context.attrs.recv_buffer_size;
-    ERISHTTP_BLOCK_END
+    /** Test config, running slaves are kept of invalid config */
+    {
+        eris_cftree_t test_cftree;
+        eris_cftree_init( &test_cftree);
 
-    /** Create admin socket context */
-    erishttp_context.admin_sock = eris_socket_tcp_listen( erishttp_context.attrs.admin_listen, 
-                                                          &sock_attrs, 
-                                                          &(erishttp_context.errors_log));
-    if ( -1 == erishttp_context.admin_sock) {
-        rc = EERIS_ERROR;
+        rc = eris_cftree_parse( &test_cftree, erishttp_context.cfile, NULL);
 
-        erishttp_errors_log_dump( ERIS_LOG_ERROR, "Create admin server socket object failed, errno.<%d>", errno);
+        eris_cftree_destroy( &test_cftree);
+
+        if ( 0 != rc) {
+            erishttp_errors_log_dump( ERIS_LOG_ERROR, "Reload config.<%s> is invalid, slaves are kept, rc.<%d>", erishttp_context.cfile, rc);
+
+            return;
+        }
     }
 
-    return rc;
-}/// erishttp_admin_socket_create
+    erishttp_context.generation++;
 
+    erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Reload config.<%s> of generation.<%d>", erishttp_context.cfile, erishttp_context.generation);
 
-/**
- * @Brief: Slave worker instance.
- *
- * @Param: __index, Processor index number.
- *
- * @Return: Nothing.
- **/
-static eris_none_t erishttp_slave_main( eris_int_t __index)
-{
-    ERISHTTP_BLOCK_BEGIN
-        eris_proctitle_set( "slave", __index);
-        erishttp_errors_log_dump( ERIS_LOG_NOTICE, 
-                                  "Slave progress index.<%d> - pid.<%d> ok",
-                                  __index, 
-                                  eris_get_pid());
-    ERISHTTP_BLOCK_END
+    /** New slaves get changed doc_root watched */
+    erishttp_supervise_rewatch();
 
-    /** Enabile/Disable cpu affinity */
-    if ( 1 == erishttp_context.attrs.cpuset_enable) {
-        eris_cpuset_bind( erishttp_context.attrs.cpuset[ __index + 1], 0);
-    }
+    eris_int_t i = 0;
+    for ( i = 0; (i < erishttp_context.attrs.worker_n) && !erishttp_context.supervise_stop; i++) {
+        erishttp_respawn_t *p_respawn     = &(erishttp_context.respawns[ i]);
+        eris_stats_slave_t *p_stats_slave = eris_stats_slave( erishttp_context.stats, i);
 
-    eris_int_t rc = 0;
-    rc = eris_signal_init( &(erishttp_context.errors_log));
+        /** Old slave of last reload is not drained yet */
+        if ( 0 < p_respawn->retire) {
+            (eris_none_t )kill( p_respawn->retire, SIGKILL);
+            (eris_none_t )waitpid( p_respawn->retire, NULL, 0);
 
-    if ( 0 == rc)
-    ERISHTTP_BLOCK_BEGIN
-        eris_socket_close( erishttp_context.admin_sock);
-        erishttp_context.admin_sock = -1;
+            erishttp_supervise_reclaim( p_respawn->retire);
 
-        /** Init event queue */
-        rc = eris_event_queue_init( &(erishttp_context.svc_event_queue), 
-                                    erishttp_context.attrs.max_connections);
-        if ( 0 == rc) {
-            /** Create all task */
-            erishttp_context.tasks_http = (eris_http_t *)eris_memory_alloc( sizeof( eris_http_t) *
-                                                                            erishttp_context.attrs.worker_task_n);
-            if ( erishttp_context.tasks_http) {
-                eris_int_t i = 0;
-                eris_int_t k = 0;
+            p_respawn->retire = -1;
+        }
 
-                ERISHTTP_BLOCK_BEGIN
-                eris_http_attr_t http_attrs; {
-                    http_attrs.url_max_size      = erishttp_context.attrs.url_max_size;
-                    http_attrs.header_max_size   = erishttp_context.attrs.header_max_size;
-                    http_attrs.body_max_size     = erishttp_context.attrs.body_max_size;
-                    http_attrs.header_cache_size = erishttp_context.attrs.header_cache_size;
-                    http_attrs.body_cache_size   = erishttp_context.attrs.body_cache_size;
-                }
+        eris_pid_t old_pid = erishttp_context.slave_pids[ i];
+        eris_pid_t new_pid = -1;
 
+        p_respawn->retire = old_pid;
+        erishttp_context.slave_pids[ i] = -1;
 
-                for ( k = 0; k < erishttp_context.attrs.worker_task_n; k++) {
-                    rc = eris_http_init( &(erishttp_context.tasks_http[ k]), &http_attrs, &(erishttp_context.errors_log));
-                    if ( 0 != rc) {
-                        erishttp_errors_log_dump( ERIS_LOG_ERROR, "Init http context of task woring failed, errno.<%d>", errno);
+        /** Wait new slave accepting, it is dead of invalid config */
+        rc = EERIS_ERROR;
 
-                        break;
-                    }
+        new_pid = erishttp_spawn_slave( i);
+        if ( 0 < new_pid) {
+            eris_uint64_t ready_due = eris_time_mono_us() + ((eris_uint64_t )ERISHTTP_RELOAD_READY_TIMEOUT * 1000);
+
+            while ( !erishttp_context.supervise_stop) {
+                eris_int_t status = 0;
+                eris_pid_t a_pid  = -1;
+
+                if ( !p_stats_slave || (new_pid == p_stats_slave->ready)) {
+                    rc = 0; break;
                 }
-                ERISHTTP_BLOCK_END
 
-                /** Create tasks http context ok */
-                if ( 0 == rc) {
-                    eris_task_init( &(erishttp_context.tasks), 0);
+                while ( 0 < (a_pid = waitpid( -1, &status, WNOHANG))) {
+                    erishttp_supervise_reap( a_pid, status);
+                }
 
-                    for ( k = 0; k < erishttp_context.attrs.worker_task_n; k++) {
-                        rc = eris_task_create( &(erishttp_context.tasks), 
-                                                eris_slave_handler, 
-                                               &(erishttp_context.tasks_http[ k]), 
-                                               &(erishttp_context.errors_log));
-                        if ( 0 != rc) {
-                            /** Create thread error */
-                            k = erishttp_context.attrs.worker_task_n;
+                if ( (new_pid != erishttp_context.slave_pids[ i]) || (ready_due <= eris_time_mono_us())) { break; }
 
-                            break;
-                        }
-                    }
+                (eris_none_t )poll( NULL, 0, 10);
+            }
+        }
 
-                    /** Create tasks thread ok */
-                    if ( 0 == rc) {
-                        ERISHTTP_BLOCK_BEGIN
-                        eris_event_attr_t evt_attrs; {
-                            evt_attrs.iot              = erishttp_context.attrs.event_iot;
-                            evt_attrs.timeout          = erishttp_context.attrs.timeout;;
-                            evt_attrs.keepalive        = erishttp_context.attrs.keepalive;;
-                            evt_attrs.max_events       = erishttp_context.attrs.max_connections;
-                            evt_attrs.recv_buffer_size = erishttp_context.attrs.recv_buffer_size;
-                            evt_attrs.send_buffer_size = erishttp_context.attrs.send_buffer_size;
-                            evt_attrs.tcp_nodelay      = erishttp_context.attrs.tcp_nodelay;
-                            evt_attrs.tcp_nopush       = erishttp_context.attrs.tcp_nopush;
-                            evt_attrs.zero             = erishttp_context.attrs.zero;
-                            evt_attrs.log              = &(erishttp_context.errors_log);
-                        }
+        if ( 0 == rc) {
+            /** Old slave stops accepts and drains */
+            if ( 0 < old_pid) {
+                (eris_none_t )kill( old_pid, SIGQUIT);
+
+                p_respawn->retire_due = eris_time_mono_us() + ((eris_uint64_t )erishttp_context.attrs.drain_timeout * 1000000);
+
+            } else {
+                p_respawn->retire = -1;
+            }
+
+            erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Reload slave index.<%d> - pid.<%d> ok, old pid.<%d> drains", i, new_pid, old_pid);
+
+        } else {
+            /** New slave is killed, old slave is kept */
+            if ( (0 < new_pid) && (new_pid == erishttp_context.slave_pids[ i])) {
+                (eris_none_t )kill( new_pid, SIGKILL);
+                (eris_none_t )waitpid( new_pid, NULL, 0);
+
+                erishttp_supervise_reclaim( new_pid);
+            }
+
+            p_respawn->retire = -1;
+
+            erishttp_context.slave_pids[ i] = old_pid;
+            if ( p_stats_slave && (0 < old_pid)) {
+                p_stats_slave->pid = old_pid;
+            }
+
+            erishttp_errors_log_dump( ERIS_LOG_ERROR, "Reload slave index.<%d> failed, old slave pid.<%d> is kept, reload is aborted", i, old_pid);
+
+            break;
+        }
+    }
+}/// erishttp_supervise_reload
+
+
+/**
+ * @Brief: Master reads config of reload, only doc_root is taken of it. Watcher of
+ *         old doc_root is stopped, and started of changed doc_root, slaves caches
+ *         are expired by time if it is not watched.
+ *
+ * @Param: None.
+ *
+ * @return: Nothing.
+ **/
+static eris_none_t erishttp_supervise_rewatch( eris_none_t)
+{
+    eris_int_t rc = 0;
 
-                        /** Init server evnet */
-                        rc = eris_event_init( &(erishttp_context.svc_event), &evt_attrs);
-                        ERISHTTP_BLOCK_END
+    eris_string_t doc_root;
+    eris_string_init( doc_root);
 
-                        if ( 0 == rc) {
-                            ERISHTTP_BLOCK_BEGIN
-                            eris_event_elem_t svc_elt; {
-                                svc_elt.sock   = erishttp_context.svc_sock;
-                                svc_elt.events = ERIS_EVENT_ACCEPT;
-                            }
-                            rc = eris_event_add( &(erishttp_context.svc_event), &svc_elt);
-                            ERISHTTP_BLOCK_END
+    /** Admin upgrade forks of main thread, config is not copied half parsed */
+    (eris_none_t )pthread_mutex_lock( &(erishttp_context.fork_lock));
 
-                            /** Dispatch */
-                            if ( 0 == rc) {
-                                erishttp_errors_log_dump( ERIS_LOG_DEBUG, "Dispatch...");
+    eris_cftree_destroy( &(erishttp_context.cftree));
+    eris_cftree_init( &(erishttp_context.cftree));
 
-                                rc = eris_event_dispatch( &(erishttp_context.svc_event), 
-                                                          erishttp_slave_event_exec,
-                                                          &(erishttp_context.errors_log));
+    rc = eris_cftree_parse( &(erishttp_context.cftree), erishttp_context.cfile, NULL);
+    if ( 0 == rc) {
+        rc = erishttp_doc_root_get( &doc_root);
+    }
 
-                                erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Dispatch over, rc.<%d>", rc);
-                            }
+    (eris_none_t )pthread_mutex_unlock( &(erishttp_context.fork_lock));
 
-                            /** End destroy event */
-                            eris_event_destroy( &erishttp_context.svc_event);
-                        } else {
-                            erishttp_errors_log_dump( ERIS_LOG_ERROR, "Init server event context, errno.<%d>", errno);
-                        }
-                    } else {
-                        erishttp_errors_log_dump( ERIS_LOG_ERROR, "Create slave task failed, errno.<%d>", errno);
-                    }
-                }
+    if ( (0 == rc) && erishttp_context.watch && (0 != strcmp( doc_root, erishttp_context.attrs.doc_root))) {
+        /** Not active, slaves of old and new doc_root are expired by time */
+        eris_watch_stop();
 
-                /** Destroy http context */
-                for ( i = 0; i < k; i++) {
-                    eris_http_destroy( &(erishttp_context.tasks_http[ i]));
-                }
+        eris_string_free( erishttp_context.attrs.doc_root);
+        erishttp_context.attrs.doc_root = doc_root;
+        eris_string_init( doc_root);
 
-                eris_memory_free( erishttp_context.tasks_http);
-                eris_task_destroy( &erishttp_context.tasks);
+        if ( 0 <= erishttp_context.doc_root_fd) {
+            close( erishttp_context.doc_root_fd);
+        }
+
+        erishttp_context.doc_root_fd = open( erishttp_context.attrs.doc_root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if ( 0 <= erishttp_context.doc_root_fd) {
+            rc = eris_watch_start( erishttp_context.watch, 
+                                   erishttp_context.attrs.doc_root, 
+                                   &(erishttp_context.mcontext), 
+                                   &(erishttp_context.fork_lock),
+                                   &(erishttp_context.errors_log));
+            if ( 0 == rc) {
+                erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Watch changed doc_root.<%s> of reload", erishttp_context.attrs.doc_root);
 
             } else {
-                erishttp_errors_log_dump( ERIS_LOG_ERROR, "Create http context pool failed, errno.<%d>", errno);
+                erishttp_errors_log_dump( ERIS_LOG_WARN, "Start watcher failed, static caches are expired by time, rc.<%d>", rc);
             }
-
-            /** End destroy event queue */
-            eris_event_queue_destroy( &(erishttp_context.svc_event_queue));
         } else {
-            erishttp_errors_log_dump( ERIS_LOG_ERROR, "Init event queue failed, errno.<%d>", errno);
+            erishttp_errors_log_dump( ERIS_LOG_WARN, "Open doc_root.<%s> failed, static caches are expired by time, errno.<%d>", 
+                                      erishttp_context.attrs.doc_root, errno);
         }
+    }
 
-        /** Close svc_sock exit */
-        eris_socket_close( erishttp_context.svc_sock);
-        erishttp_context.svc_sock = -1;
-    ERISHTTP_BLOCK_END
-}/// erishttp_slave_main
+    eris_string_free( doc_root);
+}/// erishttp_supervise_rewatch
 
 
 /**
- * @Brief: Spawn worker progressors.
+ * @Brief: Binary upgrade of SIGUSR2, new binary is executed with listen sockets,
+ *         pidfile of this master is renamed to ".oldbin". Old master is quit by
+ *         SIGQUIT after new master is ok.
  *
  * @Param: None.
  *
- * @return: Ok is 0, Other is -1.
+ * @return: Nothing.
  **/
-static eris_int_t erishttp_spawn_slaves( eris_none_t)
+static eris_none_t erishttp_supervise_upgrade( eris_none_t)
 {
-    eris_int_t rc = 0;
+    eris_string_t oldbin_es;
+    eris_string_t fds_env_es;
 
-    ERISHTTP_BLOCK_BEGIN
-        /** Create slave pids cache */
-        erishttp_context.slave_pids = (eris_pid_t *)eris_memory_alloc
-                                      (sizeof( eris_pid_t) * erishttp_context.attrs.worker_n);
-        if ( erishttp_context.slave_pids) {
-            /** Init pids cache */
-            eris_int_t i = 0;
+    eris_string_init( oldbin_es);
+    eris_string_init( fds_env_es);
 
-            for ( i = 0; i < erishttp_context.attrs.worker_n; i++) {
-                erishttp_context.slave_pids[ i] = -1;
-            }
+    if ( 0 < erishttp_context.upgrade_pid) {
+        erishttp_errors_log_dump( ERIS_LOG_WARN, "Binary upgrade pid.<%d> is running", erishttp_context.upgrade_pid);
 
-            /** Create all slave pids */
-            for ( i = 0; i < erishttp_context.attrs.worker_n; i++) {
-                eris_pid_t a_slave_pid = fork();
-                if ( 0 == a_slave_pid) {
-                    /** Execute slave pid */
-                    (eris_none_t )erishttp_slave_main( i);
+    } else if ( eris_string_size( erishttp_context.attrs.pidfile) > strlen( ERISHTTP_OLDBIN_SUFFIX) && 
+                (0 == strcmp( erishttp_context.attrs.pidfile + eris_string_size( erishttp_context.attrs.pidfile) - strlen( ERISHTTP_OLDBIN_SUFFIX), 
+                              ERISHTTP_OLDBIN_SUFFIX))) {
+        erishttp_errors_log_dump( ERIS_LOG_WARN, "Master is upgraded yet, pidfile.<%s>", erishttp_context.attrs.pidfile);
 
-                    exit( 0);
-                } else if ( 0 < a_slave_pid) {
-                    /** Save a slave pid */
-                    erishttp_context.slave_pids[ i] = a_slave_pid;
+    } else if ( (0 == eris_string_printf( &oldbin_es, "%S%s", erishttp_context.attrs.pidfile, ERISHTTP_OLDBIN_SUFFIX)) &&
+                (0 == eris_string_printf( &fds_env_es, "%s=%i,%i", ERISHTTP_LISTEN_FDS_ENV, erishttp_context.svc_sock, erishttp_context.admin_sock))) {
+        /** Environment of new master, old listen fds are replaced */
+        eris_size_t   env_n  = 0;
+        eris_char_t **p_envp = NULL;
 
-                } else {
-                    /** error of fork */
-                    rc = EERIS_ERROR;
+        while ( environ[ env_n]) { env_n++; }
 
-                    erishttp_errors_log_dump( ERIS_LOG_ERROR, "Create a slave index.<%d> failed, errno.<%d>", i, errno);
+        p_envp = (eris_char_t **)eris_memory_alloc( sizeof( eris_char_t *) * (env_n + 2));
+        if ( p_envp && (0 == rename( erishttp_context.attrs.pidfile, oldbin_es))) {
+            eris_size_t k = 0;
+            eris_size_t n = 0;
 
-                    break;
+            for ( k = 0; k < env_n; k++) {
+                if ( 0 != strncmp( environ[ k], ERISHTTP_LISTEN_FDS_ENV "=", strlen( ERISHTTP_LISTEN_FDS_ENV "="))) {
+                    p_envp[ n++] = environ[ k];
                 }
             }
+            p_envp[ n++] = fds_env_es;
+            p_envp[ n]   = NULL;
 
-            erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Create slave pids cache ok");
-        } else { 
-            /** Alloced memory failed */
-            rc = EERIS_ERROR;
+            eris_pid_t a_pid = erishttp_fork();
+            if ( 0 == a_pid) {
+                eris_char_t *p_argv[] = { erishttp_context.exe, "-p", erishttp_context.prefix, "-c", erishttp_context.cfile, NULL};
+                eris_int_t   a_fd     = 0;
 
-            erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Create slave pids cache failed, errno.<%d>", errno);
+                sigset_t empty_set;
+                sigemptyset( &empty_set);
+
+                (eris_none_t )pthread_sigmask( SIG_SETMASK, &empty_set, NULL);
+
+                /** Only listen sockets are passed, open fds are closed of exec */
+                DIR *p_fd_dir = opendir( "/proc/self/fd");
+                if ( !p_fd_dir) { p_fd_dir = opendir( "/dev/fd"); }
+
+                if ( p_fd_dir) {
+                    struct dirent *p_entry = NULL;
+
+                    while ( NULL != (p_entry = readdir( p_fd_dir))) {
+                        a_fd = atoi( p_entry->d_name);
+
+                        if ( (3 <= a_fd) && (a_fd != dirfd( p_fd_dir)) && 
+                             (a_fd != erishttp_context.svc_sock) && (a_fd != erishttp_context.admin_sock)) {
+                            (eris_none_t )fcntl( a_fd, F_SETFD, FD_CLOEXEC);
+                        }
+                    }
+
+                    (eris_none_t )closedir( p_fd_dir);
+                } else {
+                    /** Without fd directory, all possible fds are closed */
+                    eris_int_t max_fd = (eris_int_t )sysconf( _SC_OPEN_MAX);
+
+                    for ( a_fd = 3; a_fd < max_fd; a_fd++) {
+                        if ( (a_fd != erishttp_context.svc_sock) && (a_fd != erishttp_context.admin_sock)) {
+                            (eris_none_t )close( a_fd);
+                        }
+                    }
+                }
+
+                (eris_none_t )fcntl( erishttp_context.svc_sock, F_SETFD, 0);
+                (eris_none_t )fcntl( erishttp_context.admin_sock, F_SETFD, 0);
+
+                (eris_none_t )execve( erishttp_context.exe, p_argv, p_envp);
+
+                _exit( 1);
+
+            } else if ( 0 < a_pid) {
+                erishttp_context.upgrade_pid = a_pid;
+
+                eris_string_free( erishttp_context.attrs.pidfile);
+
+                erishttp_context.attrs.pidfile = oldbin_es;
+                eris_string_init( oldbin_es);
+
+                erishttp_errors_log_dump( ERIS_LOG_NOTICE, "Binary upgrade of <%s> pid.<%d>, pidfile is <%s>", 
+                                          erishttp_context.exe, 
+                                          a_pid, 
+                                          erishttp_context.attrs.pidfile);
+            } else {
+                (eris_none_t )rename( oldbin_es, erishttp_context.attrs.pidfile);
+
+                erishttp_errors_log_dump( ERIS_LOG_ERROR, "Fork binary upgrade failed, errno.<%d>", errno);
+            }
+        } else {
+            erishttp_errors_log_dump( ERIS_LOG_ERROR, "Rename pidfile.<%s> of binary upgrade failed, errno.<%d>", erishttp_context.attrs.pidfile, errno);
         }
-    ERISHTTP_BLOCK_END
 
-    return rc;
-}/// erishttp_spawn_slaves
+        eris_memory_free( p_envp);
+    } else {
+        erishttp_errors_log_dump( ERIS_LOG_ERROR, "Make binary upgrade strings failed, errno.<%d>", errno);
+    }
+
+    eris_string_free( oldbin_es);
+    eris_string_free( fds_env_es);
+}/// erishttp_supervise_upgrade
 
 
 /**
@@ -2189,34 +3859,81 @@ static eris_int_t erishttp_spawn_slaves( eris_none_t)
  **/
 static eris_none_t erishttp_slave_event_exec( eris_event_elem_t *__elem, eris_arg_t __arg)
 {
+    /** Timeout is called back in filing with event lock, accepts are changed of others */
+    if ( !(ERIS_EVENT_TIMEOUT & __elem->events)) {
+        /** Quit is set by SIGQUIT/SIGTERM, listener is ready yet in the same events */
+        if ( erishttp_context.quit) {
+            erishttp_slave_drain();
+
+            if ( __elem->sock == erishttp_context.svc_sock) { return; }
+        }
+
+        erishttp_slave_accept_update();
+    }
+
     if ( 0 < __elem->sock) {
         eris_event_elem_t ev_elem; {
             ev_elem.sock   = __elem->sock;
             ev_elem.events = 0;
+            ev_elem.addr   = 0;
         }
 
         if (( ERIS_EVENT_OOB   & __elem->events) ||
             ( ERIS_EVENT_READ  & __elem->events) ||
             ( ERIS_EVENT_WRITE & __elem->events) ) {
+            /** Event thread is the only putter, room is checked before puts and they are not waited */
+            eris_int_t put_n = ((ERIS_EVENT_OOB   & __elem->events) ? 1 : 0) +
+                               ((ERIS_EVENT_READ  & __elem->events) ? 1 : 0) +
+                               ((ERIS_EVENT_WRITE & __elem->events) ? 1 : 0);
+
+            eris_stats_slave_t *p_stats_slave = eris_stats_slave( erishttp_context.stats, erishttp_context.slave_index);
+
+            /** Request of client address over rate limit is answered 429 before parse */
+            if ( erishttp_context.ratelimit && (ERIS_EVENT_READ & __elem->events)) {
+                ev_elem.addr = eris_ratelimit_addr( ev_elem.sock);
+
+                eris_int_t limit_reason = eris_ratelimit_acquire( erishttp_context.ratelimit, ev_elem.addr);
+                if ( 0 <= limit_reason) {
+                    erishttp_slave_reject( ev_elem.sock, erishttp_context.limit_response);
+
+                    if ( p_stats_slave) { eris_atomic_fetch_inc( &(p_stats_slave->limited[ limit_reason])); }
+
+                    __elem->events = ERIS_EVENT_NONE;
+                }
+            }
+
+            eris_int_t shed_reason = (ERIS_EVENT_NONE != __elem->events) ? erishttp_slave_overload( put_n) : -1;
+            if ( 0 <= shed_reason) {
+                if ( ERIS_EVENT_READ & __elem->events) {
+                    eris_ratelimit_release( erishttp_context.ratelimit, ev_elem.addr);
+                }
+
+                erishttp_slave_reject( ev_elem.sock, erishttp_context.shed_response);
+
+                if ( p_stats_slave) { eris_atomic_fetch_inc( &(p_stats_slave->shed[ shed_reason])); }
+
+                __elem->events = ERIS_EVENT_NONE;
+            }
+
             if ( ERIS_EVENT_OOB & __elem->events) {
                 ev_elem.events = ERIS_EVENT_OOB;
 
                 /** Put oob event */
-                eris_event_queue_put( &(erishttp_context.svc_event_queue), &ev_elem, true);
+                eris_event_queue_put( &(erishttp_context.svc_event_queue), &ev_elem, false);
             }
 
             if ( ERIS_EVENT_READ & __elem->events) {
                 ev_elem.events = ERIS_EVENT_READ;
 
                 /** Put read event */
-                eris_event_queue_put( &(erishttp_context.svc_event_queue), &ev_elem, true);
+                eris_event_queue_put( &(erishttp_context.svc_event_queue), &ev_elem, false);
             }
 
             if ( ERIS_EVENT_WRITE & __elem->events) {
                 ev_elem.events = ERIS_EVENT_WRITE;
 
                 /** Put write event */
-                eris_event_queue_put( &(erishttp_context.svc_event_queue), &ev_elem, true);
+                eris_event_queue_put( &(erishttp_context.svc_event_queue), &ev_elem, false);
             }
 #if 0
             if ( ERIS_EVENT_BUSY & __elem->events) {
@@ -2228,6 +3945,8 @@ static eris_none_t erishttp_slave_event_exec( eris_event_elem_t *__elem, eris_ar
 #endif
         } else { eris_socket_close( ev_elem.sock); }
 
+        erishttp_slave_stats_update();
+
 #if 0
         if (( ERIS_EVENT_ERROR   & __elem->events) ||
             ( ERIS_EVENT_CLOSE   & __elem->events) ||
@@ -2240,11 +3959,158 @@ static eris_none_t erishttp_slave_event_exec( eris_event_elem_t *__elem, eris_ar
 #endif
 
     } else { 
+        erishttp_slave_stats_update();
+
         erishttp_errors_log_dump( ERIS_LOG_DEBUG, "erishttp event health timer."); 
     }
 }/// erishttp_slave_event_exec
 
 
+/**
+ * @Brief: Update shared counters of slave, it is done in event thread.
+ *
+ * @Param: None.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t erishttp_slave_stats_update( eris_none_t)
+{
+    /** Slot is of new slave of reload when it is draining */
+    eris_stats_slave_t *p_stats_slave = eris_stats_slave( erishttp_context.stats, erishttp_context.slave_index);
+    if ( p_stats_slave && !erishttp_context.draining) {
+        /** Count of queue is read without lock, it is a sample */
+        eris_uint_t queue_depth = (eris_uint_t )erishttp_context.svc_event_queue.count;
+
+        p_stats_slave->idle          = erishttp_context.svc_event.nodes_count;
+        p_stats_slave->queue_depth   = queue_depth;
+        p_stats_slave->accept_paused = (ERIS_EVENT_PAUSE_NONE != erishttp_context.svc_event.accept_paused) ? 1 : 0;
+        p_stats_slave->accept_pauses = erishttp_context.svc_event.accept_pauses;
+
+        if ( queue_depth > p_stats_slave->queue_high) {
+            p_stats_slave->queue_high = queue_depth;
+        }
+    }
+}/// erishttp_slave_stats_update
+
+
+/**
+ * @Brief: Slave stops accepts, and is over after busy sockets, it is done in event thread.
+ *         Idle sockets are closed by keepalive timer, killed by master after drain_timeout.
+ *
+ * @Param: None.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t erishttp_slave_drain( eris_none_t)
+{
+    static eris_int_t drained_ticks = 0;
+
+    if ( !erishttp_context.draining) {
+        erishttp_context.draining = true;
+
+        /** Listener is kept open, it is shared with other slaves */
+        (eris_none_t )eris_event_accept_delete( &(erishttp_context.svc_event), erishttp_context.svc_sock);
+
+        /** Timer of every second checks busy sockets */
+        erishttp_context.svc_event.timeout = 1;
+
+        erishttp_errors_log_dump( ERIS_LOG_NOTICE, 
+                                  "Slave index.<%d> - pid.<%d> stops accepts and drains", 
+                                  erishttp_context.slave_index, 
+                                  eris_get_pid());
+    }
+
+    /** Idle two ticks, a queued socket is maybe got and not counted yet */
+    if ( (0 == erishttp_context.svc_event.nodes_count) && 
+         (0 == erishttp_context.svc_event_queue.count) && 
+         (0 == erishttp_context.busy)) {
+        if ( 2 <= ++drained_ticks) {
+            erishttp_errors_log_dump( ERIS_LOG_NOTICE, 
+                                      "Slave index.<%d> - pid.<%d> drained and exits", 
+                                      erishttp_context.slave_index, 
+                                      eris_get_pid());
+
+            eris_event_over( &(erishttp_context.svc_event));
+        }
+    } else { drained_ticks = 0; }
+}/// erishttp_slave_drain
+
+
+/**
+ * @Brief: Overload of event queue, new requests are shed when queue is full, or
+ *         over shed_queue_depth, or front of queue waits over shed_queue_time.
+ *
+ * @Param: __put_n, Events to put of a socket.
+ *
+ * @Return: Overload is shed reason, Other is -1.
+ **/
+static eris_int_t erishttp_slave_overload( eris_int_t __put_n)
+{
+    eris_int_t rc = -1;
+
+    /** Count is only increased by event thread, it is enough of sample */
+    eris_int_t queue_count = erishttp_context.svc_event_queue.count;
+
+    if ( erishttp_context.svc_event_queue.max <= (queue_count + __put_n)) {
+        rc = ERIS_STATS_SHED_FULL;
+
+    } else if ( (0 < erishttp_context.attrs.shed_queue_depth) && (erishttp_context.attrs.shed_queue_depth <= queue_count)) {
+        rc = ERIS_STATS_SHED_DEPTH;
+
+    } else if ( (0 < erishttp_context.attrs.shed_queue_time) && (0 < queue_count) &&
+                (((eris_uint64_t )erishttp_context.attrs.shed_queue_time * 1000) <= eris_event_queue_wait( &(erishttp_context.svc_event_queue)))) {
+        rc = ERIS_STATS_SHED_LATENCY;
+    }
+
+    return rc;
+}/// erishttp_slave_overload
+
+
+/**
+ * @Brief: Answer preformatted 503 or 429 with Retry-After and close, it is done in event
+ *         thread and not entered into tasks.
+ *
+ * @Param: __sock,     Client socket.
+ * @Param: __response, Preformatted response.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t erishttp_slave_reject( eris_sock_t __sock, const eris_string_t __response)
+{
+    eris_char_t discard_buffer[ 4096];
+
+    /** Request is read, or unread data resets the response of close */
+    (eris_none_t )recv( __sock, discard_buffer, sizeof( discard_buffer), MSG_DONTWAIT);
+
+    (eris_none_t )send( __sock, __response, eris_string_size( __response), MSG_DONTWAIT);
+
+    eris_socket_close( __sock);
+}/// erishttp_slave_reject
+
+
+/**
+ * @Brief: Accepts are paused of full event queue, and resumed at half of it.
+ *         Paused of max events is done by event dispatch.
+ *
+ * @Param: None.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t erishttp_slave_accept_update( eris_none_t)
+{
+    eris_int_t queue_count = erishttp_context.svc_event_queue.count;
+    eris_int_t queue_max   = erishttp_context.svc_event_queue.max;
+
+    if ( ERIS_EVENT_PAUSE_USER & erishttp_context.svc_event.accept_paused) {
+        if ( (queue_max / 2) >= queue_count) {
+            (eris_none_t )eris_event_accept_pause( &(erishttp_context.svc_event), ERIS_EVENT_PAUSE_USER, false);
+        }
+    } else if ( queue_max <= (queue_count + 1)) {
+        (eris_none_t )eris_event_accept_pause( &(erishttp_context.svc_event), ERIS_EVENT_PAUSE_USER, true);
+    }
+}/// erishttp_slave_accept_update
+
+
 /**
  * @Brief: Admin event dispatch execute. 
  *
@@ -2255,16 +4121,128 @@ static eris_none_t erishttp_slave_event_exec( eris_event_elem_t *__elem, eris_ar
  **/
 static eris_none_t erishttp_admin_event_exec( eris_event_elem_t *__elem, eris_arg_t __arg)
 {
+    /** Slaves are not forked in handling, see erishttp_fork */
+    (eris_none_t )pthread_mutex_lock( &(erishttp_context.fork_lock));
+
     if ( 0 < __elem->sock) {
-        /** Accept */
+        /** Answer request of admin client */
+        erishttp_admin_request( __elem->sock);
+
         eris_socket_close( __elem->sock);
 
     } else { 
         erishttp_errors_log_dump( ERIS_LOG_DEBUG, "erishttp admin event health timer..."); 
     }
+
+    (eris_none_t )pthread_mutex_unlock( &(erishttp_context.fork_lock));
 }/// erishttp_admin_event_exec
 
 
+/**
+ * @Brief: Admin http request, "GET /stats" is json document of slaves counters,
+ *         "GET /metrics" is Prometheus text format of merged counters and histograms.
+ *
+ * @Param: __sock, Admin client socket.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t erishttp_admin_request( eris_sock_t __sock)
+{
+    eris_char_t  req_buffer[ 2048];
+    eris_size_t  req_size = 0;
+
+    /** Request line and headers, body is not read */
+    while ( req_size < (sizeof( req_buffer) - 1)) {
+        if ( 1 != eris_socket_ready_r( __sock, 1)) { break; }
+
+        eris_ssize_t recv_n = recv( __sock, req_buffer + req_size, sizeof( req_buffer) - 1 - req_size, 0);
+        if ( 0 < recv_n) {
+            req_size += recv_n;
+            req_buffer[ req_size] = '\0';
+
+            if ( strstr( req_buffer, "\r\n\r\n") || strstr( req_buffer, "\n\n")) { break; }
+
+        } else if ( (0 > recv_n) && (EINTR == errno)) {
+            continue;
+
+        } else { break; }
+    }
+    req_buffer[ req_size] = '\0';
+
+    const eris_char_t *p_status = "404 Not Found";
+    const eris_char_t *p_type   = "text/plain";
+
+    eris_string_t body_es = eris_string_alloc( 1024);
+    eris_string_t resp_es = eris_string_alloc( 128);
+
+    eris_bool_t is_head = (0 == strncmp( req_buffer, "HEAD ", 5));
+    if ( is_head || (0 == strncmp( req_buffer, "GET ", 4))) {
+        const eris_char_t *p_path = req_buffer + (is_head ? 5 : 4);
+        eris_size_t        path_size = strcspn( p_path, " ?\r\n");
+
+        if ( (6 == path_size) && (0 == strncmp( p_path, "/stats", 6))) {
+            if ( 0 == eris_stats_dump_json( erishttp_context.stats, &body_es)) {
+                p_status = "200 OK";
+                p_type   = "application/json";
+
+            } else {
+                p_status = "503 Service Unavailable";
+
+                (eris_none_t )eris_string_set( &body_es, "Stats unavailable\n");
+            }
+        } else if ( (8 == path_size) && (0 == strncmp( p_path, "/metrics", 8))) {
+            if ( 0 == eris_stats_dump_prometheus( erishttp_context.stats, &body_es)) {
+                p_status = "200 OK";
+                p_type   = "text/plain; version=0.0.4";
+
+            } else {
+                p_status = "503 Service Unavailable";
+
+                (eris_none_t )eris_string_set( &body_es, "Stats unavailable\n");
+            }
+        } else { (eris_none_t )eris_string_set( &body_es, "Not found\n"); }
+    } else if ( 0 < req_size) {
+        p_status = "405 Method Not Allowed";
+
+        (eris_none_t )eris_string_set( &body_es, "Method not allowed\n");
+    } else {
+        p_status = NULL;
+    }
+
+    if ( p_status && body_es && resp_es) {
+        eris_int_t rc = eris_string_printf( &resp_es, 
+                                            "HTTP/1.0 %s\r\nServer: %s\r\nContent-Type: %s\r\n"
+                                            "Content-Length: %L\r\nCache-Control: no-store\r\nConnection: close\r\n\r\n",
+                                            p_status,
+                                            ERIS_VERSION_DESC,
+                                            p_type,
+                                            (eris_ulong_t )eris_string_size( body_es));
+        if ( (0 == rc) && !is_head) {
+            rc = eris_string_append_eris( &resp_es, body_es);
+        }
+
+        eris_size_t send_count = 0;
+        eris_size_t resp_size  = eris_string_size( resp_es);
+
+        while ( (0 == rc) && (send_count < resp_size)) {
+            if ( 1 != eris_socket_ready_w( __sock, 1)) { break; }
+
+            eris_ssize_t send_n = send( __sock, resp_es + send_count, resp_size - send_count, 0);
+            if ( 0 < send_n) {
+                send_count += send_n;
+
+            } else if ( (0 > send_n) && (EINTR == errno)) {
+                continue;
+
+            } else { break; }
+        }
+    }
+
+    eris_string_free( body_es);
+    eris_string_free( resp_es);
+}/// erishttp_admin_request
+
+
 /**
  * @Brief: Destroy by master init objects.
  *
@@ -2280,6 +4258,8 @@ eris_none_t erishttp_destroy( eris_bool_t __slave)
 
         /** Slave progress doing */
         if ( __slave) {
+            eris_flight_close();
+
             eris_task_destroy( &(erishttp_context.tasks));
 
             eris_int_t i = 0;
@@ -2293,6 +4273,11 @@ eris_none_t erishttp_destroy( eris_bool_t __slave)
             eris_event_queue_destroy( &(erishttp_context.svc_event_queue));
         }
 
+        /** Dead slaves are not respawned when master is exiting */
+        if ( !__slave) {
+            erishttp_supervise_stop();
+        }
+
         if ( erishttp_context.slave_pids) {
             if ( !__slave) {
                 eris_int_t i = 0;
@@ -2307,12 +4292,19 @@ eris_none_t erishttp_destroy( eris_bool_t __slave)
             eris_memory_free( erishttp_context.slave_pids);
         }
 
+        if ( erishttp_context.respawns) {
+            eris_memory_free( erishttp_context.respawns);
+        }
+
         eris_string_free( erishttp_context.prefix);
         eris_string_init( erishttp_context.prefix);
 
         eris_string_free( erishttp_context.cfile);
         eris_string_init( erishttp_context.cfile);
 
+        eris_string_free( erishttp_context.exe);
+        eris_string_init( erishttp_context.exe);
+
         /** close socket object */
         if ( 0 <= erishttp_context.svc_sock) {
             eris_socket_close( erishttp_context.svc_sock);
@@ -2324,6 +4316,36 @@ eris_none_t erishttp_destroy( eris_bool_t __slave)
             erishttp_context.admin_sock = -1;
         }
 
+        /** Stop watcher of master, and unmap generations */
+        if ( !__slave) {
+            eris_watch_stop();
+        }
+
+        if ( erishttp_context.watch) {
+            erishttp_context.mcontext.generation = NULL;
+
+            eris_watch_destroy( erishttp_context.watch);
+            erishttp_context.watch = NULL;
+        }
+
+        /** Unmap shared stats */
+        if ( erishttp_context.stats) {
+            eris_stats_destroy( erishttp_context.stats);
+            erishttp_context.stats = NULL;
+        }
+
+        /** Unmap shared rate limit */
+        if ( erishttp_context.ratelimit) {
+            eris_ratelimit_destroy( erishttp_context.ratelimit);
+            erishttp_context.ratelimit = NULL;
+        }
+
+        /** Close doc_root directory */
+        if ( 0 <= erishttp_context.doc_root_fd) {
+            close( erishttp_context.doc_root_fd);
+            erishttp_context.doc_root_fd = -1;
+        }
+
         /** Free slave pids handler */
         eris_cftree_destroy( &(erishttp_context.cftree));
         eris_module_destroy( &(erishttp_context.mcontext));
@@ -2331,9 +4353,11 @@ eris_none_t erishttp_destroy( eris_bool_t __slave)
         eris_log_destroy( &(erishttp_context.access_log));
         eris_log_destroy( &(erishttp_context.errors_log));
         eris_log_destroy( &(erishttp_context.module_log));
+        eris_log_destroy( &(erishttp_context.slow_log));
+        eris_logfmt_destroy( &(erishttp_context.access_logfmt));
 
         erishttp_attrs_destroy();
-        eris_list_destroy( &(erishttp_context.mime_types), (eris_list_free_cb_t )erishttp_mime_types_free);
+        erishttp_mime_types_destroy();
 
         eris_proctitle_destroy();
     ERISHTTP_BLOCK_END
@@ -318,7 +318,7 @@ eris_int_t eris_epoll_dispatch( eris_event_t *__event, eris_event_cb_t __event_c
                 ready_n = epoll_wait( __event->context.epoll.fd, 
                                       __event->context.epoll.fds,
                                       __event->context.epoll.size,
-                                      __event->timeout * 1000 );
+                                      eris_event_wait_timeout( __event) * 1000 );
                 if ( 0 < ready_n) {
                     eris_int_t i = 0;
 
@@ -345,7 +345,7 @@ eris_int_t eris_epoll_dispatch( eris_event_t *__event, eris_event_cb_t __event_c
                         }
 
                         if ( is_accept_sock) {
-                            /** Busy??? */
+                            /** Busy??? accepts are paused, or level-triggered listener is spun */
                             if ( (__event->nodes_count + 1) < __event->max_events ) {
                                 eris_sock_t client_sock = eris_event_accept( __event, cur_elem.sock);
                                 if ( 0 < client_sock) {
@@ -372,6 +372,8 @@ eris_int_t eris_epoll_dispatch( eris_event_t *__event, eris_event_cb_t __event_c
                                         eris_socket_close( client_sock);
                                     }
                                 }
+                            } else {
+                                (eris_none_t )eris_event_accept_pause( __event, ERIS_EVENT_PAUSE_NODES, true);
                             }
                         } else {
                             /** Has readable */
@@ -415,8 +417,8 @@ eris_int_t eris_epoll_dispatch( eris_event_t *__event, eris_event_cb_t __event_c
                     }/// for ( i = 0; i < read_n; i++)
 
                 } else {
-                    /** Timer event heppen */
-                    if ( 0 == ready_n) {
+                    /** Timer event heppen, interrupted by signal is a timer too */
+                    if ( (0 == ready_n) || (EINTR == errno)) {
                         eris_event_elem_t timer_elem; {
                             timer_elem.sock   = -1;
                             timer_elem.events = ERIS_EVENT_TIMER;
@@ -11,6 +11,10 @@
 #include "core/eris.core.h"
 
 
+/** Set paused reason, listen sockets are in or out of I/O monitor, it is done with lock. */
+static eris_none_t eris_event_accept_paused( eris_event_t *__event, eris_int_t __reason, eris_bool_t __pause);
+
+
 /**
  * @Brief: Init event context of event attributes.
  *
@@ -57,6 +61,8 @@ eris_int_t eris_event_init( eris_event_t *__event, eris_event_attr_t *__attrs)
             __event->nprocs           = eris_get_nprocessor();
             __event->log              = pattrs->log;
             __event->accept_nodes     = NULL;
+            __event->accept_paused    = ERIS_EVENT_PAUSE_NONE;
+            __event->accept_pauses    = 0;
 
             __event->nodes_size       = __event->max_events / 16;
             if ( 64 >= __event->nodes_size) {
@@ -504,6 +510,113 @@ eris_int_t eris_event_delete( eris_event_t *__event, eris_event_elem_t *__elem)
 }/// eris_event_delete
 
 
+/**
+ * @Brief: Delete listen socket from accept nodes of event context monitor,
+ *         it is not closed and can be added again of ERIS_EVENT_ACCEPT.
+ *
+ * @Param: __event, Event context.
+ * @Param: __sock,  Listen socket.
+ *
+ * @Return: Os is 0, Not found is EERIS_NOTFOUND, Other is EERIS_ERROR.
+ **/
+eris_int_t eris_event_accept_delete( eris_event_t *__event, eris_sock_t __sock)
+{
+    eris_int_t rc = 0;
+
+    if ( __event && (0 <= __sock)) {
+        pthread_cleanup_push( (eris_cleanup_routine_t)pthread_mutex_unlock, (eris_void_t *)&(__event->mutex));
+        /** Heppen cancel? */
+
+        /** Must safe-thread: lock */
+        pthread_mutex_lock( &(__event->mutex));
+
+        /** Has over dispatch */
+        if ( 0 == __event->over) {
+            eris_event_node_t *cur_node = __event->accept_nodes;
+
+            while ( cur_node) {
+                if ( cur_node->elem.sock == __sock) {
+                    break;
+                }
+
+                cur_node = cur_node->next;
+            }
+
+            if ( cur_node) {
+                if ( cur_node == __event->accept_nodes) {
+                    __event->accept_nodes = cur_node->next;
+                }
+
+                cur_node->prev ? (cur_node->prev->next = cur_node->next): 0;
+                cur_node->next ? (cur_node->next->prev = cur_node->prev): 0;
+
+                eris_memory_free( cur_node);
+
+                /** Out of I/O monitor, paused is out yet */
+                if ( ERIS_EVENT_PAUSE_NONE == __event->accept_paused) {
+                    eris_event_elem_t del_elem; {
+                        del_elem.sock   = __sock;
+                        del_elem.events = ERIS_EVENT_ACCEPT;
+                    }
+
+                    __event->delete_handler( __event, &del_elem);
+                }
+            } else { rc = EERIS_NOTFOUND; }
+        } else { 
+            rc = EERIS_ERROR;
+
+            if ( __event->log) {
+                eris_log_dump( __event->log, ERIS_LOG_CORE, "Dispatch has over.");
+            }
+        }
+
+        /** Unlock */
+        pthread_mutex_unlock( &(__event->mutex));
+
+        pthread_cleanup_pop(0);
+    } else { rc = EERIS_ERROR; }
+
+    return rc;
+}/// eris_event_accept_delete
+
+
+/**
+ * @Brief: Pause or resume accepts of a reason, listen sockets are out of I/O monitor
+ *         while any reason is paused, and they are kept in accept nodes.
+ *
+ * @Param: __event,  Event context.
+ * @Param: __reason, ERIS_EVENT_PAUSE_NODES or ERIS_EVENT_PAUSE_USER.
+ * @Param: __pause,  Pause is true, resume is false.
+ *
+ * @Return: Ok is 0, Other is EERIS_ERROR.
+ **/
+eris_int_t eris_event_accept_pause( eris_event_t *__event, eris_int_t __reason, eris_bool_t __pause)
+{
+    eris_int_t rc = 0;
+
+    if ( __event) {
+        pthread_cleanup_push( (eris_cleanup_routine_t)pthread_mutex_unlock, (eris_void_t *)&(__event->mutex));
+        /** Heppen cancel? */
+
+        /** Must safe-thread: lock */
+        pthread_mutex_lock( &(__event->mutex));
+
+        /** Has over dispatch */
+        if ( 0 == __event->over) {
+            eris_event_accept_paused( __event, __reason, __pause);
+
+        } else { rc = EERIS_ERROR; }
+
+        /** Unlock */
+        pthread_mutex_unlock( &(__event->mutex));
+
+        pthread_cleanup_pop(0);
+    } else { rc = EERIS_ERROR; }
+
+    return rc;
+}/// eris_event_accept_pause
+
+
 /**
  * @Brief: Monitor all sockets and dispatch.
  *
@@ -716,6 +829,11 @@ eris_none_t eris_event_filing( eris_event_t *__event, eris_event_cb_t __cb, eris
             }
         }
 
+        /** Paused of max events is resumed of hysteresis */
+        if ( (ERIS_EVENT_PAUSE_NODES & __event->accept_paused) && (eris_event_resume_nodes( __event) >= __event->nodes_count)) {
+            eris_event_accept_paused( __event, ERIS_EVENT_PAUSE_NODES, false);
+        }
+
         /** Unlock */
         pthread_mutex_unlock( &(__event->mutex));
 
@@ -789,3 +907,54 @@ eris_sock_t eris_event_accept( eris_event_t *__event, eris_sock_t __svc_sock)
 }/// eris_eris_event_accept
 
 
+/**
+ * @Brief: Set paused reason, listen sockets are in or out of I/O monitor, it is done with lock.
+ *
+ * @Param: __event,  Event context.
+ * @Param: __reason, Paused reason.
+ * @Param: __pause,  Pause is true, resume is false.
+ *
+ * @Return: Nothing.
+ **/
+static eris_none_t eris_event_accept_paused( eris_event_t *__event, eris_int_t __reason, eris_bool_t __pause)
+{
+    eris_int_t old_paused = __event->accept_paused;
+
+    if ( __pause) {
+        __event->accept_paused |= __reason;
+    } else {
+        __event->accept_paused &= ~__reason;
+    }
+
+    /** Changed of monitor */
+    if ( (ERIS_EVENT_PAUSE_NONE == old_paused) != (ERIS_EVENT_PAUSE_NONE == __event->accept_paused)) {
+        eris_event_node_t *cur_node = __event->accept_nodes;
+
+        for ( ; (NULL != cur_node); cur_node = cur_node->next) {
+            eris_event_elem_t accept_elem; {
+                accept_elem.sock   = cur_node->elem.sock;
+                accept_elem.events = ERIS_EVENT_ACCEPT;
+            }
+
+            if ( __pause) {
+                __event->delete_handler( __event, &accept_elem);
+
+            } else {
+                __event->add_handler( __event, &accept_elem);
+            }
+        }
+
+        if ( __pause) {
+            __event->accept_pauses++;
+        }
+
+        if ( __event->log) {
+            eris_log_dump( __event->log, ERIS_LOG_NOTICE, "Pid.%d - accepts are %s, reasons.<%d> nodes.<%d>", 
+                           eris_get_pid(),
+                           __pause ? "paused" : "resumed",
+                           __event->accept_paused,
+                           (eris_int_t )__event->nodes_count);
+        }
+    }
+}/// eris_event_accept_paused
+
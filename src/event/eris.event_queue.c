@@ -198,6 +198,41 @@ eris_bool_t eris_event_queue_isempty( eris_event_queue_t *__event_queue)
 }/// eris_event_queue_isempty
 
 
+/**
+ * @Brief: Get wait time of front element, it is the latency of queue.
+ *
+ * @Param: __event_queue, Eris event queue context.
+ *
+ * @Return: Wait usec of front element, empty is 0.
+ **/
+eris_uint64_t eris_event_queue_wait( eris_event_queue_t *__event_queue)
+{
+    eris_uint64_t rc = 0;
+
+    if ( __event_queue) {
+        pthread_cleanup_push( (eris_cleanup_routine_t)pthread_mutex_unlock, (eris_void_t *)&(__event_queue->mutex));
+        /** Happen something cancel? */
+
+        /** Lock ok? */
+        if ( 0 == pthread_mutex_lock( &(__event_queue->mutex))) {
+            if ( 0 < __event_queue->count) {
+                eris_uint64_t front_stamp = __event_queue->events[ __event_queue->front].stamp;
+                eris_uint64_t now_stamp   = eris_time_mono_us();
+
+                rc = (now_stamp > front_stamp) ? (now_stamp - front_stamp) : 0;
+            }
+
+            /** Unlock */
+            pthread_mutex_unlock( &(__event_queue->mutex));
+        }
+
+        pthread_cleanup_pop(0);
+    }
+
+    return rc;
+}/// eris_event_queue_wait
+
+
 /**
  * @Brief: Put event element into queue.
  *
@@ -237,6 +272,8 @@ eris_int_t eris_event_queue_put( eris_event_queue_t *__event_queue, const eris_e
                 if ( 0 == rc) {
                     __event_queue->events[ __event_queue->near].sock   = __in_elem->sock;
                     __event_queue->events[ __event_queue->near].events = __in_elem->events;
+                    __event_queue->events[ __event_queue->near].addr   = __in_elem->addr;
+                    __event_queue->events[ __event_queue->near].stamp  = eris_time_mono_us();
 
                     __event_queue->near = (__event_queue->near + 1) % __event_queue->max;
                     __event_queue->count++;
@@ -296,6 +333,8 @@ eris_int_t eris_event_queue_get( eris_event_queue_t *__event_queue, eris_event_e
                 if ( 0 == rc) {
                     __out_elem->sock   = __event_queue->events[ __event_queue->front].sock;
                     __out_elem->events = __event_queue->events[ __event_queue->front].events;
+                    __out_elem->addr   = __event_queue->events[ __event_queue->front].addr;
+                    __out_elem->stamp  = __event_queue->events[ __event_queue->front].stamp;
 
                     __event_queue->front = (__event_queue->front + 1) % __event_queue->max;
                     __event_queue->count--;
@@ -260,7 +260,7 @@ eris_int_t eris_kqueue_dispatch( eris_event_t *__event, eris_event_cb_t __event_
                 }
 
                 eris_timespec_t ts; {
-                    ts.tv_sec  = __event->timeout;
+                    ts.tv_sec  = eris_event_wait_timeout( __event);
                     ts.tv_nsec = 0;
                 }
 
@@ -301,7 +301,7 @@ eris_int_t eris_kqueue_dispatch( eris_event_t *__event, eris_event_cb_t __event_
                         }
 
                         if ( is_accept_sock) {
-                            /** Busy??? */
+                            /** Busy??? accepts are paused, or level-triggered listener is spun */
                             if ( (__event->nodes_count + 1) < __event->max_events) {
                                 eris_sock_t client_sock = eris_event_accept( __event, ev_elem.sock);
                                 if ( -1 != client_sock) {
@@ -328,6 +328,8 @@ eris_int_t eris_kqueue_dispatch( eris_event_t *__event, eris_event_cb_t __event_
                                         eris_socket_close( client_sock);
                                     }
                                 }
+                            } else {
+                                (eris_none_t )eris_event_accept_pause( __event, ERIS_EVENT_PAUSE_NODES, true);
                             }
                         } else {
                             if ( EV_ERROR & ev_flags ) {
@@ -358,8 +360,8 @@ eris_int_t eris_kqueue_dispatch( eris_event_t *__event, eris_event_cb_t __event_
                     }/// for ( i = 0; i < ready_n; i++)
 
                 } else {
-                    /** Timer event heppen */
-                    if ( 0 == ready_n) {
+                    /** Timer event heppen, interrupted by signal is a timer too */
+                    if ( (0 == ready_n) || (EINTR == errno)) {
                         eris_event_elem_t timer_elem; {
                             timer_elem.sock   = -1;
                             timer_elem.events = ERIS_EVENT_TIMER;
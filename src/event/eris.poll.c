@@ -21,8 +21,11 @@
 #include "core/eris.core.h"
 
 
-/** Register all fds. */
-static eris_none_t eris_poll_regfds( eris_event_t *__event);
+/** Make index table and fds pool can hold sock. */
+static eris_int_t eris_poll_reserve( eris_event_t *__event, eris_sock_t __sock);
+
+/** Set sock monitor events, append when it is new. */
+static eris_int_t eris_poll_set( eris_event_t *__event, eris_event_elem_t *__elem);
 
 
 
@@ -43,19 +46,37 @@ eris_int_t eris_poll_init( eris_event_t *__event)
 
         __event->context.poll.current = 0;
 
-        __event->context.poll.fds = (eris_pollfd_t *)eris_memory_alloc( __event->context.poll.size * sizeof( eris_pollfd_t));
-        if ( __event->context.poll.fds) {
+        __event->context.poll.index_size = __event->max_events;
+
+        __event->context.poll.fds     = (eris_pollfd_t *)eris_memory_alloc( __event->context.poll.size * sizeof( eris_pollfd_t));
+        __event->context.poll.accepts = (eris_bool_t *)eris_memory_alloc( __event->context.poll.size * sizeof( eris_bool_t));
+        __event->context.poll.index   = (eris_int32_t *)eris_memory_alloc( __event->context.poll.index_size * sizeof( eris_int32_t));
+        if ( __event->context.poll.fds && __event->context.poll.accepts && __event->context.poll.index) {
             eris_int_t i = 0;
 
             for ( i = 0; i < __event->context.poll.size; i++) {
                 __event->context.poll.fds[ i].fd      = -1;
                 __event->context.poll.fds[ i].events  = 0;
                 __event->context.poll.fds[ i].revents = 0;
+
+                __event->context.poll.accepts[ i] = false;
+            }
+
+            for ( i = 0; i < __event->context.poll.index_size; i++) {
+                __event->context.poll.index[ i] = -1;
             }
         } else { 
             /** Alloc pollfd buffer failed */
             rc = EERIS_ERROR; 
 
+            eris_memory_free( __event->context.poll.fds);
+            eris_memory_free( __event->context.poll.accepts);
+            eris_memory_free( __event->context.poll.index);
+
+            __event->context.poll.fds     = NULL;
+            __event->context.poll.accepts = NULL;
+            __event->context.poll.index   = NULL;
+
             if ( __event->log) {
                 eris_log_dump( __event->log, ERIS_LOG_CORE, "Alloced memory for pollfds cache failed.");
             }
@@ -78,8 +99,7 @@ eris_int_t eris_poll_init( eris_event_t *__event)
  **/
 eris_int_t eris_poll_add( eris_event_t *__event, eris_event_elem_t *__elem)
 {
-    /** Nothing */
-    return 0;
+    return eris_poll_set( __event, __elem);
 }/// eris_poll_add
 
 
@@ -93,8 +113,7 @@ eris_int_t eris_poll_add( eris_event_t *__event, eris_event_elem_t *__elem)
  **/
 eris_int_t eris_poll_modify( eris_event_t *__event, eris_event_elem_t *__elem)
 {
-    /** Nothing */
-    return 0;
+    return eris_poll_set( __event, __elem);
 }/// eris_poll_modify
 
 
@@ -108,8 +127,40 @@ eris_int_t eris_poll_modify( eris_event_t *__event, eris_event_elem_t *__elem)
  **/
 eris_int_t eris_poll_delete( eris_event_t *__event, eris_event_elem_t *__elem)
 {
-    /** Nothing */
-    return 0;
+    eris_int_t rc = 0;
+
+    if ( __event && __elem) {
+#if (ERIS_HAVE_POLL_H)
+        eris_poll_t *poll_ctx = &(__event->context.poll);
+
+        if ( (0 <= __elem->sock) && (__elem->sock < poll_ctx->index_size)) {
+            eris_int32_t pos = poll_ctx->index[ __elem->sock];
+
+            if ( -1 != pos) {
+                eris_int32_t last = poll_ctx->current - 1;
+
+                /** Move the tail into the hole */
+                if ( pos != last) {
+                    poll_ctx->fds[ pos]     = poll_ctx->fds[ last];
+                    poll_ctx->accepts[ pos] = poll_ctx->accepts[ last];
+
+                    poll_ctx->index[ poll_ctx->fds[ pos].fd] = pos;
+                }
+
+                poll_ctx->fds[ last].fd      = -1;
+                poll_ctx->fds[ last].events  = 0;
+                poll_ctx->fds[ last].revents = 0;
+                poll_ctx->accepts[ last]     = false;
+
+                poll_ctx->index[ __elem->sock] = -1;
+                poll_ctx->current = last;
+            }
+        }
+#endif /** ERIS_HAVE_POLL_H */
+
+    } else { rc = EERIS_ERROR; }
+
+    return rc;
 }/// eris_poll_delete
 
 
@@ -135,51 +186,35 @@ eris_int_t eris_poll_dispatch( eris_event_t *__event, eris_event_cb_t __event_cb
             /** Has over flag set and jump out */
             if ( 0 < __event->over) { break; }
 
-            /** Register fds */
-            eris_poll_regfds( __event);
-
             if ( __event->log) {
                 eris_log_dump( __event->log, ERIS_LOG_DEBUG, "Has event nodes count.%d", __event->nodes_count);
             }
 
             /** Do monitor of poll I/O */
-            ready_n = poll( __event->context.poll.fds, __event->context.poll.current, __event->timeout * 1000);
+            ready_n = poll( __event->context.poll.fds, __event->context.poll.current, eris_event_wait_timeout( __event) * 1000);
             if ( 0 < ready_n) {
                 eris_int_t i = 0;
                 eris_int_t doing_count = 0;
 
-                /** Has ready_n number ready */
-                for ( i = 0; i < __event->context.poll.current; i++) {
-                    if ( doing_count >= ready_n) {
-                        break;
-                    }
+                /** Has ready_n number ready, entries may be swapped while walking */
+                for ( i = 0; (i < __event->context.poll.current) && (doing_count < ready_n); ) {
+                    eris_short_t revents = __event->context.poll.fds[ i].revents;
+
+                    if ( 0 == revents) { i++; continue; }
 
-                    eris_bool_t is_accept_sock = false;
+                    __event->context.poll.fds[ i].revents = 0;
 
                     eris_event_elem_t cur_elem; {
                         cur_elem.sock   = __event->context.poll.fds[ i].fd;
                         cur_elem.events = ERIS_EVENT_NONE;
                     }
 
-                    /** Check is accept socket object? */
-                    {
-                        eris_event_node_t *cur_node = __event->accept_nodes;
-
-                        for ( ; (NULL != cur_node); cur_node = cur_node->next) {
-                            if ( cur_elem.sock == cur_node->elem.sock) {
-                                is_accept_sock = true;
-
-                                break;
-                            }
-                        }
-                    }
-
-                    if ( is_accept_sock) {
-                        if ( (POLLIN     & __event->context.poll.fds[ i].revents) ||
-                             (POLLRDNORM & __event->context.poll.fds[ i].revents) ){
+                    if ( __event->context.poll.accepts[ i]) {
+                        if ( (POLLIN     & revents) ||
+                             (POLLRDNORM & revents) ){
                             doing_count++;
 
-                            /** Busy??? */
+                            /** Busy??? accepts are paused, or level-triggered listener is spun */
                             if ( (__event->nodes_count + 1) < __event->max_events) {
                                 eris_sock_t client_sock = eris_event_accept( __event, cur_elem.sock);
                                 if ( -1 != client_sock) {
@@ -206,32 +241,32 @@ eris_int_t eris_poll_dispatch( eris_event_t *__event, eris_event_cb_t __event_cb
                                         eris_socket_close( client_sock);
                                     }
                                 }
+                            } else {
+                                (eris_none_t )eris_event_accept_pause( __event, ERIS_EVENT_PAUSE_NODES, true);
                             }
                         }
                     } else {
-                        //eris_event_delete( __event, &cur_elem);
-
                         /** Other client socket fd */
-                        if ( (POLLIN     & __event->context.poll.fds[ i].revents) ||
-                             (POLLRDNORM & __event->context.poll.fds[ i].revents) ){
+                        if ( (POLLIN     & revents) ||
+                             (POLLRDNORM & revents) ){
                             cur_elem.events |= ERIS_EVENT_READ;
                         }
 
-                        if ( (POLLOUT    & __event->context.poll.fds[ i].revents) ||
-                             (POLLWRNORM & __event->context.poll.fds[ i].revents) ) {
+                        if ( (POLLOUT    & revents) ||
+                             (POLLWRNORM & revents) ) {
                             cur_elem.events |= ERIS_EVENT_WRITE;
                         }
 
-                        if ( POLLPRI & __event->context.poll.fds[ i].revents) {
+                        if ( POLLPRI & revents) {
                             cur_elem.events |= ERIS_EVENT_OOB;
                         }
 
-                        if ( (POLLERR  & __event->context.poll.fds[ i].revents) &&
-                             (POLLNVAL & __event->context.poll.fds[ i].revents) ) {
+                        if ( (POLLERR  & revents) ||
+                             (POLLNVAL & revents) ) {
                             cur_elem.events = ERIS_EVENT_ERROR;
                         }
 
-                        if ( POLLHUP & __event->context.poll.fds[ i].revents) {
+                        if ( POLLHUP & revents) {
                             cur_elem.events |= ERIS_EVENT_CLOSE;
                         }
 
@@ -251,10 +286,15 @@ eris_int_t eris_poll_dispatch( eris_event_t *__event, eris_event_cb_t __event_cb
                             }
                         }
                     }
-                }/// for ( i = 0; i < ready_n; i++)
+
+                    /** Deleted and the tail moved into i, then walk it again */
+                    if ( (i < __event->context.poll.current) && (cur_elem.sock == __event->context.poll.fds[ i].fd)) {
+                        i++;
+                    }
+                }/// for ( i = 0; i < current; )
             } else {
-                /** Timer event heppen */
-                if ( 0 == ready_n) {
+                /** Timer event heppen, interrupted by signal is a timer too */
+                if ( (0 == ready_n) || (EINTR == errno)) {
                     eris_event_elem_t timer_elem; {
                         timer_elem.sock   = -1;
                         timer_elem.events = ERIS_EVENT_TIMER;
@@ -318,7 +358,21 @@ eris_none_t eris_poll_destroy( eris_event_t *__event)
             __event->context.poll.fds = NULL;
         }
 
-        __event->context.poll.current = 0;
+        if ( __event->context.poll.accepts) {
+            eris_memory_free( __event->context.poll.accepts);
+
+            __event->context.poll.accepts = NULL;
+        }
+
+        if ( __event->context.poll.index) {
+            eris_memory_free( __event->context.poll.index);
+
+            __event->context.poll.index = NULL;
+        }
+
+        __event->context.poll.current    = 0;
+        __event->context.poll.size       = 0;
+        __event->context.poll.index_size = 0;
 #endif /** ERIS_HAVE_POLL_H */
 
     }
@@ -326,96 +380,121 @@ eris_none_t eris_poll_destroy( eris_event_t *__event)
 
 
 /**
- * @Brief: Register all fds.
+ * @Brief: Make index table and fds pool can hold sock.
  *
  * @Param: __event, Event context handler.
+ * @Param: __sock,  Will be monitor socket.
  *
- * @Return: Nothing.
+ * @Return: Ok is 0, Other is -1.
  **/
-static eris_none_t eris_poll_regfds( eris_event_t *__event)
+static eris_int_t eris_poll_reserve( eris_event_t *__event, eris_sock_t __sock)
 {
+    eris_int_t rc = 0;
+
 #if (ERIS_HAVE_POLL_H)
-    eris_int_t reg_count = 0;
-    {
-        eris_event_node_t *cur_node = __event->accept_nodes;
+    eris_poll_t *poll_ctx = &(__event->context.poll);
 
-        while ( cur_node) {
-            if ( 0 <= cur_node->elem.sock) {
-                __event->context.poll.fds[ reg_count].fd = cur_node->elem.sock;
-                __event->context.poll.fds[ reg_count].events  = POLLIN | POLLRDNORM;
-                __event->context.poll.fds[ reg_count].revents = 0;
+    /** Index table by sock value */
+    if ( __sock >= poll_ctx->index_size) {
+        eris_int32_t new_size = poll_ctx->index_size * 2;
+        if ( new_size <= __sock) { new_size = __sock + 1; }
 
-                reg_count++;
+        eris_int32_t *new_index = (eris_int32_t *)eris_memory_realloc( poll_ctx->index, new_size * sizeof( eris_int32_t));
+        if ( new_index) {
+            eris_int32_t i = 0;
 
-                __event->context.poll.current = reg_count;
+            for ( i = poll_ctx->index_size; i < new_size; i++) {
+                new_index[ i] = -1;
             }
 
-            cur_node = cur_node->next;
-        }
+            poll_ctx->index      = new_index;
+            poll_ctx->index_size = new_size;
+        } else { rc = EERIS_ERROR; }
     }
 
-    pthread_cleanup_push( (eris_cleanup_routine_t)pthread_mutex_unlock, (eris_void_t *)&(__event->mutex));
-   /** Heppen cancel? */
+    /** Full fds pool */
+    if ( (0 == rc) && (poll_ctx->current >= poll_ctx->size)) {
+        eris_int32_t new_size = (0 < poll_ctx->size) ? (poll_ctx->size * 2) : 64;
 
-    /** Lock */
-    pthread_mutex_lock( &(__event->mutex));
+        eris_pollfd_t *new_fds = (eris_pollfd_t *)eris_memory_realloc( poll_ctx->fds, new_size * sizeof( eris_pollfd_t));
+        if ( new_fds) {
+            poll_ctx->fds = new_fds;
 
-    /** Add to poll and monitor */
-    eris_int_t i = 0;
+            eris_bool_t *new_accepts = (eris_bool_t *)eris_memory_realloc( poll_ctx->accepts, new_size * sizeof( eris_bool_t));
+            if ( new_accepts) {
+                poll_ctx->accepts = new_accepts;
+                poll_ctx->size    = new_size;
+            } else { rc = EERIS_ERROR; }
+        } else { rc = EERIS_ERROR; }
+    }
 
-    for ( i = 0; i < __event->nodes_size; i++) {
-        eris_event_node_t *cur_node = __event->nodes[ i];
+    if ( (0 != rc) && __event->log) {
+        eris_log_dump( __event->log, ERIS_LOG_CORE, "Grow pollfds cache for sock.<%d> failed, errno.<%d>", __sock, errno);
+    }
+#endif /** ERIS_HAVE_POLL_H */
 
-        while ( cur_node) {
-            if ( reg_count >= __event->context.poll.size) {
-                break;
-            }
+    return rc;
+}/// eris_poll_reserve
 
-            /** valid socket fd context */
-            if ( 0 < cur_node->elem.sock) {
-                /** Is alive??? */
-                if ( 1 == eris_socket_ready_w( cur_node->elem.sock, 0)) {
-                    __event->context.poll.fds[ reg_count].fd = cur_node->elem.sock;
-                    __event->context.poll.fds[ reg_count].events  = POLLHUP;
-                    __event->context.poll.fds[ reg_count].revents = 0;
 
-                    /** Register read event */
-                    if ( (ERIS_EVENT_READ  & cur_node->elem.events) ||
-                         (ERIS_EVENT_WRITE & cur_node->elem.events) ) {
+/**
+ * @Brief: Set sock monitor events, append when it is new.
+ *
+ * @Param: __event, Event context handler.
+ * @Param: __elem,  Socket element.
+ *
+ * @Return: Ok is 0, Other is -1.
+ **/
+static eris_int_t eris_poll_set( eris_event_t *__event, eris_event_elem_t *__elem)
+{
+    eris_int_t rc = 0;
 
-                        if ( ERIS_EVENT_READ & cur_node->elem.events) {
-                            __event->context.poll.fds[ reg_count].events |= (POLLIN | POLLRDNORM);
-                        }
+    if ( __event && __elem && (0 <= __elem->sock)) {
+#if (ERIS_HAVE_POLL_H)
+        eris_poll_t *poll_ctx = &(__event->context.poll);
 
-                        /** Register write event */
-                        if ( ERIS_EVENT_WRITE & cur_node->elem.events) {
-                            __event->context.poll.fds[ reg_count].events |= (POLLOUT | POLLRDNORM);
-                        }
+        rc = eris_poll_reserve( __event, __elem->sock);
+        if ( 0 == rc) {
+            eris_int32_t pos = poll_ctx->index[ __elem->sock];
 
-                        reg_count++;
-                    }
-                }else {
-                    cur_node->start = 0;
-                }
+            if ( -1 == pos) {
+                pos = poll_ctx->current++;
+
+                poll_ctx->index[ __elem->sock] = pos;
+
+                poll_ctx->fds[ pos].fd      = __elem->sock;
+                poll_ctx->fds[ pos].revents = 0;
             }
 
-            cur_node = cur_node->next;
-        }
+            if ( ERIS_EVENT_ACCEPT & __elem->events) {
+                poll_ctx->fds[ pos].events = POLLIN | POLLRDNORM;
+                poll_ctx->accepts[ pos]    = true;
 
-        __event->context.poll.current = reg_count;
+            } else {
+                poll_ctx->fds[ pos].events = 0;
+                poll_ctx->accepts[ pos]    = false;
 
-        if ( reg_count >= __event->context.poll.size) {
-            break;
-        }
-    }
+                /** None read/write, wait timeout filing */
+                if ( (ERIS_EVENT_READ  & __elem->events) ||
+                     (ERIS_EVENT_WRITE & __elem->events) ) {
+                    poll_ctx->fds[ pos].events = POLLHUP;
 
-    /** Unlock */
-    pthread_mutex_unlock( &(__event->mutex));
+                    if ( ERIS_EVENT_READ & __elem->events) {
+                        poll_ctx->fds[ pos].events |= (POLLIN | POLLRDNORM);
+                    }
 
-    pthread_cleanup_pop(0);
+                    if ( ERIS_EVENT_WRITE & __elem->events) {
+                        poll_ctx->fds[ pos].events |= (POLLOUT | POLLWRNORM);
+                    }
+                }
+            }
+        }
 #endif /** ERIS_HAVE_POLL_H */
 
-}/// eris_poll_regfds
+    } else { rc = EERIS_ERROR; }
+
+    return rc;
+}/// eris_poll_set
 
 
 
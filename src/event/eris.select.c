@@ -123,7 +123,7 @@ eris_int_t eris_select_dispatch( eris_event_t *__event, eris_event_cb_t __event_
             fd_set  errorable_set; { FD_ZERO( &errorable_set); }
 
             eris_timeval_t tv_timeout; {
-                tv_timeout.tv_sec  = __event->timeout;
+                tv_timeout.tv_sec  = eris_event_wait_timeout( __event);
                 tv_timeout.tv_usec = 0;
             }
 
@@ -139,7 +139,7 @@ eris_int_t eris_select_dispatch( eris_event_t *__event, eris_event_cb_t __event_
                 eris_event_node_t *cur_node = __event->accept_nodes;
                 while ( cur_node) {
                     if ( FD_ISSET( cur_node->elem.sock, p_r_set)) {
-                        /** Busy??? */
+                        /** Busy??? accepts are paused, or level-triggered listener is spun */
                         if ( (__event->nodes_count + 1) < __event->max_events) {
                             eris_sock_t client_sock = eris_event_accept( __event, cur_node->elem.sock);
                             if ( -1 != client_sock) {
@@ -166,6 +166,8 @@ eris_int_t eris_select_dispatch( eris_event_t *__event, eris_event_cb_t __event_
                                     eris_socket_close( client_sock);
                                 }
                             }
+                        } else {
+                            (eris_none_t )eris_event_accept_pause( __event, ERIS_EVENT_PAUSE_NODES, true);
                         }
 
                         do_count++;
@@ -225,8 +227,8 @@ eris_int_t eris_select_dispatch( eris_event_t *__event, eris_event_cb_t __event_
                     }/// whil ( cur_node)
                 }
             } else {
-                /** Timer event heppen */
-                if ( 0 == ready_n) {
+                /** Timer event heppen, interrupted by signal is a timer too */
+                if ( (0 == ready_n) || (EINTR == errno)) {
                     eris_event_elem_t timer_elem; {
                         timer_elem.sock   = -1;
                         timer_elem.events = ERIS_EVENT_TIMER;
@@ -327,8 +329,8 @@ static eris_none_t eris_select_regfds( eris_event_t *__event)
         eris_time_t now_time = 0;
         eris_time_get( now_time);
 
-        /** Register accept socket object */
-        {
+        /** Register accept socket object, paused accepts are not */
+        if ( ERIS_EVENT_PAUSE_NONE == __event->accept_paused) {
             eris_event_node_t *cur_node = __event->accept_nodes;
             while ( cur_node) {
                 FD_SET( cur_node->elem.sock, &(__event->context.select.readable));
@@ -336,10 +336,11 @@ eris_int_t eris_files_create_tf( eris_files_t *__fcontext, eris_bool_t __pers, e
                 __access = ERIS_ATTRFS_ACCESS_DEFAULT;
             }
 
+            /** Temp file is not passed to exec of other binary */
 #ifdef __CYGWIN__
-            __fcontext->fd = open( __fcontext->name, O_RDWR | O_CREAT | O_EXCL | 0_BINARY, __access);
+            __fcontext->fd = open( __fcontext->name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC | 0_BINARY, __access);
 #else
-            __fcontext->fd = open( __fcontext->name, O_RDWR | O_CREAT | O_EXCL, __access);
+            __fcontext->fd = open( __fcontext->name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, __access);
 #endif
             if ( (-1 != __fcontext->fd) && !(__pers)) {
                 /** Unpersistent and delete */
@@ -392,6 +392,41 @@ eris_int_t eris_socket_ready_w( eris_sock_t __sock, eris_int_t __timeout)
 }/// eris_socket_ready_w
 
 
+/**
+ * @Brief: Send file data to socket, zero-copy if system has sendfile.
+ *
+ * @Param: __sock,   Socket context.
+ * @Param: __fd,     File descriptor.
+ * @Param: __offset, File offset, it is moved forward of sent size.
+ * @Param: __size,   Max size of sending.
+ *
+ * @Return: Sent size, other is -1 and errno is set.
+ **/
+eris_ssize_t eris_socket_sendfile( eris_sock_t __sock, eris_fd_t __fd, eris_off_t *__offset, eris_size_t __size)
+{
+    eris_ssize_t send_n = -1;
+
+    if ( (0 <= __sock) && (0 <= __fd) && __offset) {
+#if (ERIS_HAVE_SYS_SENDFILE_H)
+        send_n = sendfile( __sock, __fd, __offset, __size);
+
+#else
+        eris_uchar_t r_cache[ 16384];
+
+        send_n = pread( __fd, r_cache, (__size < sizeof( r_cache)) ? __size : sizeof( r_cache), *__offset);
+        if ( 0 < send_n) {
+            send_n = send( __sock, r_cache, send_n, MSG_DONTWAIT);
+            if ( 0 < send_n) {
+                *__offset += send_n;
+            }
+        }
+#endif
+    } else { errno = EINVAL; }
+
+    return send_n;
+}/// eris_socket_sendfile
+
+
 /**
  * @Brief: Close socket context.
  *